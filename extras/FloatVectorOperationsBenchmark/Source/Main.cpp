@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Times the FloatVectorOperations kernels with each instruction set that the
+    host CPU supports, so that the wider kernels can be compared with the baseline.
+*/
+struct Benchmark
+{
+    using InstructionSet = FloatVectorOperations::InstructionSet;
+
+    static String getName (InstructionSet instructionSet)
+    {
+        switch (instructionSet)
+        {
+            case InstructionSet::avx512:    return "AVX-512";
+            case InstructionSet::avx2:      return "AVX2";
+            case InstructionSet::baseline:  break;
+        }
+
+        return "Baseline";
+    }
+
+    template <typename FloatType>
+    struct Buffers
+    {
+        explicit Buffers (int numSamples)
+            : dest ((size_t) numSamples), src1 ((size_t) numSamples), src2 ((size_t) numSamples), ints ((size_t) numSamples)
+        {
+            Random random (1234);
+
+            for (size_t i = 0; i < src1.size(); ++i)
+            {
+                dest[i] = (FloatType) random.nextFloat();
+                src1[i] = (FloatType) random.nextFloat();
+                src2[i] = (FloatType) random.nextFloat();
+                ints[i] = random.nextInt();
+            }
+        }
+
+        std::vector<FloatType> dest, src1, src2;
+        std::vector<int> ints;
+    };
+
+    template <typename Callback>
+    static double timeNanosecondsPerSample (int numSamples, Callback&& callback)
+    {
+        const auto numIterations = jmax (1, (1 << 24) / numSamples);
+
+        for (int i = 0; i < numIterations / 10; ++i)
+            callback();
+
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numIterations; ++i)
+            callback();
+
+        const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+        return elapsed * 1.0e9 / ((double) numIterations * numSamples);
+    }
+
+    template <typename FloatType>
+    static void runAll (const String& typeName, int numSamples, const Array<InstructionSet>& instructionSets)
+    {
+        // Some of the operations are repeatedly applied in place, which would otherwise produce denormals
+        const ScopedNoDenormals noDenormals;
+
+        Buffers<FloatType> b (numSamples);
+        auto* d  = b.dest.data();
+        auto* s1 = b.src1.data();
+        auto* s2 = b.src2.data();
+
+        std::vector<std::pair<String, std::function<void()>>> operations
+        {
+            { "add (dest, src)",              [=] { FloatVectorOperations::add (d, s1, numSamples); } },
+            { "add (dest, src1, src2)",       [=] { FloatVectorOperations::add (d, s1, s2, numSamples); } },
+            { "multiply (dest, src)",         [=] { FloatVectorOperations::multiply (d, s1, numSamples); } },
+            { "multiply (dest, src1, src2)",  [=] { FloatVectorOperations::multiply (d, s1, s2, numSamples); } },
+            { "multiply (dest, scalar)",      [=] { FloatVectorOperations::multiply (d, (FloatType) 0.999, numSamples); } },
+            { "addWithMultiply (scalar)",     [=] { FloatVectorOperations::addWithMultiply (d, s1, (FloatType) 0.5, numSamples); } },
+            { "addWithMultiply (src1, src2)", [=] { FloatVectorOperations::addWithMultiply (d, s1, s2, numSamples); } },
+            { "clip",                         [=] { FloatVectorOperations::clip (d, s1, (FloatType) 0.25, (FloatType) 0.75, numSamples); } },
+            { "findMinAndMax",                [=] { ignoreUnused (FloatVectorOperations::findMinAndMax (s1, numSamples)); } },
+            { "dotProduct",                   [=] { ignoreUnused (FloatVectorOperations::dotProduct (s1, s2, numSamples)); } }
+        };
+
+        if constexpr (std::is_same_v<FloatType, float>)
+        {
+            auto* ints = b.ints.data();
+            operations.push_back ({ "convertFixedToFloat", [=] { FloatVectorOperations::convertFixedToFloat (d, ints, 1.0f / 65536.0f, numSamples); } });
+        }
+
+        for (auto& [name, operation] : operations)
+        {
+            String line = (typeName + " " + name).paddedRight (' ', 36) + String (numSamples).paddedLeft (' ', 6);
+            double baselineTime = 0;
+
+            for (auto instructionSet : instructionSets)
+            {
+                FloatVectorOperations::setMaximumInstructionSet (instructionSet);
+
+                // Keep the data in a sensible range between runs
+                FloatVectorOperations::copy (d, s2, numSamples);
+
+                const auto nanoseconds = timeNanosecondsPerSample (numSamples, operation);
+
+                if (instructionSet == InstructionSet::baseline)
+                    baselineTime = nanoseconds;
+
+                line << "  " << String (nanoseconds, 3).paddedLeft (' ', 8) << " ns"
+                     << " (x" << String (baselineTime / nanoseconds, 2) << ")";
+            }
+
+            std::cout << line << std::endl;
+        }
+    }
+};
+
+//==============================================================================
+int main (int argc, char** argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--size=numSamples]" << std::endl;
+        return 0;
+    }
+
+    using InstructionSet = FloatVectorOperations::InstructionSet;
+
+    const auto supported = FloatVectorOperations::getInstructionSet();
+    Array<InstructionSet> instructionSets;
+
+    for (auto instructionSet : { InstructionSet::baseline, InstructionSet::avx2, InstructionSet::avx512 })
+        if (instructionSet <= supported)
+            instructionSets.add (instructionSet);
+
+    String header = String ("Operation").paddedRight (' ', 36) + String ("Size").paddedLeft (' ', 6);
+
+    for (auto instructionSet : instructionSets)
+        header << "  " << Benchmark::getName (instructionSet).paddedLeft (' ', 11) << " (speedup)";
+
+    std::cout << header << std::endl;
+
+    Array<int> sizes { 64, 512, 4096, 65536 };
+
+    if (args.containsOption ("--size"))
+        sizes = { jmax (1, args.getValueForOption ("--size").getIntValue()) };
+
+    for (auto size : sizes)
+    {
+        Benchmark::runAll<float>  ("float",  size, instructionSets);
+        Benchmark::runAll<double> ("double", size, instructionSets);
+    }
+
+    FloatVectorOperations::setMaximumInstructionSet (supported);
+    return 0;
+}
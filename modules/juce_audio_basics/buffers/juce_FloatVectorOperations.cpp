@@ -65,6 +65,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -97,6 +98,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1]); }
         static forcedinline Type min (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1]); }
+        static forcedinline Type sum (ParallelType a) noexcept  { Type v[numParallel]; storeU (v, a); return v[0] + v[1]; }
     };
 
 
@@ -230,6 +232,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
         static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+        static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return (v[0] + v[1]) + (v[2] + v[3]); }
     };
 
     struct BasicOps64
@@ -262,6 +265,7 @@ namespace FloatVectorHelpers
 
         static forcedinline Type max (ParallelType a) noexcept  { return a; }
         static forcedinline Type min (ParallelType a) noexcept  { return a; }
+        static forcedinline Type sum (ParallelType a) noexcept  { return a; }
     };
 
     #define JUCE_BEGIN_VEC_OP \
@@ -489,6 +493,209 @@ namespace FloatVectorHelpers
             return Range<Type>::findMinAndMax (src, num);
         }
     };
+
+    template <typename Mode>
+    struct DotProduct
+    {
+        using Type = typename Mode::Type;
+
+        template <typename Size>
+        static Type calculate (const Type* src1, const Type* src2, Size num) noexcept
+        {
+            const auto numLongOps = num / Mode::numParallel;
+            auto total = Mode::load1 (Type());
+
+            for (auto i = (decltype (numLongOps)) 0; i < numLongOps; ++i)
+            {
+                total = Mode::add (total, Mode::mul (Mode::loadU (src1), Mode::loadU (src2)));
+                src1 += Mode::numParallel;
+                src2 += Mode::numParallel;
+            }
+
+            auto result = Mode::sum (total);
+            num &= (Mode::numParallel - 1);
+
+            for (auto i = (decltype (num)) 0; i < num; ++i)
+                result += src1[i] * src2[i];
+
+            return result;
+        }
+    };
+   #endif
+
+   #if JUCE_USE_AVX_INTRINSICS
+    //==============================================================================
+    // The AVX kernels are compiled with the relevant target options enabled, so they
+    // can be used without the whole module needing to be built for those CPUs.
+   #if JUCE_CLANG
+    #pragma clang attribute push (__attribute__ ((target ("avx2,fma"))), apply_to = function)
+   #elif JUCE_GCC
+    #pragma GCC push_options
+    #pragma GCC target ("avx2,fma")
+   #endif
+
+    namespace AVX2
+    {
+        struct Ops32
+        {
+            using Type = float;
+            using ParallelType = __m256;
+            enum { numParallel = 8 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+            static forcedinline ParallelType loadInts (const int* v) noexcept               { return _mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (v))); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_ps (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return std::accumulate (v, v + numParallel, Type()); }
+        };
+
+        struct Ops64
+        {
+            using Type = double;
+            using ParallelType = __m256d;
+            enum { numParallel = 4 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm256_fmadd_pd (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return std::accumulate (v, v + numParallel, Type()); }
+        };
+
+        #include "juce_FloatVectorOperations_avx.h"
+    }
+
+   #if JUCE_CLANG
+    #pragma clang attribute pop
+    #pragma clang attribute push (__attribute__ ((target ("avx512f"))), apply_to = function)
+   #elif JUCE_GCC
+    #pragma GCC pop_options
+    #pragma GCC push_options
+    #pragma GCC target ("avx512f")
+   #endif
+
+    // Some versions of GCC give false positives for the undefined values used by the AVX-512 intrinsics
+    JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmaybe-uninitialized")
+
+    namespace AVX512
+    {
+        struct Ops32
+        {
+            using Type = float;
+            using ParallelType = __m512;
+            enum { numParallel = 16 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+            static forcedinline ParallelType loadInts (const int* v) noexcept               { return _mm512_cvtepi32_ps (_mm512_loadu_si512 (v)); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_ps (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::max_element (v, v + numParallel); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::min_element (v, v + numParallel); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return std::accumulate (v, v + numParallel, Type()); }
+        };
+
+        struct Ops64
+        {
+            using Type = double;
+            using ParallelType = __m512d;
+            enum { numParallel = 8 };
+
+            static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+            static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+            static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+            static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+            static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+            static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+            static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+
+            static forcedinline ParallelType mulAdd (ParallelType a, ParallelType b, ParallelType c) noexcept  { return _mm512_fmadd_pd (a, b, c); }
+
+            static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::max_element (v, v + numParallel); }
+            static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return *std::min_element (v, v + numParallel); }
+            static forcedinline Type sum (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return std::accumulate (v, v + numParallel, Type()); }
+        };
+
+        #include "juce_FloatVectorOperations_avx.h"
+    }
+
+    JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+   #if JUCE_CLANG
+    #pragma clang attribute pop
+   #elif JUCE_GCC
+    #pragma GCC pop_options
+   #endif
+
+    //==============================================================================
+    using InstructionSet = FloatVectorOperations::InstructionSet;
+
+    static std::atomic<InstructionSet> maximumInstructionSet { InstructionSet::avx512 };
+
+    static InstructionSet getSupportedInstructionSet() noexcept
+    {
+        static const auto supported = []
+        {
+            if (SystemStats::hasAVX512F())
+                return InstructionSet::avx512;
+
+            if (SystemStats::hasAVX2() && SystemStats::hasFMA3())
+                return InstructionSet::avx2;
+
+            return InstructionSet::baseline;
+        }();
+
+        return supported;
+    }
+
+    static InstructionSet getInstructionSetToUse() noexcept
+    {
+        return jmin (getSupportedInstructionSet(), maximumInstructionSet.load (std::memory_order_relaxed));
+    }
+
+    // Short buffers aren't worth the cost of checking which instruction set to use
+    template <typename Size>
+    static bool isWorthUsingWideKernels (Size num) noexcept     { return num >= (Size) 32; }
+
+    #define JUCE_PERFORM_WIDE_VEC_OP(kernel) \
+        if (isWorthUsingWideKernels (num)) \
+        { \
+            switch (getInstructionSetToUse()) \
+            { \
+                case InstructionSet::avx512:    return AVX512::kernel; \
+                case InstructionSet::avx2:      return AVX2::kernel; \
+                case InstructionSet::baseline:  break; \
+            } \
+        }
+   #else
+    #define JUCE_PERFORM_WIDE_VEC_OP(kernel)
    #endif
 
 //==============================================================================
@@ -624,6 +831,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (add (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -637,6 +846,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (add (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -650,6 +861,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (add (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -663,6 +876,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (add (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -728,6 +943,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (addWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -742,6 +959,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (addWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -756,6 +975,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (addWithMultiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -769,6 +990,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (addWithMultiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -820,6 +1043,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -833,6 +1058,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -846,6 +1073,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -859,6 +1088,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i],
                                             Mode::mul (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -872,6 +1103,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -885,6 +1118,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (multiply (dest, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -1065,6 +1300,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (clip (dest, src, low, high, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1082,6 +1319,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (clip (dest, src, low, high, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1094,6 +1333,8 @@ namespace
     template <typename Size>
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
+        JUCE_PERFORM_WIDE_VEC_OP (findMinAndMax (src, num))
+
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
        #else
@@ -1104,6 +1345,8 @@ namespace
     template <typename Size>
     Range<double> findMinAndMax (const double* src, Size num) noexcept
     {
+        JUCE_PERFORM_WIDE_VEC_OP (findMinAndMax (src, num))
+
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
        #else
@@ -1151,6 +1394,42 @@ namespace
        #endif
     }
 
+    template <typename Size>
+    float dotProduct (const float* src1, const float* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        float result = 0;
+        vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #else
+        JUCE_PERFORM_WIDE_VEC_OP (dotProduct (src1, src2, num))
+
+        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+         return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps32>::calculate (src1, src2, num);
+        #else
+         return std::inner_product (src1, src1 + num, src2, 0.0f);
+        #endif
+       #endif
+    }
+
+    template <typename Size>
+    double dotProduct (const double* src1, const double* src2, Size num) noexcept
+    {
+       #if JUCE_USE_VDSP_FRAMEWORK
+        double result = 0;
+        vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+        return result;
+       #else
+        JUCE_PERFORM_WIDE_VEC_OP (dotProduct (src1, src2, num))
+
+        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+         return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps64>::calculate (src1, src2, num);
+        #else
+         return std::inner_product (src1, src1 + num, src2, 0.0);
+        #endif
+       #endif
+    }
+
     template <typename Size>
     void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
     {
@@ -1160,6 +1439,8 @@ namespace
                                   JUCE_LOAD_NONE,
                                   JUCE_INCREMENT_SRC_DEST, )
        #else
+        JUCE_PERFORM_WIDE_VEC_OP (convertFixedToFloat (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = (float) src[i] * multiplier,
                                       Mode::mul (mult, _mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src)))),
                                       JUCE_LOAD_NONE,
@@ -1408,6 +1689,14 @@ FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::findMax
     return FloatVectorHelpers::findMaximum (src, numValues);
 }
 
+template <typename FloatType, typename CountType>
+FloatType JUCE_CALLTYPE FloatVectorOperationsBase<FloatType, CountType>::dotProduct (const FloatType* src1,
+                                                                                     const FloatType* src2,
+                                                                                     CountType num) noexcept
+{
+    return FloatVectorHelpers::dotProduct (src1, src2, num);
+}
+
 template struct FloatVectorOperationsBase<float, int>;
 template struct FloatVectorOperationsBase<float, size_t>;
 template struct FloatVectorOperationsBase<double, int>;
@@ -1423,6 +1712,22 @@ void JUCE_CALLTYPE FloatVectorOperations::convertFixedToFloat (float* dest, cons
     FloatVectorHelpers::convertFixedToFloat (dest, src, multiplier, num);
 }
 
+void JUCE_CALLTYPE FloatVectorOperations::setMaximumInstructionSet ([[maybe_unused]] InstructionSet maximum) noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    FloatVectorHelpers::maximumInstructionSet = maximum;
+   #endif
+}
+
+FloatVectorOperations::InstructionSet JUCE_CALLTYPE FloatVectorOperations::getInstructionSet() noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    return FloatVectorHelpers::getInstructionSetToUse();
+   #else
+    return InstructionSet::baseline;
+   #endif
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1598,6 +1903,19 @@ public:
             u.expect (valuesMatch (FloatVectorOperations::findMinimum (data2, num), juce::findMinimum (data2, num)));
             u.expect (valuesMatch (FloatVectorOperations::findMaximum (data2, num), juce::findMaximum (data2, num)));
 
+            {
+                double expectedDotProduct = 0, magnitude = 0;
+
+                for (int i = 0; i < num; ++i)
+                {
+                    expectedDotProduct += (double) data1[i] * (double) data2[i];
+                    magnitude += std::abs ((double) data1[i] * (double) data2[i]);
+                }
+
+                const auto dotProduct = (double) FloatVectorOperations::dotProduct (data1, data2, num);
+                u.expect (std::abs (dotProduct - expectedDotProduct) <= magnitude * std::numeric_limits<ValueType>::epsilon() * (double) num);
+            }
+
             FloatVectorOperations::clear (data1, num);
             u.expect (areAllValuesEqual (data1, num, 0));
 
@@ -1697,6 +2015,77 @@ public:
         }
     };
 
+    template <typename ValueType>
+    struct InstructionSetTestRunner
+    {
+        using InstructionSet = FloatVectorOperations::InstructionSet;
+
+        static void runTest (UnitTest& u, Random& random, InstructionSet instructionSet)
+        {
+            const auto num = (size_t) random.nextInt (600);
+
+            std::vector<ValueType> src1 (num), src2 (num), expected (num), actual (num);
+            std::vector<int> ints (num);
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                src1[i] = (ValueType) (random.nextDouble() * 2000.0 - 1000.0);
+                src2[i] = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+                ints[i] = random.nextInt();
+            }
+
+            const auto compare = [&] (auto&& op, ValueType tolerance)
+            {
+                FloatVectorOperations::setMaximumInstructionSet (InstructionSet::baseline);
+                FloatVectorOperations::copy (expected.data(), src1.data(), num);
+                op (expected.data());
+
+                FloatVectorOperations::setMaximumInstructionSet (instructionSet);
+                FloatVectorOperations::copy (actual.data(), src1.data(), num);
+                op (actual.data());
+
+                for (size_t i = 0; i < num; ++i)
+                    if (std::abs (expected[i] - actual[i]) > tolerance * jmax (std::abs (expected[i]), (ValueType) 1000))
+                        return false;
+
+                return true;
+            };
+
+            const auto a = src1.data(), b = src2.data();
+
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::add (d, b, num); }, 0));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::add (d, a, b, num); }, 0));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::multiply (d, b, num); }, 0));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::multiply (d, a, b, num); }, 0));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::multiply (d, (ValueType) 0.3, num); }, 0));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::clip (d, a, (ValueType) -500, (ValueType) 250, num); }, 0));
+
+            // The wide kernels use fused multiply-adds, so allow for rounding differences in the
+            // products, which can be relatively large when the sum cancels out
+            const auto fmaTolerance = std::numeric_limits<ValueType>::epsilon() * 8;
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::addWithMultiply (d, b, (ValueType) 0.7, num); }, fmaTolerance));
+            u.expect (compare ([&] (ValueType* d) { FloatVectorOperations::addWithMultiply (d, a, b, num); }, fmaTolerance));
+
+            if constexpr (std::is_same_v<ValueType, float>)
+                u.expect (compare ([&] (float* d) { FloatVectorOperations::convertFixedToFloat (d, ints.data(), 1.0f / 65536.0f, num); }, 0));
+
+            FloatVectorOperations::setMaximumInstructionSet (instructionSet);
+            const auto range = FloatVectorOperations::findMinAndMax (a, num);
+            u.expect (range == Range<ValueType>::findMinAndMax (a, num));
+
+            double expectedDotProduct = 0, magnitude = 0;
+
+            for (size_t i = 0; i < num; ++i)
+            {
+                expectedDotProduct += (double) a[i] * (double) b[i];
+                magnitude += std::abs ((double) a[i] * (double) b[i]);
+            }
+
+            const auto dotProduct = (double) FloatVectorOperations::dotProduct (a, b, num);
+            u.expect (std::abs (dotProduct - expectedDotProduct) <= magnitude * std::numeric_limits<ValueType>::epsilon() * (double) num);
+        }
+    };
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1706,6 +2095,32 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+        beginTest ("All instruction sets give matching results");
+        {
+            using InstructionSet = FloatVectorOperations::InstructionSet;
+
+            const auto supported = FloatVectorOperations::getInstructionSet();
+            auto random = getRandom();
+
+            for (auto instructionSet : { InstructionSet::baseline, InstructionSet::avx2, InstructionSet::avx512 })
+            {
+                if (supported < instructionSet)
+                    continue;
+
+                for (int i = 100; --i >= 0;)
+                {
+                    InstructionSetTestRunner<float>::runTest (*this, random, instructionSet);
+                    InstructionSetTestRunner<double>::runTest (*this, random, instructionSet);
+                }
+
+                FloatVectorOperations::setMaximumInstructionSet (instructionSet);
+                expect (FloatVectorOperations::getInstructionSet() == instructionSet);
+            }
+
+            FloatVectorOperations::setMaximumInstructionSet (InstructionSet::avx512);
+            expect (FloatVectorOperations::getInstructionSet() == supported);
+        }
     }
 };
 
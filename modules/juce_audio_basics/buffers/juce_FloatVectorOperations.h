@@ -136,6 +136,14 @@ struct FloatVectorOperationsBase
 
     /** Finds the maximum value in the given array. */
     static FloatType JUCE_CALLTYPE findMaximum (const FloatType* src, CountType numValues) noexcept;
+
+    /** Returns the sum of the products of each source1 value and the corresponding source2 value.
+
+        This is the inner loop of most FIR filters. Note that the order in which the products are
+        accumulated depends on the instruction set in use, so the result may differ slightly
+        between machines.
+    */
+    static FloatType JUCE_CALLTYPE dotProduct (const FloatType* src1, const FloatType* src2, CountType num) noexcept;
 };
 
 #if ! DOXYGEN
@@ -161,7 +169,8 @@ struct NameForwarder : public Bases...
           Bases::clip...,
           Bases::findMinAndMax...,
           Bases::findMinimum...,
-          Bases::findMaximum...;
+          Bases::findMaximum...,
+          Bases::dotProduct...;
 };
 
 } // namespace detail
@@ -201,8 +210,40 @@ public:
     /** This method returns true if denormals are currently disabled. */
     static bool JUCE_CALLTYPE areDenormalsDisabled() noexcept;
 
+    //==============================================================================
+    /** The instruction set extensions that may be used by the vector operations.
+
+        The baseline kernels use SSE2 on Intel, NEON on ARM and vDSP on Apple platforms.
+        On Intel CPUs that support them, wider AVX2 and AVX-512 kernels are selected at
+        runtime for add(), multiply(), addWithMultiply(), clip(), findMinAndMax(),
+        dotProduct() and convertFixedToFloat(). Note that the wider kernels use fused
+        multiply-add instructions, so the results of addWithMultiply() and dotProduct()
+        may differ in the last bit.
+    */
+    enum class InstructionSet
+    {
+        baseline,
+        avx2,
+        avx512
+    };
+
+    /** Restricts the instruction set that the vector operations may use.
+
+        By default, the widest instruction set supported by the CPU is used. Limiting it can be
+        handy for benchmarking, or when results must be bit-identical across machines.
+
+        @see getInstructionSet
+    */
+    static void JUCE_CALLTYPE setMaximumInstructionSet (InstructionSet maximum) noexcept;
+
+    /** Returns the instruction set that the vector operations are currently using.
+        This takes into account both the host CPU and any limit set with setMaximumInstructionSet().
+    */
+    static InstructionSet JUCE_CALLTYPE getInstructionSet() noexcept;
+
 private:
     friend ScopedNoDenormals;
+    friend class RealtimeWorkerGroup;
 
     static intptr_t JUCE_CALLTYPE getFpStatusRegister() noexcept;
     static void JUCE_CALLTYPE setFpStatusRegister (intptr_t) noexcept;
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+/*  This file contains the wide-vector kernels used by FloatVectorOperations. It
+    has no include guard, because juce_FloatVectorOperations.cpp includes it once
+    for each instruction set, from inside a namespace that provides the Ops32 and
+    Ops64 structs for that instruction set, and with the matching compiler target
+    options enabled. None of these functions may be called unless the CPU has been
+    checked for support of that instruction set.
+*/
+
+template <typename Type> struct OpsFor;
+template <> struct OpsFor<float>  { using Ops = Ops32; };
+template <> struct OpsFor<double> { using Ops = Ops64; };
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::add (Ops::loadU (dest + i), Ops::loadU (src + i)));
+
+    for (; i < num; ++i)
+        dest[i] += src[i];
+}
+
+template <typename Type, typename Size>
+void add (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::add (Ops::loadU (src1 + i), Ops::loadU (src2 + i)));
+
+    for (; i < num; ++i)
+        dest[i] = src1[i] + src2[i];
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::mul (Ops::loadU (dest + i), Ops::loadU (src + i)));
+
+    for (; i < num; ++i)
+        dest[i] *= src[i];
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::mul (Ops::loadU (src1 + i), Ops::loadU (src2 + i)));
+
+    for (; i < num; ++i)
+        dest[i] = src1[i] * src2[i];
+}
+
+template <typename Type, typename Size>
+void multiply (Type* dest, Type multiplier, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    const auto mult = Ops::load1 (multiplier);
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::mul (Ops::loadU (dest + i), mult));
+
+    for (; i < num; ++i)
+        dest[i] *= multiplier;
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src, Type multiplier, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    const auto mult = Ops::load1 (multiplier);
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::mulAdd (Ops::loadU (src + i), mult, Ops::loadU (dest + i)));
+
+    for (; i < num; ++i)
+        dest[i] += src[i] * multiplier;
+}
+
+template <typename Type, typename Size>
+void addWithMultiply (Type* dest, const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::mulAdd (Ops::loadU (src1 + i), Ops::loadU (src2 + i), Ops::loadU (dest + i)));
+
+    for (; i < num; ++i)
+        dest[i] += src1[i] * src2[i];
+}
+
+template <typename Type, typename Size>
+void clip (Type* dest, const Type* src, Type low, Type high, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    const auto lo = Ops::load1 (low);
+    const auto hi = Ops::load1 (high);
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops::storeU (dest + i, Ops::max (Ops::min (Ops::loadU (src + i), hi), lo));
+
+    for (; i < num; ++i)
+        dest[i] = jmax (jmin (src[i], high), low);
+}
+
+template <typename Type, typename Size>
+Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+
+    if (num < step)
+        return Range<Type>::findMinAndMax (src, num);
+
+    auto mn = Ops::loadU (src);
+    auto mx = mn;
+    auto i = step;
+
+    for (; i + step <= num; i += step)
+    {
+        const auto s = Ops::loadU (src + i);
+        mn = Ops::min (mn, s);
+        mx = Ops::max (mx, s);
+    }
+
+    Range<Type> result (Ops::min (mn), Ops::max (mx));
+
+    for (; i < num; ++i)
+        result = result.getUnionWith (src[i]);
+
+    return result;
+}
+
+template <typename Type, typename Size>
+Type dotProduct (const Type* src1, const Type* src2, Size num) noexcept
+{
+    using Ops = typename OpsFor<Type>::Ops;
+    constexpr auto step = (Size) Ops::numParallel;
+    const auto zero = Ops::load1 (Type());
+    auto total1 = zero, total2 = zero;
+    Size i = 0;
+
+    // Two independent accumulators hide some of the latency of the fused multiply-adds
+    for (; i + 2 * step <= num; i += 2 * step)
+    {
+        total1 = Ops::mulAdd (Ops::loadU (src1 + i),        Ops::loadU (src2 + i),        total1);
+        total2 = Ops::mulAdd (Ops::loadU (src1 + i + step), Ops::loadU (src2 + i + step), total2);
+    }
+
+    if (i + step <= num)
+    {
+        total1 = Ops::mulAdd (Ops::loadU (src1 + i), Ops::loadU (src2 + i), total1);
+        i += step;
+    }
+
+    auto result = Ops::sum (Ops::add (total1, total2));
+
+    for (; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+}
+
+template <typename Size>
+void convertFixedToFloat (float* dest, const int* src, float multiplier, Size num) noexcept
+{
+    constexpr auto step = (Size) Ops32::numParallel;
+    const auto mult = Ops32::load1 (multiplier);
+    Size i = 0;
+
+    for (; i + step <= num; i += step)
+        Ops32::storeU (dest + i, Ops32::mul (Ops32::loadInts (src + i), mult));
+
+    for (; i < num; ++i)
+        dest[i] = (float) src[i] * multiplier;
+}
@@ -53,6 +53,14 @@
  #include <arm_neon.h>
 #endif
 
+#if JUCE_USE_SSE_INTRINSICS && ! JUCE_USE_VDSP_FRAMEWORK && ! defined (JUCE_USE_AVX_INTRINSICS)
+ #define JUCE_USE_AVX_INTRINSICS 1
+#endif
+
+#if JUCE_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
@@ -60,8 +68,11 @@
 #include "utilities/juce_IIRFilter.cpp"
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_Interpolators.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
+#include "utilities/juce_RealtimeWorkerGroup.cpp"
+#include "synthesisers/juce_ParallelVoiceRenderer.h"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
 #include "midi/juce_MidiKeyboardState.cpp"
@@ -83,6 +94,7 @@
 #include "sources/juce_MemoryAudioSource.cpp"
 #include "sources/juce_MixerAudioSource.cpp"
 #include "sources/juce_ResamplingAudioSource.cpp"
+#include "sources/juce_PolyphaseResamplingAudioSource.cpp"
 #include "sources/juce_ReverbAudioSource.cpp"
 #include "sources/juce_ToneGeneratorAudioSource.cpp"
 #include "sources/juce_PositionableAudioSource.cpp"
@@ -99,5 +111,6 @@
 
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_PolyphaseResampler_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
 #endif
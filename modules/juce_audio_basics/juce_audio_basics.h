@@ -95,7 +95,9 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_Interpolators.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_ADSR.h"
+#include "utilities/juce_RealtimeWorkerGroup.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
@@ -119,6 +121,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "sources/juce_MemoryAudioSource.h"
 #include "sources/juce_MixerAudioSource.h"
 #include "sources/juce_ResamplingAudioSource.h"
+#include "sources/juce_PolyphaseResamplingAudioSource.h"
 #include "sources/juce_ReverbAudioSource.h"
 #include "sources/juce_ToneGeneratorAudioSource.h"
 #include "synthesisers/juce_Synthesiser.h"
@@ -25,6 +25,8 @@ namespace juce
 
 namespace MidiBufferHelpers
 {
+    constexpr auto headerSize = sizeof (int32) + sizeof (uint16);
+
     inline int getEventTime (const void* d) noexcept
     {
         return readUnaligned<int32> (d);
@@ -77,6 +79,15 @@ namespace MidiBufferHelpers
 
         return d;
     }
+
+    static void writeEvent (uint8* d, int samplePosition, const void* eventData, int numBytes) noexcept
+    {
+        writeUnaligned<int32>  (d, samplePosition);
+        d += sizeof (int32);
+        writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+        d += sizeof (uint16);
+        memcpy (d, eventData, (size_t) numBytes);
+    }
 }
 
 //==============================================================================
@@ -106,17 +117,140 @@ MidiBuffer::MidiBuffer (const MidiMessage& message) noexcept
     addEvent (message, 0);
 }
 
-void MidiBuffer::swapWith (MidiBuffer& other) noexcept      { data.swapWith (other.data); }
-void MidiBuffer::clear() noexcept                           { data.clearQuick(); }
-void MidiBuffer::ensureSize (size_t minimumNumBytes)        { data.ensureStorageAllocated ((int) minimumNumBytes); }
-bool MidiBuffer::isEmpty() const noexcept                   { return data.size() == 0; }
+MidiBuffer::MidiBuffer (uint8* externalStorage, size_t numBytesAvailable) noexcept
+    : storage (externalStorage), capacity (numBytesAvailable), isExternal (true)
+{
+    jassert (externalStorage != nullptr || numBytesAvailable == 0);
+}
+
+MidiBuffer::MidiBuffer (const MidiBuffer& other)
+{
+    if (other.numBytesUsed > 0)
+    {
+        allocatedStorage.malloc (other.numBytesUsed);
+        storage = allocatedStorage.get();
+        capacity = other.numBytesUsed;
+
+        memcpy (storage, other.storage, other.numBytesUsed);
+        numBytesUsed = other.numBytesUsed;
+        lastEventOffset = other.lastEventOffset;
+    }
+}
+
+MidiBuffer& MidiBuffer::operator= (const MidiBuffer& other)
+{
+    if (this != &other)
+    {
+        clear();
+
+        if (ensureCapacity (other.numBytesUsed))
+        {
+            if (other.numBytesUsed > 0)
+                memcpy (storage, other.storage, other.numBytesUsed);
+
+            numBytesUsed = other.numBytesUsed;
+            lastEventOffset = other.lastEventOffset;
+        }
+        else
+        {
+            // This buffer's external storage is too small, so copy as many events as will fit
+            addEvents (other, 0, -1, 0);
+        }
+    }
+
+    return *this;
+}
+
+MidiBuffer::MidiBuffer (MidiBuffer&& other) noexcept
+{
+    swapWith (other);
+}
+
+MidiBuffer& MidiBuffer::operator= (MidiBuffer&& other) noexcept
+{
+    MidiBuffer temp (std::move (other));
+    swapWith (temp);
+    return *this;
+}
+
+void MidiBuffer::swapWith (MidiBuffer& other) noexcept
+{
+    allocatedStorage.swapWith (other.allocatedStorage);
+    std::swap (storage,         other.storage);
+    std::swap (numBytesUsed,    other.numBytesUsed);
+    std::swap (capacity,        other.capacity);
+    std::swap (lastEventOffset, other.lastEventOffset);
+    std::swap (isExternal,      other.isExternal);
+}
+
+void MidiBuffer::clear() noexcept                           { numBytesUsed = 0; lastEventOffset = 0; }
+void MidiBuffer::ensureSize (size_t minimumNumBytes)        { ensureCapacity (minimumNumBytes); }
+bool MidiBuffer::isEmpty() const noexcept                   { return numBytesUsed == 0; }
+
+bool MidiBuffer::ensureCapacity (size_t minimumNumBytes)
+{
+    if (minimumNumBytes <= capacity)
+        return true;
+
+    if (isExternal)
+        return false;
+
+    // Grow geometrically, in the same way as an Array
+    const auto newCapacity = (minimumNumBytes + minimumNumBytes / 2 + 8) & ~(size_t) 7;
+    allocatedStorage.realloc (newCapacity);
+    storage = allocatedStorage.get();
+    capacity = newCapacity;
+    return true;
+}
+
+uint8* MidiBuffer::insertSpace (size_t offset, size_t numBytes)
+{
+    jassert (offset <= numBytesUsed);
+
+    if (! ensureCapacity (numBytesUsed + numBytes))
+        return nullptr;
+
+    auto* d = storage + offset;
+
+    if (offset < numBytesUsed)
+    {
+        memmove (d + numBytes, d, numBytesUsed - offset);
+        lastEventOffset += numBytes;
+    }
+    else
+    {
+        lastEventOffset = offset;
+    }
+
+    numBytesUsed += numBytes;
+    return d;
+}
+
+void MidiBuffer::updateLastEventOffset() noexcept
+{
+    lastEventOffset = 0;
+
+    for (size_t offset = 0; offset < numBytesUsed; offset += MidiBufferHelpers::getEventTotalSize (storage + offset))
+        lastEventOffset = offset;
+}
 
-void MidiBuffer::clear (int startSample, int numSamples)
+void MidiBuffer::clear (int startSample, int numSamples) noexcept
 {
-    auto start = MidiBufferHelpers::findEventAfter (data.begin(), data.end(), startSample - 1);
-    auto end   = MidiBufferHelpers::findEventAfter (start,        data.end(), startSample + numSamples - 1);
+    auto* dataEnd = storage + numBytesUsed;
+    auto* start = MidiBufferHelpers::findEventAfter (storage, dataEnd, startSample - 1);
+    auto* end   = MidiBufferHelpers::findEventAfter (start,   dataEnd, startSample + numSamples - 1);
+
+    if (start == end)
+        return;
 
-    data.removeRange ((int) (start - data.begin()), (int) (end - start));
+    const auto numBytesToRemove = (size_t) (end - start);
+    memmove (start, end, (size_t) (dataEnd - end));
+    numBytesUsed -= numBytesToRemove;
+
+    if (end == dataEnd)
+        updateLastEventOffset();
+    else
+        lastEventOffset -= numBytesToRemove;
 }
 
 bool MidiBuffer::addEvent (const MidiMessage& m, int sampleNumber)
@@ -137,41 +271,109 @@ bool MidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber)
         return false;
     }
 
-    auto newItemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
-    auto offset = (int) (MidiBufferHelpers::findEventAfter (data.begin(), data.end(), sampleNumber) - data.begin());
+    const auto newItemSize = (size_t) numBytes + MidiBufferHelpers::headerSize;
+
+    // Events that don't come before the last event can simply be appended
+    const auto offset = (numBytesUsed == 0 || getLastEventTime() <= sampleNumber)
+                      ? numBytesUsed
+                      : (size_t) (MidiBufferHelpers::findEventAfter (storage, storage + numBytesUsed, sampleNumber) - storage);
 
-    data.insertMultiple (offset, 0, (int) newItemSize);
+    auto* d = insertSpace (offset, newItemSize);
 
-    auto* d = data.begin() + offset;
-    writeUnaligned<int32>  (d, sampleNumber);
-    d += sizeof (int32);
-    writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
-    d += sizeof (uint16);
-    memcpy (d, newData, (size_t) numBytes);
+    if (d == nullptr)
+        return false;
 
+    MidiBufferHelpers::writeEvent (d, sampleNumber, newData, numBytes);
     return true;
 }
 
 void MidiBuffer::addEvents (const MidiBuffer& otherBuffer,
                             int startSample, int numSamples, int sampleDeltaToAdd)
 {
-    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    // Adding a buffer to itself isn't supported
+    jassert (&otherBuffer != this);
+
+    const auto first = otherBuffer.findNextSamplePosition (startSample);
+    auto last = first;
+    size_t numNewBytes = 0;
+
+    for (; last != otherBuffer.cend(); ++last)
     {
-        const auto metadata = *i;
+        const auto metadata = *last;
 
         if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
             break;
 
-        addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd);
+        numNewBytes += MidiBufferHelpers::headerSize + (size_t) metadata.numBytes;
+    }
+
+    if (numNewBytes == 0)
+        return;
+
+    if (! ensureCapacity (numBytesUsed + numNewBytes))
+    {
+        // There's not enough external storage for all the events, so add as many as will fit
+        for (auto i = first; i != last; ++i)
+        {
+            const auto metadata = *i;
+
+            if (! addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd))
+                break;
+        }
+
+        return;
+    }
+
+    // The existing events are moved out of the way to the end of the storage, and then merged
+    // with the new events back towards the start. The write position can never overtake the
+    // read position, because the gap between them is the size of the new events still to add.
+    const auto isAppending = numBytesUsed == 0 || getLastEventTime() <= (*first).samplePosition + sampleDeltaToAdd;
+    auto* readEnd = storage + numBytesUsed + numNewBytes;
+    auto* read    = isAppending ? readEnd : storage + numNewBytes;
+    auto* write   = isAppending ? storage + numBytesUsed : storage;
+
+    if (! isAppending)
+        memmove (read, storage, numBytesUsed);
+
+    const auto oldLastEventOffset = lastEventOffset;
+
+    for (auto i = first; i != last; ++i)
+    {
+        const auto metadata = *i;
+        const auto samplePosition = metadata.samplePosition + sampleDeltaToAdd;
+
+        auto* runEnd = read;
+
+        while (runEnd < readEnd && MidiBufferHelpers::getEventTime (runEnd) <= samplePosition)
+            runEnd += MidiBufferHelpers::getEventTotalSize (runEnd);
+
+        if (runEnd != read)
+        {
+            memmove (write, read, (size_t) (runEnd - read));
+            write += runEnd - read;
+            read = runEnd;
+        }
+
+        lastEventOffset = (size_t) (write - storage);
+        MidiBufferHelpers::writeEvent (write, samplePosition, metadata.data, metadata.numBytes);
+        write += MidiBufferHelpers::headerSize + (size_t) metadata.numBytes;
     }
+
+    // Any remaining existing events are already in place, after all of the new ones
+    jassert (write == read);
+
+    if (read != readEnd)
+        lastEventOffset = oldLastEventOffset + numNewBytes;
+
+    numBytesUsed += numNewBytes;
 }
 
 int MidiBuffer::getNumEvents() const noexcept
 {
     int n = 0;
-    auto end = data.end();
+    auto end = storage + numBytesUsed;
 
-    for (auto d = data.begin(); d < end; ++n)
+    for (auto d = storage; d < end; ++n)
         d += MidiBufferHelpers::getEventTotalSize (d);
 
     return n;
@@ -179,25 +381,12 @@ int MidiBuffer::getNumEvents() const noexcept
 
 int MidiBuffer::getFirstEventTime() const noexcept
 {
-    return data.size() > 0 ? MidiBufferHelpers::getEventTime (data.begin()) : 0;
+    return numBytesUsed > 0 ? MidiBufferHelpers::getEventTime (storage) : 0;
 }
 
 int MidiBuffer::getLastEventTime() const noexcept
 {
-    if (data.size() == 0)
-        return 0;
-
-    auto endData = data.end();
-
-    for (auto d = data.begin();;)
-    {
-        auto nextOne = d + MidiBufferHelpers::getEventTotalSize (d);
-
-        if (nextOne >= endData)
-            return MidiBufferHelpers::getEventTime (d);
-
-        d = nextOne;
-    }
+    return numBytesUsed > 0 ? MidiBufferHelpers::getEventTime (storage + lastEventOffset) : 0;
 }
 
 MidiBufferIterator MidiBuffer::findNextSamplePosition (int samplePosition) const noexcept
@@ -213,7 +402,7 @@ JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wdeprecated-declarations")
 JUCE_BEGIN_IGNORE_WARNINGS_MSVC (4996)
 
 MidiBuffer::Iterator::Iterator (const MidiBuffer& b) noexcept
-    : buffer (b), iterator (b.data.begin())
+    : buffer (b), iterator (b.cbegin())
 {
 }
 
@@ -310,6 +499,152 @@ struct MidiBufferTest  : public UnitTest
                 expectEquals (buffer.getNumEvents(), 1);
             }
         }
+
+        beginTest ("Events are kept sorted when added out of order");
+        {
+            auto random = getRandom();
+            MidiBuffer buffer;
+            std::vector<std::pair<int, int>> expected;
+
+            for (auto i = 0; i < 1000; ++i)
+            {
+                const auto time = random.nextInt (100);
+                buffer.addEvent (MidiMessage::controllerEvent (1, 1, i % 128), time);
+                expected.emplace_back (time, i % 128);
+            }
+
+            std::stable_sort (expected.begin(), expected.end(), [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+            expect (buffer.getFirstEventTime() == expected.front().first);
+            expect (buffer.getLastEventTime()  == expected.back().first);
+            expectEquals (buffer.getNumEvents(), (int) expected.size());
+            expectEvents (buffer, expected);
+        }
+
+        beginTest ("Clearing doesn't release memory");
+        {
+            MidiBuffer buffer;
+
+            for (auto i = 0; i < 100; ++i)
+                buffer.addEvent (MidiMessage::noteOn (1, 64, 0.5f), i);
+
+            const auto capacity = buffer.getCapacity();
+            expect (capacity > 0);
+
+            buffer.clear (0, 99);
+            expectEquals (buffer.getNumEvents(), 1);
+            expectEquals (buffer.getLastEventTime(), 99);
+            expect (buffer.getCapacity() == capacity);
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expect (buffer.getCapacity() == capacity);
+        }
+
+        beginTest ("External storage is never exceeded");
+        {
+            constexpr auto eventSize = sizeof (int32) + sizeof (uint16) + 3;
+            std::array<uint8, eventSize * 10 + 2> arena{};
+            MidiBuffer buffer (arena.data(), arena.size());
+
+            expect (buffer.usesExternalStorage());
+
+            for (auto i = 0; i < 10; ++i)
+                expect (buffer.addEvent (MidiMessage::noteOn (1, 64, 0.5f), 10 - i));
+
+            expect (! buffer.addEvent (MidiMessage::noteOn (1, 64, 0.5f), 20));
+            expectEquals (buffer.getNumEvents(), 10);
+            expectEquals (buffer.getFirstEventTime(), 1);
+            expectEquals (buffer.getLastEventTime(), 10);
+            expect (buffer.getCapacity() == arena.size());
+
+            buffer.clear();
+            expect (buffer.addEvent (MidiMessage::noteOn (1, 64, 0.5f), 0));
+
+            MidiBuffer other;
+
+            for (auto i = 0; i < 20; ++i)
+                other.addEvent (MidiMessage::noteOff (1, 64), i);
+
+            buffer.addEvents (other, 0, -1, 0);
+            expectEquals (buffer.getNumEvents(), 10);
+
+            const MidiBuffer copy (buffer);
+            expect (! copy.usesExternalStorage());
+            expectEquals (copy.getNumEvents(), 10);
+
+            buffer = other;
+            expect (buffer.usesExternalStorage());
+            expectEquals (buffer.getNumEvents(), 10);
+        }
+
+        beginTest ("Adding events from another buffer merges them in order");
+        {
+            auto random = getRandom();
+
+            for (auto iteration = 0; iteration < 20; ++iteration)
+            {
+                const auto makeBuffer = [&] (int firstValue)
+                {
+                    std::vector<std::pair<int, int>> events;
+
+                    for (auto i = 0; i < 200; ++i)
+                        events.emplace_back (random.nextInt (300), (firstValue + i) % 128);
+
+                    std::stable_sort (events.begin(), events.end(), [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+                    MidiBuffer result;
+
+                    for (const auto& e : events)
+                        result.addEvent (MidiMessage::controllerEvent (1, 1, e.second), e.first);
+
+                    return result;
+                };
+
+                auto destination = makeBuffer (0);
+                const auto source = makeBuffer (50);
+                const auto startSample = random.nextInt (100);
+                const auto numSamples = random.nextInt (300) - 50;
+                const auto delta = random.nextInt (200) - 100;
+
+                auto reference = destination;
+
+                for (const auto metadata : source)
+                    if (metadata.samplePosition >= startSample && (numSamples < 0 || metadata.samplePosition < startSample + numSamples))
+                        reference.addEvent (metadata.data, metadata.numBytes, metadata.samplePosition + delta);
+
+                destination.addEvents (source, startSample, numSamples, delta);
+
+                std::vector<std::pair<int, int>> expected;
+
+                for (const auto metadata : reference)
+                    expected.emplace_back (metadata.samplePosition, metadata.getMessage().getControllerValue());
+
+                expectEquals (destination.getNumEvents(), reference.getNumEvents());
+                expectEquals (destination.getLastEventTime(), reference.getLastEventTime());
+                expectEvents (destination, expected);
+            }
+        }
+    }
+
+    void expectEvents (const MidiBuffer& buffer, const std::vector<std::pair<int, int>>& expected)
+    {
+        auto it = expected.begin();
+
+        for (const auto metadata : buffer)
+        {
+            if (it == expected.end())
+            {
+                expect (false, "Too many events in buffer");
+                return;
+            }
+
+            expectEquals (metadata.samplePosition, it->first);
+            expectEquals (metadata.getMessage().getControllerValue(), it->second);
+            ++it;
+        }
+
+        expect (it == expected.end());
     }
 };
 
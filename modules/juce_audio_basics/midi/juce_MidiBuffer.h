@@ -137,6 +137,15 @@ private:
     appropriate container. MidiBuffer is designed for lower-level streams of raw
     midi data.
 
+    Events are stored back-to-back in a single contiguous block of memory. Adding
+    an event at or after the time of the last event in the buffer just appends it,
+    so building a buffer in time order is a linear operation. The memory used by
+    the buffer is never released by clearing it, so once a buffer has grown large
+    enough (or has been given enough space with ensureSize()) it can be cleared and
+    refilled on the audio thread without allocating. Alternatively, a buffer can be
+    given a fixed block of memory to use when it is created, in which case it will
+    never allocate at all.
+
     @see MidiMessage
 
     @tags{Audio}
@@ -151,16 +160,52 @@ public:
     /** Creates a MidiBuffer containing a single midi message. */
     explicit MidiBuffer (const MidiMessage& message) noexcept;
 
+    /** Creates an empty MidiBuffer which stores its events in a block of memory
+        supplied by the caller.
+
+        The buffer will never allocate: once the block is full, any attempt to add
+        more events will fail, and addEvent() will return false. This makes it
+        possible to share a single preallocated pool of memory between many buffers
+        that are used on the audio thread.
+
+        The memory is not owned by the buffer, and must remain valid for as long as
+        the buffer (or any other buffer that it is swapped or moved into) is using it.
+        Copying a buffer that uses external memory creates a buffer that allocates
+        its own storage.
+    */
+    MidiBuffer (uint8* externalStorage, size_t numBytesAvailable) noexcept;
+
+    /** Creates a copy of another buffer. The copy always allocates its own storage. */
+    MidiBuffer (const MidiBuffer&);
+
+    /** Replaces the contents of this buffer with a copy of another buffer's events.
+
+        The storage of this buffer is reused where possible. If this buffer uses
+        external memory which is too small to hold all the other buffer's events,
+        only the events that fit will be copied.
+    */
+    MidiBuffer& operator= (const MidiBuffer&);
+
+    /** Move constructor. The new buffer takes over the other buffer's storage. */
+    MidiBuffer (MidiBuffer&&) noexcept;
+
+    /** Move assignment operator. This buffer takes over the other buffer's storage. */
+    MidiBuffer& operator= (MidiBuffer&&) noexcept;
+
     //==============================================================================
-    /** Removes all events from the buffer. */
+    /** Removes all events from the buffer.
+
+        The memory used by the buffer is kept, so refilling it won't allocate unless
+        more space than before is needed.
+    */
     void clear() noexcept;
 
     /** Removes all events between two times from the buffer.
 
         All events for which (start <= event position < start + numSamples) will
-        be removed.
+        be removed. Like clear(), this never releases any of the buffer's memory.
     */
-    void clear (int start, int numSamples);
+    void clear (int start, int numSamples) noexcept;
 
     /** Returns true if the buffer is empty.
         To actually retrieve the events, use a MidiBufferIterator object
@@ -184,9 +229,13 @@ public:
         If an event is added whose sample position is the same as one or more events
         already in the buffer, the new event will be placed after the existing ones.
 
+        Adding an event whose sample position is not earlier than that of the last
+        event in the buffer is a fast, constant-time operation.
+
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure, which can happen if the buffer
+        uses external storage that is full.
     */
     bool addEvent (const MidiMessage& midiMessage, int sampleNumber);
 
@@ -204,9 +253,13 @@ public:
         it'll actually only store 3 bytes. If the midi data is invalid, it might not
         add an event at all.
 
+        Adding an event whose sample position is not earlier than that of the last
+        event in the buffer is a fast, constant-time operation.
+
         To retrieve events, use a MidiBufferIterator object.
 
-        Returns true on success, or false on failure.
+        Returns true on success, or false on failure, which can happen if the buffer
+        uses external storage that is full.
     */
     bool addEvent (const void* rawMidiData,
                    int maxBytesOfMidiData,
@@ -214,6 +267,12 @@ public:
 
     /** Adds some events from another buffer to this one.
 
+        The new events are merged with the existing ones in a single pass, so this
+        takes time proportional to the total size of the two buffers, and is much
+        faster than adding the events one at a time. If the buffer uses external
+        storage that can't hold all of the new events, only the events that fit
+        will be added.
+
         @param otherBuffer          the buffer containing the events you want to add
         @param startSample          the lowest sample number in the source buffer for which
                                     events should be added. Any source events whose timestamp is
@@ -252,9 +311,19 @@ public:
     /** Preallocates some memory for the buffer to use.
         This helps to avoid needing to reallocate space when the buffer has messages
         added to it.
+
+        Buffers that use external storage can't grow, so this does nothing for them.
     */
     void ensureSize (size_t minimumNumBytes);
 
+    /** Returns the number of bytes of event data that the buffer can hold without
+        needing to allocate more memory.
+    */
+    size_t getCapacity() const noexcept        { return capacity; }
+
+    /** Returns true if this buffer is using a block of memory supplied by the caller. */
+    bool usesExternalStorage() const noexcept  { return isExternal; }
+
     /** Get a read-only iterator pointing to the beginning of this buffer. */
     MidiBufferIterator begin()  const noexcept { return cbegin(); }
 
@@ -262,10 +331,10 @@ public:
     MidiBufferIterator end()    const noexcept { return cend(); }
 
     /** Get a read-only iterator pointing to the beginning of this buffer. */
-    MidiBufferIterator cbegin() const noexcept { return MidiBufferIterator (data.begin()); }
+    MidiBufferIterator cbegin() const noexcept { return MidiBufferIterator (storage); }
 
     /** Get a read-only iterator pointing one past the end of this buffer. */
-    MidiBufferIterator cend()   const noexcept { return MidiBufferIterator (data.end()); }
+    MidiBufferIterator cend()   const noexcept { return MidiBufferIterator (storage + numBytesUsed); }
 
     /** Get an iterator pointing to the first event with a timestamp greater-than or
         equal-to `samplePosition`.
@@ -332,13 +401,17 @@ public:
     };
    #endif
 
-    /** The raw data holding this buffer.
-        Obviously access to this data is provided at your own risk. Its internal format could
-        change in future, so don't write code that relies on it!
-    */
-    Array<uint8> data;
-
 private:
+    //==============================================================================
+    bool ensureCapacity (size_t minimumNumBytes);
+    uint8* insertSpace (size_t offset, size_t numBytes);
+    void updateLastEventOffset() noexcept;
+
+    HeapBlock<uint8> allocatedStorage;
+    uint8* storage = nullptr;
+    size_t numBytesUsed = 0, capacity = 0, lastEventOffset = 0;
+    bool isExternal = false;
+
     JUCE_LEAK_DETECTOR (MidiBuffer)
 };
 
@@ -1009,7 +1009,12 @@ private:
 
     static bool equal (const MidiBuffer& a, const MidiBuffer& b) noexcept
     {
-        return a.data == b.data;
+        return std::equal (a.begin(), a.end(), b.begin(), b.end(), [] (const auto& x, const auto& y)
+        {
+            return x.samplePosition == y.samplePosition
+                && x.numBytes == y.numBytes
+                && std::equal (x.data, x.data + x.numBytes, y.data);
+        });
     }
 };
 
@@ -264,6 +264,9 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
         const ScopedLock sl (voicesLock);
         newVoice->setCurrentSampleRate (getSampleRate());
         voices.add (newVoice);
+
+        if (parallelRenderer != nullptr)
+            parallelRenderer->prepareForNumVoices (voices.size());
     }
 
     {
@@ -326,11 +329,39 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
     instrument.releaseAllNotes();
 }
 
+//==============================================================================
+void MPESynthesiser::setNumParallelRenderThreads (int numThreads, int maxNumOutputChannels)
+{
+    std::unique_ptr<detail::ParallelVoiceRenderer<MPESynthesiserVoice>> newRenderer;
+
+    // The worker threads are started and stopped outside the lock, so that the
+    // audio thread isn't held up
+    if (numThreads > 0)
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer<MPESynthesiserVoice>> (numThreads, maxNumOutputChannels);
+
+    {
+        const ScopedLock sl (voicesLock);
+
+        if (newRenderer != nullptr)
+            newRenderer->prepareForNumVoices (voices.size());
+
+        std::swap (parallelRenderer, newRenderer);
+    }
+}
+
+int MPESynthesiser::getNumParallelRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumWorkerThreads() : 0;
+}
+
 //==============================================================================
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
+    if (parallelRenderer != nullptr && parallelRenderer->render (voices, buffer, startSample, numSamples, false))
+        return;
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -342,6 +373,9 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
 {
     const ScopedLock sl (voicesLock);
 
+    if (parallelRenderer != nullptr && parallelRenderer->render (voices, buffer, startSample, numSamples, false))
+        return;
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -349,4 +383,124 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startS
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class MPESynthesiserTests  : public UnitTest
+{
+public:
+    MPESynthesiserTests()
+        : UnitTest ("MPE Synthesiser", UnitTestCategories::midi) {}
+
+    void runTest() override
+    {
+        beginTest ("Parallel rendering matches serial rendering");
+        {
+            expect (getMaxDifference (render<float>  (0), render<float>  (3)) < 1.0e-5f);
+            expect (getMaxDifference (render<double> (0), render<double> (3)) < 1.0e-12);
+        }
+
+        beginTest ("Parallel rendering is deterministic");
+        {
+            const auto first = render<float> (2);
+
+            for (int i = 0; i < 5; ++i)
+                expect (exactlyEqual (getMaxDifference (first, render<float> (2)), 0.0f));
+        }
+    }
+
+private:
+    struct TestVoice  : public MPESynthesiserVoice
+    {
+        void noteStarted() override
+        {
+            phase = 0.0;
+            increment = getCurrentlyPlayingNote().getFrequencyInHertz() / currentSampleRate;
+        }
+
+        void noteStopped (bool) override            { clearCurrentNote(); }
+        void notePressureChanged() override         {}
+        void notePitchbendChanged() override        {}
+        void noteTimbreChanged() override           {}
+        void noteKeyStateChanged() override         {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override    { renderInto (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override   { renderInto (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void renderInto (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto value = 0.1 * std::sin (MathConstants<double>::twoPi * phase);
+                phase += increment;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, (FloatType) (value * (channel + 1)));
+            }
+        }
+
+        double phase = 0.0, increment = 0.0;
+    };
+
+    template <typename FloatType>
+    static AudioBuffer<FloatType> render (int numThreads)
+    {
+        constexpr int blockSize = 512, numBlocks = 16, notesPerBlock = 4, noteLengthInBlocks = 5;
+
+        MPESynthesiser synth;
+        synth.enableLegacyMode();
+        synth.setNumParallelRenderThreads (numThreads);
+
+        for (int i = 0; i < 64; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        const auto getChannel    = [] (int noteIndex) { return 1 + noteIndex % 16; };
+        const auto getNoteNumber = [] (int noteIndex) { return 30 + noteIndex % 60; };
+
+        AudioBuffer<FloatType> result (2, blockSize * numBlocks);
+        result.clear();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            MidiBuffer midi;
+
+            for (int note = 0; note < notesPerBlock; ++note)
+            {
+                const auto started = block * notesPerBlock + note;
+                midi.addEvent (MidiMessage::noteOn (getChannel (started), getNoteNumber (started), 0.8f), note * 100);
+
+                const auto released = started - noteLengthInBlocks * notesPerBlock;
+
+                if (released >= 0)
+                    midi.addEvent (MidiMessage::noteOff (getChannel (released), getNoteNumber (released)), note * 100 + 50);
+            }
+
+            AudioBuffer<FloatType> view (result.getArrayOfWritePointers(), 2, block * blockSize, blockSize);
+            synth.renderNextBlock (view, midi, 0, blockSize);
+        }
+
+        return result;
+    }
+
+    template <typename FloatType>
+    static FloatType getMaxDifference (const AudioBuffer<FloatType>& a, const AudioBuffer<FloatType>& b)
+    {
+        FloatType result = 0;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return result;
+    }
+};
+
+static MPESynthesiserTests mpeSynthesiserTests;
+
+#endif
+
 } // namespace juce
@@ -23,6 +23,8 @@
 namespace juce
 {
 
+namespace detail { template <typename VoiceType> class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Base class for an MPE-compatible musical device that can play sounds.
@@ -135,6 +137,40 @@ public:
     */
     void setCurrentPlaybackSampleRate (double newRate) override;
 
+    //==============================================================================
+    /** Allows the voices to be rendered concurrently.
+
+        By default, the voices are rendered one after another on the audio thread. If you
+        supply a number of threads greater than zero here, the synth will create that many
+        high-priority worker threads, which will help the audio thread to render the active
+        voices in each block. The voices are split into groups which are each rendered into
+        a separate buffer, and these buffers are then added to the output in a fixed order,
+        so the output doesn't depend on which thread happened to render each voice.
+
+        When this is enabled, the renderNextBlock() methods of the voices may be called on
+        any of the worker threads, and several voices will be rendered at the same time. So
+        your voices must not modify any state that's shared with other voices without
+        synchronising access to it.
+
+        The maxNumOutputChannels parameter sets the size of the scratch buffers. Blocks with
+        more channels than this will be rendered serially on the audio thread.
+
+        Passing zero disables parallel rendering and destroys the worker threads. This must
+        not be called from the audio thread.
+
+        Note that this only affects the default implementation of renderNextSubBlock().
+
+        @see getNumParallelRenderThreads
+    */
+    void setNumParallelRenderThreads (int numThreads, int maxNumOutputChannels = 2);
+
+    /** Returns the number of worker threads used for rendering the voices, or zero if
+        parallel rendering is disabled.
+
+        @see setNumParallelRenderThreads
+    */
+    int getNumParallelRenderThreads() const noexcept;
+
     //==============================================================================
     /** Handle incoming MIDI events.
 
@@ -306,6 +342,7 @@ private:
     uint32 lastNoteOnCounter = 0;
     mutable CriticalSection stealLock;
     mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
+    std::unique_ptr<detail::ParallelVoiceRenderer<MPESynthesiserVoice>> parallelRenderer;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
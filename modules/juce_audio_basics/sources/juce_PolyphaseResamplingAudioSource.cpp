@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PolyphaseResamplingAudioSource::PolyphaseResamplingAudioSource (AudioSource* inputSource,
+                                                                bool deleteInputWhenDeleted,
+                                                                int channels,
+                                                                PolyphaseResampler::Quality q)
+    : input (inputSource, deleteInputWhenDeleted),
+      numChannels (channels),
+      quality (q)
+{
+    jassert (input != nullptr);
+}
+
+PolyphaseResamplingAudioSource::~PolyphaseResamplingAudioSource() {}
+
+void PolyphaseResamplingAudioSource::setResamplingRatio (double samplesInPerOutputSample)
+{
+    jassert (samplesInPerOutputSample > 0);
+
+    const ScopedLock sl (callbackLock);
+    ratio = samplesInPerOutputSample;
+
+    if (outputSampleRate > 0)
+        prepareResampler();
+}
+
+void PolyphaseResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    const ScopedLock sl (callbackLock);
+
+    input->prepareToPlay (roundToInt (samplesPerBlockExpected * ratio), sampleRate * ratio);
+
+    outputSampleRate = sampleRate;
+    blockSize = samplesPerBlockExpected;
+    destBuffers.calloc (numChannels);
+    srcBuffers.calloc (numChannels);
+    prepareResampler();
+}
+
+void PolyphaseResamplingAudioSource::prepareResampler()
+{
+    resampler.prepare (outputSampleRate * ratio, outputSampleRate, numChannels, quality);
+
+    inputBuffer.setSize (numChannels, resampler.getNumInputSamplesNeeded (blockSize) + 32);
+    spareOutputChannels.setSize (numChannels, blockSize);
+}
+
+void PolyphaseResamplingAudioSource::flushBuffers()
+{
+    const ScopedLock sl (callbackLock);
+    resampler.reset();
+}
+
+void PolyphaseResamplingAudioSource::releaseResources()
+{
+    input->releaseResources();
+
+    const ScopedLock sl (callbackLock);
+    inputBuffer.setSize (numChannels, 0);
+    spareOutputChannels.setSize (numChannels, 0);
+}
+
+void PolyphaseResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& info)
+{
+    const ScopedLock sl (callbackLock);
+
+    const auto numNeeded = resampler.getNumInputSamplesNeeded (info.numSamples);
+
+    if (inputBuffer.getNumSamples() < numNeeded)
+        inputBuffer.setSize (numChannels, numNeeded, false, false, true);
+
+    if (spareOutputChannels.getNumSamples() < info.numSamples)
+        spareOutputChannels.setSize (numChannels, info.numSamples, false, false, true);
+
+    if (numNeeded > 0)
+    {
+        AudioSourceChannelInfo readInfo (&inputBuffer, 0, numNeeded);
+        input->getNextAudioBlock (readInfo);
+    }
+
+    const auto numOutputChannels = info.buffer->getNumChannels();
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        srcBuffers[channel] = inputBuffer.getReadPointer (channel);
+        destBuffers[channel] = channel < numOutputChannels ? info.buffer->getWritePointer (channel, info.startSample)
+                                                           : spareOutputChannels.getWritePointer (channel);
+    }
+
+    [[maybe_unused]] const auto result = resampler.process (srcBuffers, numNeeded, destBuffers, info.numSamples);
+    jassert (result.numInputSamplesUsed == numNeeded && result.numOutputSamplesProduced == info.numSamples);
+
+    for (int channel = numChannels; channel < numOutputChannels; ++channel)
+        info.buffer->clear (channel, info.startSample, info.numSamples);
+}
+
+} // namespace juce
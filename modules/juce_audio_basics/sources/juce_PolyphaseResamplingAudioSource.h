@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A type of AudioSource that takes an input source and changes its sample rate,
+    using a PolyphaseResampler.
+
+    This gives much better quality than ResamplingAudioSource, but changing the ratio
+    means designing a new set of filters, so it's intended for converting between fixed
+    sample rates rather than for varispeed effects.
+
+    @see PolyphaseResampler, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResamplingAudioSource  : public AudioSource
+{
+public:
+    //==============================================================================
+    /** Creates a PolyphaseResamplingAudioSource for a given input source.
+
+        @param inputSource              the input source to read from
+        @param deleteInputWhenDeleted   if true, the input source will be deleted when
+                                        this object is deleted
+        @param numChannels              the number of channels to process
+        @param quality                  the quality of the resampling filters
+    */
+    PolyphaseResamplingAudioSource (AudioSource* inputSource,
+                                    bool deleteInputWhenDeleted,
+                                    int numChannels = 2,
+                                    PolyphaseResampler::Quality quality = PolyphaseResampler::Quality::high);
+
+    /** Destructor. */
+    ~PolyphaseResamplingAudioSource() override;
+
+    /** Changes the resampling ratio.
+
+        If the source has already been prepared, this designs a new set of filters, which
+        allocates memory and briefly blocks the audio thread, so avoid calling it while
+        the source is playing. Note that the input source doesn't get prepared again at
+        the new rate until prepareToPlay() is next called.
+
+        @param samplesInPerOutputSample     the input sample rate divided by the output
+                                            sample rate. This must be greater than 0
+    */
+    void setResamplingRatio (double samplesInPerOutputSample);
+
+    /** Returns the current resampling ratio.
+
+        This is the value that was set by setResamplingRatio().
+    */
+    double getResamplingRatio() const noexcept                  { return ratio; }
+
+    /** Clears any buffers and filters that the resampler is using. */
+    void flushBuffers();
+
+    //==============================================================================
+    void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
+    void releaseResources() override;
+    void getNextAudioBlock (const AudioSourceChannelInfo&) override;
+
+private:
+    //==============================================================================
+    void prepareResampler();
+
+    OptionalScopedPointer<AudioSource> input;
+    double ratio = 1.0, outputSampleRate = 0.0;
+    PolyphaseResampler resampler;
+    AudioBuffer<float> inputBuffer, spareOutputChannels;
+    HeapBlock<float*> destBuffers;
+    HeapBlock<const float*> srcBuffers;
+    CriticalSection callbackLock;
+    const int numChannels;
+    const PolyphaseResampler::Quality quality;
+    int blockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResamplingAudioSource)
+};
+
+} // namespace juce
@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  Reorders a list of voices so that voices which share a SynthesiserVoiceBatchRenderer
+    are next to one another, without otherwise changing their order. The scratch space
+    must have room for numVoices pointers.
+
+    This takes one pass over the voices for each distinct renderer, and there are
+    normally only one or two of those.
+*/
+inline void groupVoicesByBatchRenderer (SynthesiserVoice** voices, int numVoices, SynthesiserVoice** scratch)
+{
+    std::copy (voices, voices + numVoices, scratch);
+
+    for (int start = 0, numGrouped = 0; numGrouped < numVoices; ++start)
+    {
+        if (scratch[start] == nullptr)
+            continue;
+
+        auto* renderer = scratch[start]->getBatchRenderer();
+
+        for (auto i = start; i < numVoices; ++i)
+        {
+            if (scratch[i] != nullptr && scratch[i]->getBatchRenderer() == renderer)
+            {
+                voices[numGrouped++] = scratch[i];
+                scratch[i] = nullptr;
+            }
+        }
+    }
+}
+
+inline void groupVoicesByBatchRenderer (MPESynthesiserVoice**, int, MPESynthesiserVoice**) {}
+
+/*  Renders a list of voices that has been through groupVoicesByBatchRenderer(), handing each
+    run of voices that share a batch renderer to that renderer in one go.
+*/
+template <typename FloatType>
+void renderVoiceList (SynthesiserVoice* const* voices, int numVoices,
+                      AudioBuffer<FloatType>& output, int startSample, int numSamples)
+{
+    for (int start = 0; start < numVoices;)
+    {
+        auto* renderer = voices[start]->getBatchRenderer();
+        auto end = start + 1;
+
+        if (renderer == nullptr)
+        {
+            voices[start]->renderNextBlock (output, startSample, numSamples);
+        }
+        else
+        {
+            while (end < numVoices && voices[end]->getBatchRenderer() == renderer)
+                ++end;
+
+            renderer->renderVoices (voices + start, end - start, output, startSample, numSamples);
+        }
+
+        start = end;
+    }
+}
+
+template <typename FloatType>
+void renderVoiceList (MPESynthesiserVoice* const* voices, int numVoices,
+                      AudioBuffer<FloatType>& output, int startSample, int numSamples)
+{
+    for (int i = 0; i < numVoices; ++i)
+        voices[i]->renderNextBlock (output, startSample, numSamples);
+}
+
+//==============================================================================
+/*  Renders a set of synthesiser voices using a RealtimeWorkerGroup.
+
+    The active voices are split into a fixed number of contiguous groups. Each
+    group is rendered by whichever thread claims it, into that group's own
+    scratch buffer, and the scratch buffers are then added to the output in
+    group order. This means the output doesn't depend on which thread rendered
+    which voice, so it's the same every time for a given number of threads.
+
+    VoiceType can be either SynthesiserVoice or MPESynthesiserVoice.
+*/
+template <typename VoiceType>
+class ParallelVoiceRenderer
+{
+public:
+    ParallelVoiceRenderer (int numWorkerThreads, int maxNumChannelsToUse)
+        : workers (numWorkerThreads),
+          maxNumChannels (jmax (1, maxNumChannelsToUse)),
+          numGroups (2 * workers.getMaxNumThreadIndices())
+    {
+        floatScratch .setSize (numGroups * maxNumChannels, sliceSize);
+        doubleScratch.setSize (numGroups * maxNumChannels, sliceSize);
+    }
+
+    int getNumWorkerThreads() const noexcept        { return workers.getNumWorkerThreads(); }
+
+    /*  Must be called (outside the audio callback) whenever voices are added, so that
+        render() never needs to allocate.
+    */
+    void prepareForNumVoices (int numVoices)
+    {
+        voicesToRender.reserve ((size_t) numVoices);
+        groupingScratch.resize ((size_t) numVoices);
+    }
+
+    /*  Adds the output of the voices to the given buffer, returning false if the buffer
+        has more channels than this object was created for. Voices that aren't active are
+        rendered on the calling thread if renderInactiveVoices is true, or skipped otherwise.
+    */
+    template <typename FloatType>
+    bool render (const OwnedArray<VoiceType>& voices, AudioBuffer<FloatType>& output,
+                 int startSample, int numSamples, bool renderInactiveVoices)
+    {
+        const auto numChannels = output.getNumChannels();
+
+        if (numChannels > maxNumChannels)
+            return false;
+
+        // If this is hit, prepareForNumVoices() wasn't called after adding some voices
+        jassert ((size_t) voices.size() <= voicesToRender.capacity());
+
+        voicesToRender.clear();
+
+        for (auto* voice : voices)
+        {
+            if (isVoiceActive (*voice))
+                voicesToRender.push_back (voice);
+            else if (renderInactiveVoices)
+                voice->renderNextBlock (output, startSample, numSamples);
+        }
+
+        if (voicesToRender.size() < 2)
+        {
+            renderVoiceList (voicesToRender.data(), (int) voicesToRender.size(), output, startSample, numSamples);
+            return true;
+        }
+
+        groupVoicesByBatchRenderer (voicesToRender.data(), (int) voicesToRender.size(), groupingScratch.data());
+
+        RenderJob<FloatType> job (*this, getScratch<FloatType>(), numChannels);
+
+        for (int offset = 0; offset < numSamples; offset += sliceSize)
+        {
+            job.numSamples = jmin (sliceSize, numSamples - offset);
+            job.nextGroup = 0;
+
+            workers.perform (job);
+
+            for (int group = 0; group < job.numGroupsInUse; ++group)
+                for (int channel = 0; channel < numChannels; ++channel)
+                    output.addFrom (channel, startSample + offset,
+                                    job.scratch, group * maxNumChannels + channel,
+                                    0, job.numSamples);
+        }
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    template <typename FloatType>
+    struct RenderJob  : public RealtimeWorkerGroup::Job
+    {
+        RenderJob (ParallelVoiceRenderer& o, AudioBuffer<FloatType>& s, int numChannelsToUse)
+            : owner (o),
+              scratch (s),
+              numChannels (numChannelsToUse),
+              numGroupsInUse (jmin (o.numGroups, (int) o.voicesToRender.size()))
+        {}
+
+        void run (int) override
+        {
+            for (;;)
+            {
+                const auto group = nextGroup.fetch_add (1);
+
+                if (group >= numGroupsInUse)
+                    return;
+
+                renderGroup (group);
+            }
+        }
+
+        void renderGroup (int group)
+        {
+            const auto numVoices = (int) owner.voicesToRender.size();
+            const auto firstVoice = (group * numVoices) / numGroupsInUse;
+            const auto endVoice = ((group + 1) * numVoices) / numGroupsInUse;
+
+            const auto firstChannel = group * owner.maxNumChannels;
+            AudioBuffer<FloatType> groupBuffer (scratch.getArrayOfWritePointers() + firstChannel,
+                                                numChannels, numSamples);
+            groupBuffer.clear();
+
+            renderVoiceList (owner.voicesToRender.data() + firstVoice, endVoice - firstVoice, groupBuffer, 0, numSamples);
+        }
+
+        ParallelVoiceRenderer& owner;
+        AudioBuffer<FloatType>& scratch;
+        const int numChannels, numGroupsInUse;
+        int numSamples = 0;
+        std::atomic<int> nextGroup { 0 };
+    };
+
+    static bool isVoiceActive (const SynthesiserVoice& voice)       { return voice.isVoiceActive(); }
+    static bool isVoiceActive (const MPESynthesiserVoice& voice)    { return voice.isActive(); }
+
+    template <typename FloatType>
+    AudioBuffer<FloatType>& getScratch() noexcept
+    {
+        if constexpr (std::is_same_v<FloatType, float>)
+            return floatScratch;
+        else
+            return doubleScratch;
+    }
+
+    // Longer blocks are rendered in slices of this length, so the scratch space doesn't
+    // depend on the host's block size
+    static constexpr int sliceSize = 256;
+
+    RealtimeWorkerGroup workers;
+    const int maxNumChannels, numGroups;
+    AudioBuffer<float> floatScratch;
+    AudioBuffer<double> doubleScratch;
+    std::vector<VoiceType*> voicesToRender, groupingScratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelVoiceRenderer)
+};
+
+} // namespace juce::detail
@@ -26,6 +26,19 @@ namespace juce
 SynthesiserSound::SynthesiserSound() {}
 SynthesiserSound::~SynthesiserSound() {}
 
+//==============================================================================
+void SynthesiserVoiceBatchRenderer::renderVoices (SynthesiserVoice* const* voices, int numVoices,
+                                                  AudioBuffer<double>& outputBuffer, int startSample, int numSamples)
+{
+    for (int i = 0; i < numVoices; ++i)
+        voices[i]->renderNextBlock (outputBuffer, startSample, numSamples);
+}
+
+void SynthesiserVoiceBatchRenderer::clearCurrentNote (SynthesiserVoice& voice)
+{
+    voice.clearCurrentNote();
+}
+
 //==============================================================================
 SynthesiserVoice::SynthesiserVoice() {}
 SynthesiserVoice::~SynthesiserVoice() {}
@@ -104,6 +117,11 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
+        voicesToBatch.reserve ((size_t) voices.size());
+        batchGroupingScratch.resize ((size_t) voices.size());
+
+        if (parallelRenderer != nullptr)
+            parallelRenderer->prepareForNumVoices (voices.size());
     }
 
     {
@@ -241,14 +259,58 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    if (parallelRenderer == nullptr || ! parallelRenderer->render (voices, buffer, startSample, numSamples, true))
+        renderVoicesSerially (buffer, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
+    if (parallelRenderer == nullptr || ! parallelRenderer->render (voices, buffer, startSample, numSamples, true))
+        renderVoicesSerially (buffer, startSample, numSamples);
+}
+
+template <typename floatType>
+void Synthesiser::renderVoicesSerially (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
+{
+    voicesToBatch.clear();
+
     for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    {
+        if (voice->getBatchRenderer() != nullptr && voice->isVoiceActive())
+            voicesToBatch.push_back (voice);
+        else
+            voice->renderNextBlock (buffer, startSample, numSamples);
+    }
+
+    if (! voicesToBatch.empty())
+    {
+        detail::groupVoicesByBatchRenderer (voicesToBatch.data(), (int) voicesToBatch.size(), batchGroupingScratch.data());
+        detail::renderVoiceList (voicesToBatch.data(), (int) voicesToBatch.size(), buffer, startSample, numSamples);
+    }
+}
+
+void Synthesiser::setNumParallelRenderThreads (int numThreads, int maxNumOutputChannels)
+{
+    std::unique_ptr<detail::ParallelVoiceRenderer<SynthesiserVoice>> newRenderer;
+
+    // The worker threads are started and stopped outside the lock, so that the
+    // audio thread isn't held up
+    if (numThreads > 0)
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer<SynthesiserVoice>> (numThreads, maxNumOutputChannels);
+
+    {
+        const ScopedLock sl (lock);
+
+        if (newRenderer != nullptr)
+            newRenderer->prepareForNumVoices (voices.size());
+
+        std::swap (parallelRenderer, newRenderer);
+    }
+}
+
+int Synthesiser::getNumParallelRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumWorkerThreads() : 0;
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -596,4 +658,137 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SynthesiserTests  : public UnitTest
+{
+public:
+    SynthesiserTests()
+        : UnitTest ("Synthesiser", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("Parallel rendering matches serial rendering");
+        {
+            const auto serial = render<float> (0, 2, 2);
+            const auto parallel = render<float> (3, 2, 2);
+
+            expect (getMaxDifference (serial, parallel) < 1.0e-5f);
+            expect (getMaxDifference (render<double> (0, 2, 2), render<double> (3, 2, 2)) < 1.0e-12);
+        }
+
+        beginTest ("Parallel rendering is deterministic");
+        {
+            const auto first = render<float> (3, 2, 2);
+
+            for (int i = 0; i < 5; ++i)
+                expect (exactlyEqual (getMaxDifference (first, render<float> (3, 2, 2)), 0.0f));
+        }
+
+        beginTest ("Buffers with too many channels are rendered serially");
+        {
+            expect (exactlyEqual (getMaxDifference (render<float> (0, 4, 4), render<float> (3, 2, 4)), 0.0f));
+        }
+    }
+
+private:
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            phase = 0.0;
+            increment = MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+            level = velocity * 0.1;
+        }
+
+        void stopNote (float, bool) override            { clearCurrentNote(); }
+        void pitchWheelMoved (int) override             {}
+        void controllerMoved (int, int) override        {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override    { renderInto (buffer, startSample, numSamples); }
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override   { renderInto (buffer, startSample, numSamples); }
+
+        template <typename FloatType>
+        void renderInto (AudioBuffer<FloatType>& buffer, int startSample, int numSamples)
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = startSample; i < startSample + numSamples; ++i)
+            {
+                const auto value = level * std::sin (MathConstants<double>::twoPi * phase);
+                phase += increment;
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.addSample (channel, i, (FloatType) (value * (channel + 1)));
+            }
+        }
+
+        double phase = 0.0, increment = 0.0, level = 0.0;
+    };
+
+    template <typename FloatType>
+    static AudioBuffer<FloatType> render (int numThreads, int maxNumChannels, int numChannels)
+    {
+        constexpr int blockSize = 512, numBlocks = 16;
+
+        Synthesiser synth;
+        synth.setNumParallelRenderThreads (numThreads, maxNumChannels);
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < 64; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        AudioBuffer<FloatType> result (numChannels, blockSize * numBlocks);
+        result.clear();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            MidiBuffer midi;
+
+            for (int note = 0; note < 4; ++note)
+            {
+                const auto noteNumber = 30 + (block * 4 + note) % 60;
+                midi.addEvent (MidiMessage::noteOn (1, noteNumber, 0.8f), note * 100);
+
+                if (block > 4)
+                    midi.addEvent (MidiMessage::noteOff (1, noteNumber - 17), note * 100 + 50);
+            }
+
+            AudioBuffer<FloatType> view (result.getArrayOfWritePointers(), numChannels, block * blockSize, blockSize);
+            synth.renderNextBlock (view, midi, 0, blockSize);
+        }
+
+        return result;
+    }
+
+    template <typename FloatType>
+    static FloatType getMaxDifference (const AudioBuffer<FloatType>& a, const AudioBuffer<FloatType>& b)
+    {
+        FloatType result = 0;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return result;
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
+
 } // namespace juce
@@ -72,6 +72,52 @@ private:
     JUCE_LEAK_DETECTOR (SynthesiserSound)
 };
 
+class SynthesiserVoice;
+
+//==============================================================================
+/**
+    Renders several voices of the same type in a single call.
+
+    Voices are normally rendered one at a time, through a virtual call to
+    SynthesiserVoice::renderNextBlock(). If your voices return a batch renderer from
+    SynthesiserVoice::getBatchRenderer(), the Synthesiser will instead gather up all the
+    active voices that share the same renderer, and pass them to it together. This lets
+    the renderer process the voices side-by-side, e.g. by keeping their state in
+    structure-of-arrays form and processing one voice per SIMD lane.
+
+    @see SynthesiserVoice::getBatchRenderer, dsp::SIMDSynthesiserVoiceRenderer
+
+    @tags{Audio}
+*/
+class JUCE_API  SynthesiserVoiceBatchRenderer
+{
+public:
+    /** Destructor. */
+    virtual ~SynthesiserVoiceBatchRenderer() = default;
+
+    /** Renders the next block of data for a set of voices.
+
+        All of the voices will have returned this object from getBatchRenderer(), and will
+        be active. Their output must be added to the current contents of the buffer, exactly
+        as SynthesiserVoice::renderNextBlock() would do. If any voice finishes playing its
+        note, the renderer must call clearCurrentNote() for that voice.
+
+        When the Synthesiser is rendering voices in parallel, this may be called on several
+        threads at once with different sets of voices and different output buffers.
+    */
+    virtual void renderVoices (SynthesiserVoice* const* voices, int numVoices,
+                               AudioBuffer<float>& outputBuffer, int startSample, int numSamples) = 0;
+
+    /** A double-precision version of renderVoices().
+        By default this just calls SynthesiserVoice::renderNextBlock() on each voice.
+    */
+    virtual void renderVoices (SynthesiserVoice* const* voices, int numVoices,
+                               AudioBuffer<double>& outputBuffer, int startSample, int numSamples);
+
+protected:
+    /** Calls SynthesiserVoice::clearCurrentNote() for a voice that has finished playing. */
+    static void clearCurrentNote (SynthesiserVoice& voice);
+};
 
 //==============================================================================
 /**
@@ -246,6 +292,18 @@ public:
     /** Returns true if this voice started playing its current note before the other voice did. */
     bool wasStartedBefore (const SynthesiserVoice& other) const noexcept;
 
+    /** Can return an object that renders this voice together with other voices of the same type.
+
+        If this returns nullptr (the default), the voice is rendered by calling renderNextBlock().
+        Otherwise, while the voice is active, the Synthesiser will pass it to the renderer along
+        with any other active voices that return the same renderer, and won't call
+        renderNextBlock() for it. The renderer would typically be shared between all voices
+        of a given class, and must outlive them.
+
+        @see SynthesiserVoiceBatchRenderer
+    */
+    virtual SynthesiserVoiceBatchRenderer* getBatchRenderer() const     { return nullptr; }
+
 protected:
     /** Resets the state of this voice after a sound has finished playing.
 
@@ -265,6 +323,7 @@ protected:
 private:
     //==============================================================================
     friend class Synthesiser;
+    friend class SynthesiserVoiceBatchRenderer;
 
     double currentSampleRate = 44100.0;
     int currentlyPlayingNote = -1, currentPlayingMidiChannel = 0;
@@ -278,6 +337,8 @@ private:
 };
 
 
+namespace detail { template <typename VoiceType> class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Base class for a musical device that can play sounds.
@@ -557,6 +618,39 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    /** Allows the voices to be rendered concurrently.
+
+        By default, the voices are rendered one after another on the audio thread. If you
+        supply a number of threads greater than zero here, the synth will create that many
+        high-priority worker threads, which will help the audio thread to render the active
+        voices in each block. The voices are split into groups which are each rendered into
+        a separate buffer, and these buffers are then added to the output in a fixed order,
+        so the output doesn't depend on which thread happened to render each voice.
+
+        When this is enabled, the renderNextBlock() methods of the voices may be called on
+        any of the worker threads, and several voices will be rendered at the same time. So
+        your voices must not modify any state that's shared with other voices without
+        synchronising access to it.
+
+        The maxNumOutputChannels parameter sets the size of the scratch buffers. Blocks with
+        more channels than this will be rendered serially on the audio thread.
+
+        Passing zero disables parallel rendering and destroys the worker threads. This must
+        not be called from the audio thread.
+
+        Note that this only affects the default implementation of renderVoices().
+
+        @see getNumParallelRenderThreads
+    */
+    void setNumParallelRenderThreads (int numThreads, int maxNumOutputChannels = 2);
+
+    /** Returns the number of worker threads used for rendering the voices, or zero if
+        parallel rendering is disabled.
+
+        @see setNumParallelRenderThreads
+    */
+    int getNumParallelRenderThreads() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -629,6 +723,11 @@ private:
     BigInteger sustainPedalsDown;
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
+    std::vector<SynthesiserVoice*> voicesToBatch, batchGroupingScratch;
+    std::unique_ptr<detail::ParallelVoiceRenderer<SynthesiserVoice>> parallelRenderer;
+
+    template <typename floatType>
+    void renderVoicesSerially (AudioBuffer<floatType>&, int startSample, int numSamples);
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    static constexpr int maxNumPhases = 1024;
+
+    // Returns the ratio as L / M, or { 0, 0 } if it can't be expressed exactly with L <= maxNumPhases
+    static std::pair<int, int> findExactRatio (double inputRate, double outputRate)
+    {
+        if (exactlyEqual (inputRate, std::floor (inputRate)) && exactlyEqual (outputRate, std::floor (outputRate))
+             && inputRate < std::numeric_limits<int>::max() && outputRate < std::numeric_limits<int>::max())
+        {
+            auto divisor = std::gcd ((int) inputRate, (int) outputRate);
+            auto up = (int) outputRate / divisor;
+
+            return up <= maxNumPhases ? std::pair<int, int> { up, (int) inputRate / divisor }
+                                      : std::pair<int, int> {};
+        }
+
+        // For fractional rates, look for a continued-fraction convergent of M / L that's exact
+        auto target = inputRate / outputRate;
+        int64 num1 = 1, num2 = 0, den1 = 0, den2 = 1;
+        auto x = target;
+
+        for (int i = 0; i < 64; ++i)
+        {
+            auto a = (int64) std::floor (x);
+            auto num = a * num1 + num2;
+            auto den = a * den1 + den2;
+
+            if (den > maxNumPhases || num > std::numeric_limits<int>::max())
+                break;
+
+            if (num > 0 && std::abs ((double) num / (double) den - target) <= target * 1.0e-12)
+                return { (int) den, (int) num };
+
+            num2 = std::exchange (num1, num);
+            den2 = std::exchange (den1, den);
+
+            auto fraction = x - (double) a;
+
+            if (fraction < 1.0e-12)
+                break;
+
+            x = 1.0 / fraction;
+        }
+
+        return {};
+    }
+
+    static double besselI0 (double x) noexcept
+    {
+        double sum = 1.0, term = 1.0;
+
+        for (int k = 1; k < 100; ++k)
+        {
+            term *= (x * x) / (4.0 * k * k);
+            sum += term;
+
+            if (term < sum * 1.0e-15)
+                break;
+        }
+
+        return sum;
+    }
+}
+
+//==============================================================================
+void PolyphaseResampler::prepare (double inputSampleRate, double outputSampleRate, int numChannels, Quality quality)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    jassert (inputSampleRate > 0 && outputSampleRate > 0 && numChannels > 0);
+
+    const auto exactRatio = findExactRatio (inputSampleRate, outputSampleRate);
+
+    if (exactRatio.first > 0)
+    {
+        numPhases = exactRatio.first;
+        stepPhases = exactRatio.second;
+        stepFraction = 0;
+    }
+    else
+    {
+        numPhases = maxNumPhases;
+        auto step = inputSampleRate / outputSampleRate * numPhases;
+        stepPhases = (int64) std::floor (step);
+        auto fraction = (int64) std::llround ((step - (double) stepPhases) * (1 << fractionBits));
+
+        stepPhases += fraction >> fractionBits;
+        stepFraction = (uint32) (fraction & ((1 << fractionBits) - 1));
+    }
+
+    const int baseNumTaps[]        = { 32, 64, 128, 256 };
+    const double attenuationsDb[]  = { 60.0, 80.0, 100.0, 120.0 };
+    const auto qualityIndex = jlimit (0, 3, (int) quality);
+
+    // When downsampling, the filter has to cut off below the output's Nyquist frequency,
+    // so it needs more input taps to get the same transition band
+    auto decimation = jmax (1.0, inputSampleRate / outputSampleRate);
+    numTaps = ((int) std::ceil (baseNumTaps[qualityIndex] * decimation) + 7) & ~7;
+
+    // Kaiser's formulas, with the transition band ending at the lower of the two Nyquist frequencies.
+    // All the frequencies here are in cycles per input sample.
+    auto attenuation = attenuationsDb[qualityIndex];
+    auto transitionWidth = (attenuation - 7.95) / (14.36 * numTaps);
+    auto cutoff = 0.5 / decimation - transitionWidth * 0.5;
+    auto beta = 0.1102 * (attenuation - 8.7);
+
+    auto length = numTaps * numPhases;
+    auto centre = (length - 1) * 0.5;
+    auto windowScale = 1.0 / besselI0 (beta);
+
+    // There's one extra phase at the end, which is the first phase delayed by one sample.
+    // It's only used when interpolating between the last phase and the next sample's first one.
+    filterBank.assign ((size_t) (numTaps * (numPhases + 1)), 0.0f);
+    std::vector<double> taps ((size_t) numTaps);
+
+    for (int p = 0; p <= numPhases; ++p)
+    {
+        // The taps are stored in reverse, so that each output is a dot-product with
+        // the input samples in the order they arrived
+        auto* coeffs = filterBank.data() + p * numTaps;
+        double sum = 0.0;
+
+        for (int i = 0; i < numTaps; ++i)
+        {
+            auto k = p + (numTaps - 1 - i) * numPhases;
+            auto t = (k - centre) / numPhases;
+            auto x = 2.0 * cutoff * t;
+            auto sinc = std::abs (x) < 1.0e-12 ? 1.0 : std::sin (MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+            auto w = (k - centre) / (length * 0.5);
+            auto window = besselI0 (beta * std::sqrt (jmax (0.0, 1.0 - w * w))) * windowScale;
+
+            taps[(size_t) i] = 2.0 * cutoff * sinc * window;
+            sum += taps[(size_t) i];
+        }
+
+        // normalising each phase keeps the DC gain exactly at unity
+        for (int i = 0; i < numTaps; ++i)
+            coeffs[i] = (float) (taps[(size_t) i] / sum);
+    }
+
+    auto maxStep = (int) (stepPhases / numPhases) + 1;
+    history.setSize (numChannels, numTaps + maxStep + 2048);
+    reset();
+}
+
+void PolyphaseResampler::reset() noexcept
+{
+    history.clear();
+    phase = 0;
+    phaseFraction = 0;
+    readPos = 0;
+    numBuffered = jmax (0, numTaps - 1);
+}
+
+double PolyphaseResampler::getRatio() const noexcept
+{
+    return ((double) stepPhases + stepFraction / (double) (1 << fractionBits)) / numPhases;
+}
+
+double PolyphaseResampler::getLatencyInInputSamples() const noexcept
+{
+    return (numTaps * numPhases - 1) / (2.0 * numPhases);
+}
+
+int64 PolyphaseResampler::getPhasePositionOfOutput (int64 outputIndex) const noexcept
+{
+    return phase + outputIndex * stepPhases + (((int64) phaseFraction + outputIndex * (int64) stepFraction) >> fractionBits);
+}
+
+int PolyphaseResampler::getNumInputSamplesNeeded (int numOutputSamples) const noexcept
+{
+    if (numOutputSamples <= 0)
+        return 0;
+
+    auto lastReadPos = readPos + getPhasePositionOfOutput (numOutputSamples - 1) / numPhases;
+    return (int) jmax ((int64) 0, lastReadPos + numTaps - numBuffered);
+}
+
+int PolyphaseResampler::getMaxNumOutputSamples (int numInputSamples) const noexcept
+{
+    auto spare = (int64) numBuffered + numInputSamples - numTaps - readPos;
+
+    if (spare < 0)
+        return 0;
+
+    // find the last output whose window would end within the available input
+    auto lastPhasePosition = spare * numPhases + numPhases - 1;
+    auto step = (double) stepPhases + stepFraction / (double) (1 << fractionBits);
+    int64 low = 0, high = jmin ((int64) std::numeric_limits<int>::max() - 1, (int64) ((double) lastPhasePosition / step) + 2);
+
+    while (low < high)
+    {
+        auto mid = (low + high + 1) / 2;
+
+        if (getPhasePositionOfOutput (mid) <= lastPhasePosition)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    return (int) (low + 1);
+}
+
+void PolyphaseResampler::discardUsedHistory() noexcept
+{
+    auto numToDiscard = jmin (readPos, numBuffered);
+
+    if (numToDiscard > 0)
+    {
+        for (int ch = 0; ch < history.getNumChannels(); ++ch)
+        {
+            auto* data = history.getWritePointer (ch);
+            std::memmove (data, data + numToDiscard, (size_t) (numBuffered - numToDiscard) * sizeof (float));
+        }
+
+        readPos -= numToDiscard;
+        numBuffered -= numToDiscard;
+    }
+}
+
+template <bool interpolatePhases>
+void PolyphaseResampler::render (float* const* output, int outputOffset, int numOutputSamples) noexcept
+{
+    constexpr auto fractionMask = (uint32) ((1 << fractionBits) - 1);
+    constexpr auto fractionScale = 1.0f / (float) (1 << fractionBits);
+
+    int endPhase = 0, endReadPos = 0;
+    uint32 endFraction = 0;
+
+    for (int ch = 0; ch < history.getNumChannels(); ++ch)
+    {
+        auto* src = history.getReadPointer (ch);
+        auto* dest = output[ch] + outputOffset;
+        auto p = phase, pos = readPos;
+        auto fraction = phaseFraction;
+
+        for (int i = 0; i < numOutputSamples; ++i)
+        {
+            auto* coeffs = filterBank.data() + p * numTaps;
+            auto sample = FloatVectorOperations::dotProduct (coeffs, src + pos, numTaps);
+
+            if constexpr (interpolatePhases)
+            {
+                if (fraction != 0)
+                {
+                    auto next = FloatVectorOperations::dotProduct (coeffs + numTaps, src + pos, numTaps);
+                    sample += (next - sample) * ((float) fraction * fractionScale);
+                }
+
+                fraction += stepFraction;
+                p += (int) stepPhases + (int) (fraction >> fractionBits);
+                fraction &= fractionMask;
+            }
+            else
+            {
+                p += (int) stepPhases;
+            }
+
+            dest[i] = sample;
+            pos += p / numPhases;
+            p %= numPhases;
+        }
+
+        endPhase = p;
+        endReadPos = pos;
+        endFraction = fraction;
+    }
+
+    phase = endPhase;
+    readPos = endReadPos;
+    phaseFraction = endFraction;
+}
+
+PolyphaseResampler::ProcessResult PolyphaseResampler::process (const float* const* input, int numInputSamples,
+                                                               float* const* output, int maxNumOutputSamples) noexcept
+{
+    jassert (numTaps > 0); // you need to call prepare() first!
+
+    ProcessResult result;
+    const auto numChannels = history.getNumChannels();
+
+    for (;;)
+    {
+        auto numToProduce = jmin (maxNumOutputSamples - result.numOutputSamplesProduced, getMaxNumOutputSamples (0));
+
+        if (numToProduce > 0)
+        {
+            if (isRatioExact())
+                render<false> (output, result.numOutputSamplesProduced, numToProduce);
+            else
+                render<true> (output, result.numOutputSamplesProduced, numToProduce);
+
+            result.numOutputSamplesProduced += numToProduce;
+        }
+
+        if (result.numOutputSamplesProduced >= maxNumOutputSamples || result.numInputSamplesUsed >= numInputSamples)
+            break;
+
+        discardUsedHistory();
+
+        auto numToCopy = jmin (numInputSamples - result.numInputSamplesUsed, history.getNumSamples() - numBuffered);
+        jassert (numToCopy > 0);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            history.copyFrom (ch, numBuffered, input[ch] + result.numInputSamplesUsed, numToCopy);
+
+        numBuffered += numToCopy;
+        result.numInputSamplesUsed += numToCopy;
+    }
+
+    return result;
+}
+
+} // namespace juce
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high-quality sample-rate converter, which uses a bank of polyphase FIR filters.
+
+    When it's prepared, this expresses the ratio between the output and input rates as
+    a fraction L / M, and designs a windowed-sinc low-pass filter that's split into L
+    phases. Each output sample is then a single dot-product of one phase's coefficients
+    with the most recent input samples, which is done with FloatVectorOperations::dotProduct(),
+    so it runs on the widest vector instructions that the CPU supports.
+
+    Ratios between common sample rates, like 44100 / 48000 = 160 / 147, are handled exactly.
+    If the ratio can't be expressed as a fraction with no more than 1024 phases, the
+    resampler uses 1024 phases and interpolates between the outputs of the two nearest
+    ones, which costs twice as much per sample.
+
+    This is much more accurate than ResamplingAudioSource or the Interpolators, but it
+    costs more memory, and changing the rates means redesigning the filters, so it
+    isn't suitable for ratios that change continuously.
+
+    The resampler is a streaming processor: you can call process() with any number of
+    input samples, and it'll keep whatever it can't use yet for the next call.
+
+    @see PolyphaseResamplingAudioSource, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The trade-offs between quality and speed that the resampler offers.
+
+        Each step up doubles the length of the filters, and gives a wider passband and
+        more attenuation of aliases. The tap counts are for upsampling; when downsampling
+        the filters get proportionally longer.
+    */
+    enum class Quality
+    {
+        draft,      /**< 32 taps, aliases attenuated by about 60dB. */
+        normal,     /**< 64 taps, aliases attenuated by about 80dB. */
+        high,       /**< 128 taps, aliases attenuated by about 100dB. */
+        best        /**< 256 taps, aliases attenuated by about 120dB. */
+    };
+
+    //==============================================================================
+    /** Creates an unprepared resampler. You need to call prepare() before using it. */
+    PolyphaseResampler() = default;
+
+    /** Designs the filters for a pair of sample rates, and resets the resampler.
+
+        This allocates memory, so don't call it on the audio thread.
+    */
+    void prepare (double inputSampleRate, double outputSampleRate, int numChannels, Quality quality = Quality::high);
+
+    /** Clears the resampler's history, so that it's ready for a new stream. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Returns the number of phases L in the filter bank. */
+    int getNumPhases() const noexcept                   { return numPhases; }
+
+    /** Returns true if the ratio is an exact fraction, so that the phases don't
+        need to be interpolated.
+    */
+    bool isRatioExact() const noexcept                  { return stepFraction == 0; }
+
+    /** Returns the number of input samples per output sample that's actually being used.
+        This may differ very slightly from the ratio of the rates passed to prepare().
+    */
+    double getRatio() const noexcept;
+
+    /** Returns the number of input samples that each output sample is calculated from. */
+    int getNumTaps() const noexcept                     { return numTaps; }
+
+    /** Returns the delay introduced by the filters, measured in input samples. */
+    double getLatencyInInputSamples() const noexcept;
+
+    /** Returns the number of input samples that must be passed to process() before it can
+        produce the given number of output samples.
+    */
+    int getNumInputSamplesNeeded (int numOutputSamples) const noexcept;
+
+    /** Returns the largest number of output samples that the given number of input samples
+        might produce.
+    */
+    int getMaxNumOutputSamples (int numInputSamples) const noexcept;
+
+    //==============================================================================
+    /** The numbers of samples used and produced by a call to process(). */
+    struct ProcessResult
+    {
+        int numInputSamplesUsed = 0;
+        int numOutputSamplesProduced = 0;
+    };
+
+    /** Converts a block of samples.
+
+        This reads up to numInputSamples samples from each channel of the input, and writes
+        up to maxNumOutputSamples samples to each channel of the output. It stops when it
+        runs out of input or out of space in the output, and any input that it hasn't used
+        must be passed to the next call.
+
+        If the output has at least getMaxNumOutputSamples (numInputSamples) samples of space,
+        all the input will always be used.
+    */
+    ProcessResult process (const float* const* input, int numInputSamples,
+                           float* const* output, int maxNumOutputSamples) noexcept;
+
+private:
+    //==============================================================================
+    // Positions are measured in phases (1 / L of an input sample), plus a fraction
+    // of a phase with this many bits, which is always zero when the ratio is exact
+    static constexpr int fractionBits = 24;
+
+    int64 getPhasePositionOfOutput (int64 outputIndex) const noexcept;
+    void discardUsedHistory() noexcept;
+
+    template <bool interpolatePhases>
+    void render (float* const* output, int outputOffset, int numOutputSamples) noexcept;
+
+    std::vector<float> filterBank;
+    AudioBuffer<float> history;
+    int numPhases = 1, numTaps = 0;
+    int64 stepPhases = 1;
+    uint32 stepFraction = 0;
+    int phase = 0, readPos = 0, numBuffered = 0;
+    uint32 phaseFraction = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
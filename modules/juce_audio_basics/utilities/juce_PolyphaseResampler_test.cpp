@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct PolyphaseResamplerTests  : public UnitTest
+{
+    PolyphaseResamplerTests()  : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Rational ratios");
+        {
+            PolyphaseResampler resampler;
+
+            resampler.prepare (44100.0, 48000.0, 1);
+            expect (resampler.isRatioExact());
+            expectEquals (resampler.getNumPhases(), 160);
+            expectEquals (resampler.getRatio(), 147.0 / 160.0);
+
+            resampler.prepare (96000.0, 48000.0, 1);
+            expect (resampler.isRatioExact());
+            expectEquals (resampler.getNumPhases(), 1);
+            expectEquals (resampler.getRatio(), 2.0);
+
+            resampler.prepare (44100.0 * 1.00037, 44100.0, 1);
+            expect (! resampler.isRatioExact());
+            expectWithinAbsoluteError (resampler.getRatio(), 1.00037, 1.0e-9);
+        }
+
+        beginTest ("Upsampling reproduces a sine wave");
+        {
+            for (auto quality : { PolyphaseResampler::Quality::normal, PolyphaseResampler::Quality::high, PolyphaseResampler::Quality::best })
+            {
+                PolyphaseResampler resampler;
+                resampler.prepare (44100.0, 48000.0, 2, quality);
+
+                const auto input = createSine (2, 44100, 1000.0 / 44100.0);
+                const auto output = processInOneGo (resampler, input);
+
+                expectEquals (output.getNumSamples(), 48000);
+
+                const auto ratio = resampler.getRatio();
+                const auto latency = resampler.getLatencyInInputSamples();
+                float maxError = 0.0f;
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    for (int i = 1000; i < output.getNumSamples() - 1000; ++i)
+                    {
+                        auto expected = getSine (ch, i * ratio - latency, 1000.0 / 44100.0);
+                        maxError = jmax (maxError, std::abs (output.getSample (ch, i) - expected));
+                    }
+                }
+
+                expectLessThan (maxError, quality == PolyphaseResampler::Quality::normal ? 1.0e-3f : 1.0e-4f);
+            }
+        }
+
+        beginTest ("Inexact ratios reproduce a sine wave");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (44100.0 * 1.00037, 44100.0, 1, PolyphaseResampler::Quality::high);
+
+            const auto output = processInOneGo (resampler, createSine (1, 44100, 1000.0 / 44100.0));
+            const auto latency = resampler.getLatencyInInputSamples();
+            float maxError = 0.0f;
+
+            for (int i = 1000; i < output.getNumSamples() - 1000; ++i)
+                maxError = jmax (maxError, std::abs (output.getSample (0, i) - getSine (0, i * resampler.getRatio() - latency, 1000.0 / 44100.0)));
+
+            expectLessThan (maxError, 1.0e-4f);
+        }
+
+        beginTest ("Downsampling removes frequencies above the new Nyquist");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (96000.0, 44100.0, 1, PolyphaseResampler::Quality::high);
+
+            const auto output = processInOneGo (resampler, createSine (1, 96000, 30000.0 / 96000.0));
+            auto rms = output.getRMSLevel (0, 2000, output.getNumSamples() - 4000);
+
+            expectLessThan (rms, 1.0e-4f);
+        }
+
+        beginTest ("Streaming in small pieces matches processing in one go");
+        {
+            auto random = getRandom();
+
+            for (auto rates : { std::pair<double, double> { 44100.0, 48000.0 }, { 48000.0, 44100.0 }, { 96000.0, 22050.0 }, { 44100.0 * 1.0123, 44100.0 } })
+            {
+                PolyphaseResampler resampler;
+                resampler.prepare (rates.first, rates.second, 2, PolyphaseResampler::Quality::draft);
+
+                const auto input = createSine (2, 20000, 0.01);
+                const auto expected = processInOneGo (resampler, input);
+
+                resampler.reset();
+                AudioBuffer<float> output (2, expected.getNumSamples());
+                int inputPos = 0, outputPos = 0;
+
+                while (inputPos < input.getNumSamples() && outputPos < output.getNumSamples())
+                {
+                    auto numIn = jmin (random.nextInt (300) + 1, input.getNumSamples() - inputPos);
+                    auto maxOut = jmin (random.nextInt (300), output.getNumSamples() - outputPos);
+
+                    const float* in[] = { input.getReadPointer (0, inputPos), input.getReadPointer (1, inputPos) };
+                    float* out[] = { output.getWritePointer (0, outputPos), output.getWritePointer (1, outputPos) };
+
+                    auto result = resampler.process (in, numIn, out, maxOut);
+                    expect (result.numOutputSamplesProduced <= maxOut);
+                    inputPos += result.numInputSamplesUsed;
+                    outputPos += result.numOutputSamplesProduced;
+                }
+
+                while (outputPos < output.getNumSamples())
+                {
+                    float* out[] = { output.getWritePointer (0, outputPos), output.getWritePointer (1, outputPos) };
+                    outputPos += resampler.process (nullptr, 0, out, output.getNumSamples() - outputPos).numOutputSamplesProduced;
+                }
+
+                expect (output == expected);
+            }
+        }
+
+        beginTest ("Input requirements are exact");
+        {
+            PolyphaseResampler resampler;
+            resampler.prepare (48000.0, 44100.0, 1, PolyphaseResampler::Quality::normal);
+
+            AudioBuffer<float> input (1, 1000), output (1, 1000);
+            input.clear();
+
+            for (auto numOut : { 1, 7, 100, 512, 3, 999 })
+            {
+                auto numIn = resampler.getNumInputSamplesNeeded (numOut);
+                expectEquals (resampler.getMaxNumOutputSamples (numIn), numOut);
+
+                auto result = resampler.process (input.getArrayOfReadPointers(), numIn, output.getArrayOfWritePointers(), numOut);
+                expectEquals (result.numInputSamplesUsed, numIn);
+                expectEquals (result.numOutputSamplesProduced, numOut);
+                expectEquals (resampler.getMaxNumOutputSamples (0), 0);
+            }
+        }
+
+        beginTest ("PolyphaseResamplingAudioSource");
+        {
+            auto input = createSine (2, 30000, 0.02);
+
+            PolyphaseResampler resampler;
+            resampler.prepare (48000.0, 44100.0, 2, PolyphaseResampler::Quality::normal);
+            const auto expected = processInOneGo (resampler, input);
+
+            PolyphaseResamplingAudioSource source (new MemoryAudioSource (input, true), true, 2, PolyphaseResampler::Quality::normal);
+            source.setResamplingRatio (48000.0 / 44100.0);
+            source.prepareToPlay (256, 44100.0);
+
+            AudioBuffer<float> output (2, expected.getNumSamples());
+            const int blockSize = 256;
+
+            for (int pos = 0; pos + blockSize <= output.getNumSamples(); pos += blockSize)
+                source.getNextAudioBlock (AudioSourceChannelInfo (&output, pos, blockSize));
+
+            const auto numChecked = (output.getNumSamples() / blockSize) * blockSize;
+            bool matches = true;
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < numChecked; ++i)
+                    matches = matches && exactlyEqual (output.getSample (ch, i), expected.getSample (ch, i));
+
+            expect (matches);
+        }
+    }
+
+    static float getSine (int channel, double position, double cyclesPerSample)
+    {
+        return (float) (0.5 * std::sin (MathConstants<double>::twoPi * cyclesPerSample * position + channel));
+    }
+
+    static AudioBuffer<float> createSine (int numChannels, int numSamples, double cyclesPerSample)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, getSine (ch, i, cyclesPerSample));
+
+        return buffer;
+    }
+
+    static AudioBuffer<float> processInOneGo (PolyphaseResampler& resampler, const AudioBuffer<float>& input)
+    {
+        AudioBuffer<float> output (input.getNumChannels(), resampler.getMaxNumOutputSamples (input.getNumSamples()));
+
+        auto result = resampler.process (input.getArrayOfReadPointers(), input.getNumSamples(),
+                                         output.getArrayOfWritePointers(), output.getNumSamples());
+
+        jassert (result.numInputSamplesUsed == input.getNumSamples());
+        output.setSize (output.getNumChannels(), result.numOutputSamplesProduced, true);
+        return output;
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+} // namespace juce
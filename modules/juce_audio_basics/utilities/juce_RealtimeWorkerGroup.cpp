@@ -0,0 +1,266 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class RealtimeWorkerGroup::Worker  : public Thread
+{
+public:
+    Worker (RealtimeWorkerGroup& o, int index)
+        : Thread ("Realtime worker " + String (index)),
+          owner (o),
+          threadIndex (index)
+    {
+        if (! startRealtimeThread (RealtimeOptions{}.withPriority (8)))
+            startThread (Priority::highest);
+    }
+
+    ~Worker() override
+    {
+        stopThread (-1);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (-1);
+
+            if (threadShouldExit())
+                break;
+
+            // The increment must be visible before the job is read, so that perform() can't
+            // return while we're still working on the job that it handed out.
+            owner.numActiveWorkers.fetch_add (1);
+
+            if (auto* job = owner.currentJob.load())
+            {
+                const auto fpStatus = owner.callerFpStatus.load (std::memory_order_relaxed);
+
+                if (fpStatus != currentFpStatus)
+                {
+                    setFpStatus (fpStatus);
+                    currentFpStatus = fpStatus;
+                }
+
+                job->run (threadIndex);
+            }
+
+            owner.numActiveWorkers.fetch_sub (1);
+        }
+    }
+
+private:
+    RealtimeWorkerGroup& owner;
+    const int threadIndex;
+    intptr_t currentFpStatus = getFpStatus();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+RealtimeWorkerGroup::RealtimeWorkerGroup (int numWorkerThreads)
+{
+    jassert (numWorkerThreads >= 0);
+
+    for (int i = 0; i < numWorkerThreads; ++i)
+        workers.push_back (std::make_unique<Worker> (*this, i + 1));
+}
+
+RealtimeWorkerGroup::~RealtimeWorkerGroup()
+{
+    for (auto& w : workers)
+        w->signalThreadShouldExit();
+
+    workers.clear();
+}
+
+void RealtimeWorkerGroup::perform (Job& job) noexcept
+{
+    // Only one thread may be using the group at once!
+    jassert (currentJob.load() == nullptr);
+
+    // This is published by storing the job, which the workers read before this value
+    callerFpStatus.store (getFpStatus(), std::memory_order_relaxed);
+    currentJob.store (&job);
+
+    for (auto& w : workers)
+        w->notify();
+
+    job.run (0);
+
+    currentJob.store (nullptr);
+
+    // Any worker that's still registered as active might be reading the job, so wait for them.
+    while (numActiveWorkers.load() > 0)
+        Thread::yield();
+}
+
+intptr_t RealtimeWorkerGroup::getFpStatus() noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON || (JUCE_64BIT && JUCE_ARM))
+    return FloatVectorOperations::getFpStatusRegister();
+   #else
+    return 0;
+   #endif
+}
+
+void RealtimeWorkerGroup::setFpStatus ([[maybe_unused]] intptr_t status) noexcept
+{
+   #if JUCE_USE_SSE_INTRINSICS || (JUCE_USE_ARM_NEON || (JUCE_64BIT && JUCE_ARM))
+    FloatVectorOperations::setFpStatusRegister (status);
+   #endif
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeWorkerGroupTests  : public UnitTest
+{
+public:
+    RealtimeWorkerGroupTests()
+        : UnitTest ("RealtimeWorkerGroup", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        beginTest ("All work items are processed exactly once");
+        {
+            RealtimeWorkerGroup group (3);
+
+            struct CountingJob  : public RealtimeWorkerGroup::Job
+            {
+                void run (int threadIndex) override
+                {
+                    jassert (isPositiveAndBelow (threadIndex, 4));
+                    ignoreUnused (threadIndex);
+
+                    for (;;)
+                    {
+                        const auto index = next.fetch_add (1);
+
+                        if (index >= (int) counts.size())
+                            return;
+
+                        counts[(size_t) index].fetch_add (1);
+                    }
+                }
+
+                std::array<std::atomic<int>, 1000> counts {};
+                std::atomic<int> next { 0 };
+            };
+
+            for (int block = 0; block < 50; ++block)
+            {
+                CountingJob job;
+                group.perform (job);
+
+                expect (std::all_of (job.counts.begin(), job.counts.end(), [] (auto& c) { return c.load() == 1; }));
+            }
+        }
+
+        beginTest ("A group with no workers runs the job on the calling thread");
+        {
+            RealtimeWorkerGroup group (0);
+            expectEquals (group.getMaxNumThreadIndices(), 1);
+
+            struct Job  : public RealtimeWorkerGroup::Job
+            {
+                void run (int threadIndex) override  { indexUsed = threadIndex; ++numCalls; }
+                int indexUsed = -1, numCalls = 0;
+            };
+
+            Job job;
+            group.perform (job);
+
+            expectEquals (job.indexUsed, 0);
+            expectEquals (job.numCalls, 1);
+        }
+
+        beginTest ("Workers use the caller's floating-point mode");
+        {
+            RealtimeWorkerGroup group (3);
+
+            // Each thread that joins in halves a value that's about to become denormal,
+            // which gives zero if denormals are disabled
+            struct DenormalJob  : public RealtimeWorkerGroup::Job
+            {
+                void run (int threadIndex) override
+                {
+                    volatile float value = std::numeric_limits<float>::min();
+                    results[(size_t) threadIndex] = value * 0.5f;
+
+                    // Give the workers a chance to join in before the job finishes
+                    if (threadIndex == 0)
+                        Thread::sleep (1);
+                }
+
+                std::array<float, 4> results { -1.0f, -1.0f, -1.0f, -1.0f };
+            };
+
+            for (auto disableDenormals : { true, false })
+            {
+                const auto runJob = [&]
+                {
+                    DenormalJob job;
+
+                    if (disableDenormals)
+                    {
+                        const ScopedNoDenormals noDenormals;
+                        group.perform (job);
+                    }
+                    else
+                    {
+                        group.perform (job);
+                    }
+
+                    return job.results;
+                };
+
+                int numWorkerResults = 0;
+
+                for (int attempt = 0; attempt < 20; ++attempt)
+                {
+                    const auto results = runJob();
+
+                    for (size_t i = 1; i < results.size(); ++i)
+                    {
+                        if (results[i] >= 0.0f)
+                        {
+                            ++numWorkerResults;
+                            expect (exactlyEqual (results[i], results[0]));
+                        }
+                    }
+                }
+
+                expect (numWorkerResults > 0);
+            }
+        }
+    }
+};
+
+static RealtimeWorkerGroupTests realtimeWorkerGroupTests;
+
+#endif
+
+} // namespace juce
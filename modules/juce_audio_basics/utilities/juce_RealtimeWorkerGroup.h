@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A small, fixed set of high-priority threads that can help the audio thread
+    get through a block of work.
+
+    The threads are created once, up front, and then sleep until perform() is
+    called. perform() wakes the workers, runs the job on the calling thread too,
+    and only returns once every thread that joined in has finished with the job.
+
+    Because a worker may wake up too late to be useful, jobs should share their
+    work out dynamically (e.g. by having each thread repeatedly claim the next
+    item from an atomic counter) rather than assigning a fixed slice to each
+    thread index. That way the calling thread will get through everything on its
+    own if none of the workers turn up.
+
+    perform() doesn't allocate or take any locks, other than the short one needed
+    to wake a sleeping thread, so it's suitable for use in an audio callback.
+
+    The workers run each job with the same floating-point mode as the thread that
+    called perform(), so if that thread has denormals disabled (e.g. with a
+    ScopedNoDenormals), they'll be disabled for the whole job.
+
+    @tags{Audio}
+*/
+class JUCE_API  RealtimeWorkerGroup
+{
+public:
+    //==============================================================================
+    /** A piece of work that will be run concurrently on all of the threads in the group. */
+    struct JUCE_API  Job
+    {
+        /** Destructor. */
+        virtual ~Job() = default;
+
+        /** Called once on each participating thread.
+
+            The calling thread of perform() always uses index 0, and the worker threads
+            use indices 1 to getNumWorkerThreads(), so the index can be used to select
+            per-thread scratch storage.
+        */
+        virtual void run (int threadIndex) = 0;
+    };
+
+    //==============================================================================
+    /** Creates a group with the given number of worker threads.
+
+        The workers are started as realtime threads where the platform allows it, or
+        with the highest normal priority otherwise.
+    */
+    explicit RealtimeWorkerGroup (int numWorkerThreads);
+
+    /** Destructor. This will stop all the worker threads. */
+    ~RealtimeWorkerGroup();
+
+    //==============================================================================
+    /** Returns the number of worker threads, not including the thread that calls perform(). */
+    int getNumWorkerThreads() const noexcept            { return (int) workers.size(); }
+
+    /** Returns the number of distinct thread indices that might be passed to Job::run(). */
+    int getMaxNumThreadIndices() const noexcept         { return getNumWorkerThreads() + 1; }
+
+    /** Runs a job on the calling thread and all available worker threads, returning once
+        every thread that picked it up has finished.
+
+        Only one thread at a time may call this method.
+    */
+    void perform (Job& job) noexcept;
+
+private:
+    //==============================================================================
+    class Worker;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<Job*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 };
+    std::atomic<intptr_t> callerFpStatus { 0 };
+
+    static intptr_t getFpStatus() noexcept;
+    static void setFpStatus (intptr_t) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeWorkerGroup)
+};
+
+} // namespace juce
@@ -182,11 +182,66 @@ static const char* const flacFormatName = "FLAC file";
 template <typename Item>
 auto emptyRange (Item item) { return Range<Item>::emptyRange (item); }
 
+//==============================================================================
+/*  Remembers where some of the frames in a FLAC stream begin, so that a reader can jump
+    straight to a nearby frame rather than getting libFLAC to search the file for it.
+    Points are added as frames get decoded, and an index may be shared by all the readers
+    that are open on the same file.
+*/
+class FlacSeekIndex
+{
+public:
+    struct Point
+    {
+        int64 sample;
+        uint64 byteOffset;
+    };
+
+    void addPoint (Point point)
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        auto next = std::lower_bound (points.begin(), points.end(), point.sample,
+                                      [] (const Point& p, int64 sample) { return p.sample < sample; });
+
+        if ((next != points.end() && next->sample - point.sample < minPointSpacing)
+             || (next != points.begin() && point.sample - std::prev (next)->sample < minPointSpacing))
+            return;
+
+        points.insert (next, point);
+    }
+
+    std::optional<Point> findPointBefore (int64 sample) const
+    {
+        const SpinLock::ScopedLockType sl (lock);
+
+        auto next = std::upper_bound (points.begin(), points.end(), sample,
+                                      [] (int64 s, const Point& p) { return s < p.sample; });
+
+        if (next == points.begin())
+            return {};
+
+        return *std::prev (next);
+    }
+
+    int64 getLengthInSamples() const noexcept               { return lengthInSamples; }
+    void setLengthInSamples (int64 newLength) noexcept      { lengthInSamples = newLength; }
+
+private:
+    static constexpr int64 minPointSpacing = 8192;
+
+    mutable SpinLock lock;
+    std::vector<Point> points;
+    std::atomic<int64> lengthInSamples { 0 };
+};
+
 //==============================================================================
 class FlacReader  : public AudioFormatReader
 {
 public:
-    FlacReader (InputStream* in)  : AudioFormatReader (in, flacFormatName)
+    FlacReader (InputStream* in, std::shared_ptr<FlacSeekIndex> indexToUse = std::make_shared<FlacSeekIndex>())
+        : AudioFormatReader (in, flacFormatName),
+          seekIndex (std::move (indexToUse))
     {
         lengthInSamples = 0;
         decoder = FlacNamespace::FLAC__stream_decoder_new();
@@ -200,18 +255,32 @@ public:
         {
             FLAC__stream_decoder_process_until_end_of_metadata (decoder);
 
+            FlacNamespace::FLAC__uint64 firstFramePosition = 0;
+
+            if (FLAC__stream_decoder_get_decode_position (decoder, &firstFramePosition))
+                seekIndex->addPoint ({ 0, firstFramePosition });
+
             if (lengthInSamples == 0 && sampleRate > 0)
             {
-                // the length hasn't been stored in the metadata, so we'll need to
-                // work it out the length the hard way, by scanning the whole file..
-                scanningForLength = true;
-                FLAC__stream_decoder_process_until_end_of_stream (decoder);
-                scanningForLength = false;
-                auto tempLength = lengthInSamples;
-
-                FLAC__stream_decoder_reset (decoder);
-                FLAC__stream_decoder_process_until_end_of_metadata (decoder);
-                lengthInSamples = tempLength;
+                if (seekIndex->getLengthInSamples() > 0)
+                {
+                    // another reader has already scanned this file
+                    lengthInSamples = seekIndex->getLengthInSamples();
+                }
+                else
+                {
+                    // the length hasn't been stored in the metadata, so we'll need to
+                    // work it out the length the hard way, by scanning the whole file..
+                    scanningForLength = true;
+                    FLAC__stream_decoder_process_until_end_of_stream (decoder);
+                    scanningForLength = false;
+                    auto tempLength = lengthInSamples;
+
+                    FLAC__stream_decoder_reset (decoder);
+                    FLAC__stream_decoder_process_until_end_of_metadata (decoder);
+                    lengthInSamples = tempLength;
+                    seekIndex->setLengthInSamples (lengthInSamples);
+                }
             }
         }
     }
@@ -231,6 +300,17 @@ public:
         reservoir.setSize ((int) numChannels, 2 * (int) info.max_blocksize, false, false, true);
     }
 
+    /*  Stops the reservoir from being reallocated while decoding. A frame that's longer
+        than the stream info said any frame would be is then treated as corrupt.
+    */
+    void useFixedSizeReservoir()
+    {
+        if (reservoir.getNumSamples() == 0)
+            reservoir.setSize ((int) numChannels, (int) FLAC__MAX_BLOCK_SIZE, false, false, true);
+
+        reservoirIsFixedSize = true;
+    }
+
     bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override
     {
@@ -266,10 +346,18 @@ public:
             if (requestedStart < bufferedRange.getStart()
                 || jmax (bufferedRange.getEnd(), bufferedRange.getStart() + (int64) 511) < requestedStart)
             {
+                if (seekUsingIndex (requestedStart))
+                    return;
+
                 // had some problems with flac crashing if the read pos is aligned more
                 // accurately than this. Probably fixed in newer versions of the library, though.
                 bufferedRange = emptyRange (requestedStart & ~511);
-                FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) bufferedRange.getStart());
+
+                // if the requested sample is in a later frame than the aligned position,
+                // we'll need to keep decoding until we reach it
+                if (FLAC__stream_decoder_seek_absolute (decoder, (FlacNamespace::FLAC__uint64) bufferedRange.getStart()))
+                    decodeUntilBuffered (requestedStart);
+
                 return;
             }
 
@@ -300,7 +388,12 @@ public:
         else
         {
             if (numSamples > reservoir.getNumSamples())
+            {
+                if (reservoirIsFixedSize)
+                    return;
+
                 reservoir.setSize ((int) numChannels, numSamples, false, false, true);
+            }
 
             auto bitsToShift = 32 - bitsPerSample;
 
@@ -325,6 +418,61 @@ public:
         }
     }
 
+    void useFrameHeader (const FlacNamespace::FLAC__StreamDecoder* d, const FlacNamespace::FLAC__FrameHeader& header)
+    {
+        if (header.number_type != FlacNamespace::FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER)
+            return;
+
+        const auto firstSample = (int64) header.number.sample_number;
+
+        // at this point, the decode position is the end of this frame, and so the start of the next one
+        FlacNamespace::FLAC__uint64 nextFramePosition = 0;
+
+        if (FLAC__stream_decoder_get_decode_position (d, &nextFramePosition))
+            seekIndex->addPoint ({ firstSample + (int64) header.blocksize, nextFramePosition });
+
+        if (syncingToFrameHeaders)
+            bufferedRange = emptyRange (firstSample);
+    }
+
+    /*  Tries to jump straight to a frame that's in the seek index, and then decodes forwards
+        until the reservoir contains the target sample.
+    */
+    bool seekUsingIndex (int64 targetSample)
+    {
+        const auto point = seekIndex->findPointBefore (targetSample);
+
+        if (! point.has_value())
+            return false;
+
+        // if we're already somewhere between the indexed frame and the target, we can just carry on decoding
+        if (point->sample > bufferedRange.getEnd() || targetSample < bufferedRange.getEnd())
+        {
+            FLAC__stream_decoder_flush (decoder);
+
+            if (! input->setPosition ((int64) point->byteOffset))
+                return false;
+
+            bufferedRange = emptyRange (point->sample);
+        }
+
+        decodeUntilBuffered (targetSample);
+        return bufferedRange.contains (targetSample);
+    }
+
+    void decodeUntilBuffered (int64 targetSample)
+    {
+        const ScopedValueSetter<bool> svs (syncingToFrameHeaders, true);
+
+        while (bufferedRange.getEnd() <= targetSample)
+        {
+            bufferedRange = emptyRange (bufferedRange.getEnd());
+
+            if (! FLAC__stream_decoder_process_single (decoder) || bufferedRange.isEmpty())
+                break;
+        }
+    }
+
     //==============================================================================
     static FlacNamespace::FLAC__StreamDecoderReadStatus readCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__byte buffer[], size_t* bytes, void* client_data)
     {
@@ -334,7 +482,7 @@ public:
 
     static FlacNamespace::FLAC__StreamDecoderSeekStatus seekCallback_ (const FlacNamespace::FLAC__StreamDecoder*, FlacNamespace::FLAC__uint64 absolute_byte_offset, void* client_data)
     {
-        static_cast<const FlacReader*> (client_data)->input->setPosition ((int) absolute_byte_offset);
+        static_cast<const FlacReader*> (client_data)->input->setPosition ((int64) absolute_byte_offset);
         return FlacNamespace::FLAC__STREAM_DECODER_SEEK_STATUS_OK;
     }
 
@@ -355,11 +503,12 @@ public:
         return static_cast<const FlacReader*> (client_data)->input->isExhausted();
     }
 
-    static FlacNamespace::FLAC__StreamDecoderWriteStatus writeCallback_ (const FlacNamespace::FLAC__StreamDecoder*,
+    static FlacNamespace::FLAC__StreamDecoderWriteStatus writeCallback_ (const FlacNamespace::FLAC__StreamDecoder* d,
                                                                          const FlacNamespace::FLAC__Frame* frame,
                                                                          const FlacNamespace::FLAC__int32* const buffer[],
                                                                          void* client_data)
     {
+        static_cast<FlacReader*> (client_data)->useFrameHeader (d, frame->header);
         static_cast<FlacReader*> (client_data)->useSamples (buffer, (int) frame->header.blocksize);
         return FlacNamespace::FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
     }
@@ -377,13 +526,105 @@ public:
 
 private:
     FlacNamespace::FLAC__StreamDecoder* decoder;
+    std::shared_ptr<FlacSeekIndex> seekIndex;
     AudioBuffer<float> reservoir;
     Range<int64> bufferedRange;
-    bool ok = false, scanningForLength = false;
+    bool ok = false, scanningForLength = false, syncingToFrameHeaders = false, reservoirIsFixedSize = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacReader)
 };
 
+//==============================================================================
+class MemoryMappedFlacReader  : public MemoryMappedAudioFormatReader
+{
+public:
+    MemoryMappedFlacReader (const File& flacFile, std::unique_ptr<MemoryMappedFile> mappedFile, std::unique_ptr<FlacReader> flacReader)
+        : MemoryMappedAudioFormatReader (flacFile, *flacReader, 0, (int64) mappedFile->getSize(), 0),
+          decoder (std::move (flacReader))
+    {
+        // the decoder is already reading from the mapped data, so the file stays mapped until this is deleted
+        map = std::move (mappedFile);
+        mappedSection = Range<int64> (0, lengthInSamples);
+
+        // getSample() is noexcept, and may be called on the audio thread, so it mustn't allocate
+        decoder->useFixedSizeReservoir();
+
+        sampleValues.calloc (numChannels);
+        samplePointers.calloc (numChannels);
+
+        for (int i = 0; i < (int) numChannels; ++i)
+            samplePointers[i] = sampleValues + i;
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        return decoder->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+    }
+
+    void getSample (int64 sampleIndex, float* result) const noexcept override
+    {
+        if (! decoder->readSamples (samplePointers, (int) numChannels, 0, sampleIndex, 1))
+            zeromem (sampleValues, sizeof (int) * numChannels);
+
+        for (int i = 0; i < (int) numChannels; ++i)
+            result[i] = (float) sampleValues[i] * (1.0f / (float) 0x7fffffff);
+    }
+
+private:
+    std::unique_ptr<FlacReader> decoder;
+    HeapBlock<int> sampleValues;
+    HeapBlock<int*> samplePointers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedFlacReader)
+};
+
+//==============================================================================
+/*  Keeps the seek indexes of recently-opened files, so that a file that gets reopened
+    doesn't need to be indexed or scanned again.
+*/
+class FlacAudioFormat::SeekIndexCache
+{
+public:
+    std::shared_ptr<FlacSeekIndex> getIndexFor (const File& file)
+    {
+        const auto fileSize = file.getSize();
+        const auto modificationTime = file.getLastModificationTime();
+
+        const ScopedLock sl (lock);
+        auto& entry = entries[file.getFullPathName()];
+
+        if (entry.index == nullptr || entry.fileSize != fileSize || entry.modificationTime != modificationTime)
+            entry = { std::make_shared<FlacSeekIndex>(), fileSize, modificationTime, 0 };
+
+        entry.lastUsed = ++useCounter;
+        auto index = entry.index;
+
+        if (entries.size() > maxNumEntries)
+            entries.erase (std::min_element (entries.begin(), entries.end(), [] (const auto& a, const auto& b)
+                                             {
+                                                 return a.second.lastUsed < b.second.lastUsed;
+                                             }));
+
+        return index;
+    }
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<FlacSeekIndex> index;
+        int64 fileSize;
+        Time modificationTime;
+        uint64 lastUsed;
+    };
+
+    static constexpr size_t maxNumEntries = 1024;
+
+    CriticalSection lock;
+    std::map<String, Entry> entries;
+    uint64 useCounter = 0;
+};
+
 
 //==============================================================================
 class FlacWriter  : public AudioFormatWriter
@@ -511,13 +752,20 @@ public:
     static FlacNamespace::FLAC__StreamEncoderWriteStatus encodeWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
                                                                               const FlacNamespace::FLAC__byte buffer[],
                                                                               size_t bytes,
-                                                                              unsigned int /*samples*/,
+                                                                              unsigned int samples,
                                                                               unsigned int /*current_frame*/,
                                                                               void* client_data)
     {
-        return static_cast<FlacWriter*> (client_data)->writeData (buffer, (int) bytes)
-                ? FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK
-                : FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+        auto* writer = static_cast<FlacWriter*> (client_data);
+
+        if (! writer->writeData (buffer, (int) bytes))
+            return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_FATAL_ERROR;
+
+        // the encoder writes each audio frame in a single call, and the metadata with zero samples
+        if (samples > 0 && writer->onFrameWritten != nullptr)
+            writer->onFrameWritten (bytes);
+
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
     }
 
     static FlacNamespace::FLAC__StreamEncoderSeekStatus encodeSeekCallback (const FlacNamespace::FLAC__StreamEncoder*, FlacNamespace::FLAC__uint64, void*)
@@ -541,6 +789,9 @@ public:
 
     bool ok = false;
 
+    /** If set, this is called with the size of each audio frame after it's written. */
+    std::function<void (size_t)> onFrameWritten;
+
 private:
     FlacNamespace::FLAC__StreamEncoder* encoder;
     int64 streamStartPos;
@@ -550,7 +801,273 @@ private:
 
 
 //==============================================================================
-FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
+/*  Lets a long stream be cut into sections which are encoded independently, on as
+    many threads as you like, and then joins up their frames into a single FLAC stream.
+
+    Every section except the last one must be a multiple of sectionGranularity samples
+    long, so that all the frames except the very last one are full blocks, whichever
+    block size the encoder picks for the compression level. When the sections are
+    joined, each frame header is renumbered and its checksums recalculated. The MD5
+    signature of the joined stream is left blank, which the format allows to mean
+    "unknown".
+*/
+class FlacSectionSplicer
+{
+public:
+    static constexpr int sectionGranularity = 36864; // a multiple of both 1152 and 4096
+
+    struct EncodedSection
+    {
+        MemoryBlock data;
+        std::vector<uint32> frameSizes;
+        int64 numSamples = 0;
+        bool ok = false;
+    };
+
+    FlacSectionSplicer (OutputStream& out, double rate, uint32 numChans, uint32 bits, int quality)
+        : output (out), sampleRate (rate), numChannels (numChans),
+          bitsPerSample (bits), qualityOptionIndex (quality)
+    {
+    }
+
+    /** Encodes a section. This is thread-safe, and can be called for several sections at once. */
+    EncodedSection encode (const AudioBuffer<float>& source, int startSample, int numSamples) const
+    {
+        EncodedSection section;
+        section.numSamples = numSamples;
+
+        {
+            // the last frame is only flushed when the writer is deleted
+            auto stream = std::make_unique<MemoryOutputStream> (section.data, false);
+            FlacWriter writer (stream.get(), sampleRate, numChannels, bitsPerSample, qualityOptionIndex);
+
+            if (writer.ok)
+            {
+                stream.release();
+                writer.onFrameWritten = [&section] (size_t size) { section.frameSizes.push_back ((uint32) size); };
+                section.ok = writer.writeFromAudioSampleBuffer (source, startSample, numSamples);
+            }
+        }
+
+        return section;
+    }
+
+    /** Appends the next section to the output stream. The sections must be appended in order. */
+    bool append (const EncodedSection& section)
+    {
+        if (! section.ok)
+            return false;
+
+        auto* data = static_cast<const uint8*> (section.data.getData());
+        size_t framesSize = 0;
+
+        for (auto size : section.frameSizes)
+            framesSize += size;
+
+        jassert (framesSize <= section.data.getSize());
+        auto headerSize = section.data.getSize() - framesSize;
+
+        if (numFramesWritten == 0)
+        {
+            // the first section's header becomes the header of the whole stream
+            if (headerSize < streamInfoEnd || memcmp (data, "fLaC", 4) != 0 || (data[4] & 0x7f) != 0)
+                return false;
+
+            streamStartPos = output.getPosition();
+            memcpy (streamInfo, data, streamInfoEnd);
+
+            if (! output.write (data, headerSize))
+                return false;
+        }
+
+        data += headerSize;
+
+        for (auto size : section.frameSizes)
+        {
+            if (! writeRenumberedFrame (data, size))
+                return false;
+
+            data += size;
+        }
+
+        totalSamples += section.numSamples;
+        return true;
+    }
+
+    /** Fills in the stream's totals once all the sections have been appended. */
+    bool finish()
+    {
+        if (numFramesWritten == 0)
+            return false;
+
+        auto* info = streamInfo + 8;
+        FlacWriter::packUint32 ((FlacNamespace::FLAC__uint32) minFrameSize, info + 4, 3);
+        FlacWriter::packUint32 ((FlacNamespace::FLAC__uint32) maxFrameSize, info + 7, 3);
+        info[13] = (uint8) ((info[13] & 0xf0) | ((totalSamples >> 32) & 0x0f));
+        FlacWriter::packUint32 ((FlacNamespace::FLAC__uint32) totalSamples, info + 14, 4);
+        zeromem (info + 18, 16);
+
+        auto endPos = output.getPosition();
+
+        if (! output.setPosition (streamStartPos))
+            return false;
+
+        auto ok = output.write (streamInfo, streamInfoEnd);
+        output.setPosition (endPos);
+        output.flush();
+        return ok;
+    }
+
+private:
+    //==============================================================================
+    static constexpr size_t streamInfoEnd = 8 + 34;
+
+    bool writeRenumberedFrame (const uint8* frame, size_t size)
+    {
+        // A frame header is 4 fixed bytes, then the frame number in a UTF-8-like coding,
+        // then an optional block size and sample rate, then a CRC-8 of the header. The
+        // frame ends with a CRC-16 of everything before it.
+        if (size < 8 || frame[0] != 0xff || frame[1] != 0xf8)
+            return false;
+
+        auto numberSize = (size_t) jmax (1, countLeadingOnes (frame[4]));
+        auto blockSizeCode = frame[2] >> 4;
+        auto sampleRateCode = frame[2] & 0x0f;
+
+        auto extraSize = (size_t) (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                       + (size_t) (sampleRateCode == 12 ? 1 : ((sampleRateCode == 13 || sampleRateCode == 14) ? 2 : 0));
+
+        auto bodyStart = 4 + numberSize + extraSize + 1;
+
+        if (bodyStart + 2 > size)
+            return false;
+
+        uint8 header[16];
+        memcpy (header, frame, 4);
+        auto headerSize = 4 + writeFrameNumber (header + 4, numFramesWritten);
+        memcpy (header + headerSize, frame + 4 + numberSize, extraSize);
+        headerSize += extraSize;
+        header[headerSize] = crc8 (header, headerSize);
+        ++headerSize;
+
+        auto bodySize = size - bodyStart - 2;
+        auto crc = crc16 (0, header, headerSize);
+        crc = crc16 (crc, frame + bodyStart, bodySize);
+        const uint8 footer[] = { (uint8) (crc >> 8), (uint8) crc };
+
+        auto newSize = (uint32) (headerSize + bodySize + 2);
+        minFrameSize = numFramesWritten == 0 ? newSize : jmin (minFrameSize, newSize);
+        maxFrameSize = jmax (maxFrameSize, newSize);
+        ++numFramesWritten;
+
+        return output.write (header, headerSize)
+            && output.write (frame + bodyStart, bodySize)
+            && output.write (footer, 2);
+    }
+
+    static int countLeadingOnes (uint8 b) noexcept
+    {
+        int n = 0;
+
+        while (n < 8 && (b & (0x80 >> n)) != 0)
+            ++n;
+
+        return n;
+    }
+
+    static size_t writeFrameNumber (uint8* dest, uint32 value) noexcept
+    {
+        if (value < 0x80)
+        {
+            dest[0] = (uint8) value;
+            return 1;
+        }
+
+        size_t numBytes = value < 0x800 ? 2 : value < 0x10000 ? 3 : value < 0x200000 ? 4 : value < 0x4000000 ? 5 : 6;
+        auto shift = (int) (6 * (numBytes - 1));
+
+        dest[0] = (uint8) ((0xff00 >> numBytes) | (value >> shift));
+
+        for (size_t i = 1; i < numBytes; ++i)
+        {
+            shift -= 6;
+            dest[i] = (uint8) (0x80 | ((value >> shift) & 0x3f));
+        }
+
+        return numBytes;
+    }
+
+    static uint8 crc8 (const uint8* data, size_t size) noexcept
+    {
+        static const auto table = []
+        {
+            std::array<uint8, 256> t;
+
+            for (int i = 0; i < 256; ++i)
+            {
+                auto crc = (uint32) i;
+
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (crc & 0x80) != 0 ? ((crc << 1) ^ 0x07) : (crc << 1);
+
+                t[(size_t) i] = (uint8) crc;
+            }
+
+            return t;
+        }();
+
+        uint8 crc = 0;
+
+        for (size_t i = 0; i < size; ++i)
+            crc = table[crc ^ data[i]];
+
+        return crc;
+    }
+
+    static uint16 crc16 (uint16 crc, const uint8* data, size_t size) noexcept
+    {
+        static const auto table = []
+        {
+            std::array<uint16, 256> t;
+
+            for (int i = 0; i < 256; ++i)
+            {
+                auto entry = (uint32) i << 8;
+
+                for (int bit = 0; bit < 8; ++bit)
+                    entry = (entry & 0x8000) != 0 ? ((entry << 1) ^ 0x8005) : (entry << 1);
+
+                t[(size_t) i] = (uint16) entry;
+            }
+
+            return t;
+        }();
+
+        for (size_t i = 0; i < size; ++i)
+            crc = (uint16) ((crc << 8) ^ table[(size_t) ((crc >> 8) ^ data[i])]);
+
+        return crc;
+    }
+
+    OutputStream& output;
+    const double sampleRate;
+    const uint32 numChannels, bitsPerSample;
+    const int qualityOptionIndex;
+
+    uint8 streamInfo[streamInfoEnd] = {};
+    int64 streamStartPos = 0, totalSamples = 0;
+    uint32 numFramesWritten = 0, minFrameSize = 0, maxFrameSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (FlacSectionSplicer)
+};
+
+//==============================================================================
+FlacAudioFormat::FlacAudioFormat()
+    : AudioFormat (flacFormatName, ".flac"),
+      seekIndexCache (std::make_unique<SeekIndexCache>())
+{
+}
+
 FlacAudioFormat::~FlacAudioFormat() {}
 
 Array<int> FlacAudioFormat::getPossibleSampleRates()
@@ -581,6 +1098,32 @@ AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool
     return nullptr;
 }
 
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (const File& file)
+{
+    auto mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr || mappedFile->getSize() == 0)
+        return nullptr;
+
+    auto reader = std::make_unique<FlacReader> (new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false),
+                                                seekIndexCache->getIndexFor (file));
+
+    if (reader->sampleRate <= 0)
+        return nullptr;
+
+    return new MemoryMappedFlacReader (file, std::move (mappedFile), std::move (reader));
+}
+
+MemoryMappedAudioFormatReader* FlacAudioFormat::createMemoryMappedReader (FileInputStream* fin)
+{
+    if (fin == nullptr)
+        return nullptr;
+
+    const auto file = fin->getFile();
+    delete fin;
+    return createMemoryMappedReader (file);
+}
+
 AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
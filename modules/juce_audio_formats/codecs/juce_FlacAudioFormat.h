@@ -57,6 +57,17 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that decodes directly from a memory-mapped copy of the file.
+
+        This avoids the system calls and buffer copies involved in reading through a
+        FileInputStream. The whole file is mapped as soon as the reader is created. While
+        it is decoded, the reader builds an index of frame positions, which is shared with
+        any other memory-mapped readers of the same file that this format object creates.
+        This lets them seek without searching the file.
+    */
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (const File&)      override;
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (FileInputStream*) override;
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
@@ -66,6 +77,9 @@ public:
     using AudioFormat::createWriterFor;
 
 private:
+    class SeekIndexCache;
+    std::unique_ptr<SeekIndexCache> seekIndexCache;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
 
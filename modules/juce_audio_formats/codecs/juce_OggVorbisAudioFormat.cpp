@@ -261,6 +261,54 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OggReader)
 };
 
+//==============================================================================
+/*  The decoder reads straight from the mapped file, and the reservoir is only allocated
+    once, when the OggReader is created. But getSample() isn't realtime-safe: when the
+    sample isn't in the reservoir, libvorbis has to seek, and a seek clears and rebuilds
+    the decoder's state, which allocates. Only reads that continue from the last decoded
+    position avoid that.
+*/
+class MemoryMappedOggReader  : public MemoryMappedAudioFormatReader
+{
+public:
+    MemoryMappedOggReader (const File& oggFile, std::unique_ptr<MemoryMappedFile> mappedFile, std::unique_ptr<OggReader> oggReader)
+        : MemoryMappedAudioFormatReader (oggFile, *oggReader, 0, (int64) mappedFile->getSize(), 0),
+          decoder (std::move (oggReader))
+    {
+        // the decoder is already reading from the mapped data, so the file stays mapped until this is deleted
+        map = std::move (mappedFile);
+        mappedSection = Range<int64> (0, lengthInSamples);
+
+        sampleValues.calloc (numChannels);
+        samplePointers.calloc (numChannels);
+
+        for (int i = 0; i < (int) numChannels; ++i)
+            samplePointers[i] = reinterpret_cast<int*> (sampleValues + i);
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        return decoder->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+    }
+
+    // This may allocate inside libvorbis, so don't call it on a realtime thread
+    void getSample (int64 sampleIndex, float* result) const noexcept override
+    {
+        if (! decoder->readSamples (samplePointers, (int) numChannels, 0, sampleIndex, 1))
+            zeromem (sampleValues, sizeof (float) * numChannels);
+
+        std::copy (sampleValues.get(), sampleValues.get() + numChannels, result);
+    }
+
+private:
+    std::unique_ptr<OggReader> decoder;
+    HeapBlock<float> sampleValues;
+    HeapBlock<int*> samplePointers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MemoryMappedOggReader)
+};
+
 //==============================================================================
 class OggWriter  : public AudioFormatWriter
 {
@@ -451,6 +499,31 @@ AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool
     return nullptr;
 }
 
+MemoryMappedAudioFormatReader* OggVorbisAudioFormat::createMemoryMappedReader (const File& file)
+{
+    auto mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() == nullptr || mappedFile->getSize() == 0)
+        return nullptr;
+
+    auto reader = std::make_unique<OggReader> (new MemoryInputStream (mappedFile->getData(), mappedFile->getSize(), false));
+
+    if (reader->sampleRate <= 0)
+        return nullptr;
+
+    return new MemoryMappedOggReader (file, std::move (mappedFile), std::move (reader));
+}
+
+MemoryMappedAudioFormatReader* OggVorbisAudioFormat::createMemoryMappedReader (FileInputStream* fin)
+{
+    if (fin == nullptr)
+        return nullptr;
+
+    const auto file = fin->getFile();
+    delete fin;
+    return createMemoryMappedReader (file);
+}
+
 AudioFormatWriter* OggVorbisAudioFormat::createWriterFor (OutputStream* out,
                                                           double sampleRate,
                                                           unsigned int numChannels,
@@ -84,6 +84,18 @@ public:
     AudioFormatReader* createReaderFor (InputStream* sourceStream,
                                         bool deleteStreamIfOpeningFails) override;
 
+    /** Creates a reader that decodes directly from a memory-mapped copy of the file.
+
+        This avoids the system calls and buffer copies involved in reading through a
+        FileInputStream. The whole file is mapped as soon as the reader is created.
+
+        Note that, unlike the FLAC version, this reader's getSample() isn't realtime-safe.
+        Reading a sample that isn't near the last one read makes the Vorbis decoder seek,
+        and that rebuilds its internal state, which allocates memory.
+    */
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (const File&)      override;
+    MemoryMappedAudioFormatReader* createMemoryMappedReader (FileInputStream*) override;
+
     AudioFormatWriter* createWriterFor (OutputStream* streamToWriteTo,
                                         double sampleRateToUse,
                                         unsigned int numberOfChannels,
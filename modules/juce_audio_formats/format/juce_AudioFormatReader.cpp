@@ -421,6 +421,22 @@ bool MemoryMappedAudioFormatReader::mapEntireFile()
 
 bool MemoryMappedAudioFormatReader::mapSectionOfFile (Range<int64> samplesToMap)
 {
+    if (isCompressed())
+    {
+        if (map == nullptr)
+        {
+            map.reset (new MemoryMappedFile (file, Range<int64> (dataChunkStart, dataChunkStart + dataLength),
+                                             MemoryMappedFile::readOnly));
+
+            if (map->getData() == nullptr)
+                map.reset();
+            else
+                mappedSection = Range<int64> (0, lengthInSamples);
+        }
+
+        return map != nullptr;
+    }
+
     if (map == nullptr || samplesToMap != mappedSection)
     {
         map.reset();
@@ -445,9 +461,17 @@ static int memoryReadDummyVariable; // used to force the compiler not to optimis
 void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
 {
     if (map != nullptr && mappedSection.contains (sample))
-        memoryReadDummyVariable += *(char*) sampleToPointer (sample);
+    {
+        // for compressed data, this can only guess roughly where the sample will be
+        const auto offset = isCompressed() ? (int64) map->getSize() * sample / jmax ((int64) 1, lengthInSamples)
+                                           : sampleToFilePos (sample) - map->getRange().getStart();
+
+        memoryReadDummyVariable += *addBytesToPointer ((const char*) map->getData(), offset);
+    }
     else
+    {
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
+    }
 }
 
 } // namespace juce
@@ -0,0 +1,597 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct BatchAudioExporter::Section
+{
+    AudioBuffer<float> audio;
+    int numSamples = 0;
+    bool isEncoded = false;
+};
+
+//==============================================================================
+class BatchAudioExporter::SectionEncoder
+{
+public:
+    virtual ~SectionEncoder() = default;
+
+    /** If this returns true, encode() may be called for several sections at once. */
+    virtual bool encodesInParallel() const = 0;
+
+    virtual bool encode (int sectionIndex, Section&) = 0;
+    virtual bool write (int sectionIndex, Section&) = 0;
+    virtual bool finish() = 0;
+};
+
+// Writes the sections one after another with the format's normal AudioFormatWriter
+class BatchAudioExporter::PlainEncoder  : public SectionEncoder
+{
+public:
+    PlainEncoder (const Job& job, std::unique_ptr<FileOutputStream> out)
+    {
+        auto& source = *job.source;
+        writer.reset (job.format->createWriterFor (out.get(), source.sampleRate, source.numChannels,
+                                                   job.bitsPerSample, job.metadataValues, job.qualityOptionIndex));
+
+        if (writer != nullptr)
+            out.release();
+    }
+
+    bool isValid() const noexcept                                   { return writer != nullptr; }
+
+    bool encodesInParallel() const override                         { return false; }
+    bool encode (int, Section&) override          { return true; }
+
+    bool write (int, Section& section) override
+    {
+        return writer->writeFromAudioSampleBuffer (section.audio, 0, section.numSamples);
+    }
+
+    bool finish() override
+    {
+        writer->flush();
+        writer.reset();
+        return true;
+    }
+
+private:
+    std::unique_ptr<AudioFormatWriter> writer;
+};
+
+#if JUCE_USE_FLAC
+// Encodes each section as an independent run of FLAC frames, and joins them up as they're written
+class BatchAudioExporter::FlacEncoder  : public SectionEncoder
+{
+public:
+    FlacEncoder (const Job& job, std::unique_ptr<FileOutputStream> out)
+        : output (std::move (out)),
+          splicer (*output, job.source->sampleRate, job.source->numChannels,
+                   (uint32) job.bitsPerSample, job.qualityOptionIndex)
+    {
+        static_assert (sectionLength % FlacSectionSplicer::sectionGranularity == 0,
+                       "Every section except the last must contain whole FLAC frames");
+    }
+
+    bool encodesInParallel() const override                         { return true; }
+
+    bool encode (int sectionIndex, Section& section) override
+    {
+        auto encoded = splicer.encode (section.audio, 0, section.numSamples);
+        auto ok = encoded.ok;
+        section.audio.setSize (0, 0);
+
+        const ScopedLock sl (lock);
+        encodedSections[sectionIndex] = std::move (encoded);
+        return ok;
+    }
+
+    bool write (int sectionIndex, Section&) override
+    {
+        FlacSectionSplicer::EncodedSection encoded;
+
+        {
+            const ScopedLock sl (lock);
+            auto found = encodedSections.find (sectionIndex);
+            jassert (found != encodedSections.end());
+            encoded = std::move (found->second);
+            encodedSections.erase (found);
+        }
+
+        return splicer.append (encoded);
+    }
+
+    bool finish() override
+    {
+        auto ok = splicer.finish() && output->getStatus().wasOk();
+        output.reset();
+        return ok;
+    }
+
+private:
+    std::unique_ptr<FileOutputStream> output;
+    FlacSectionSplicer splicer;
+    CriticalSection lock;
+    std::map<int, FlacSectionSplicer::EncodedSection> encodedSections;
+};
+#endif
+
+//==============================================================================
+class BatchAudioExporter::JobState
+{
+public:
+    explicit JobState (Job&& j)  : job (std::move (j)) {}
+
+    Job job;
+    int64 length = 0;
+    int numSections = 0, maxSectionsInFlight = 0;
+    std::unique_ptr<SectionEncoder> encoder;
+
+    CriticalSection lock;
+    std::map<int, std::unique_ptr<Section>> sections;
+    int nextSectionToRead = 0, nextSectionToWrite = 0;
+    bool isReading = false, isWriting = false, isComplete = false;
+    Result result { Result::ok() };
+
+    JUCE_DECLARE_NON_COPYABLE (JobState)
+};
+
+//==============================================================================
+BatchAudioExporter::BatchAudioExporter (int numThreads)
+    : pool (WorkStealingThreadPool::Options{}.withThreadName ("Audio export")
+                                             .withNumberOfThreads (jmax (1, numThreads)))
+{
+}
+
+BatchAudioExporter::~BatchAudioExporter()
+{
+    cancel();
+    pool.waitForAll();
+}
+
+double BatchAudioExporter::getProgress() const noexcept
+{
+    auto total = totalSamples.load();
+    return total > 0 ? (double) samplesWritten.load() / (double) total : 0.0;
+}
+
+Array<Result> BatchAudioExporter::exportAll (std::vector<Job> jobs)
+{
+    cancelled = false;
+    totalSamples = 0;
+    samplesWritten = 0;
+
+    std::vector<std::unique_ptr<JobState>> states;
+
+    for (auto& job : jobs)
+    {
+        auto state = std::make_unique<JobState> (std::move (job));
+        auto& j = state->job;
+
+        if (j.source == nullptr || j.format == nullptr)
+        {
+            jassertfalse;
+            state->result = Result::fail ("No source or format");
+            states.push_back (std::move (state));
+            continue;
+        }
+
+        state->length = jmax ((int64) 0, j.numSamples >= 0 ? j.numSamples
+                                                           : j.source->lengthInSamples - j.startSample);
+        state->numSections = (int) ((state->length + sectionLength - 1) / sectionLength);
+        j.processBlockSize = jmax (1, j.processBlockSize);
+
+        j.destination.deleteFile();
+        auto out = std::make_unique<FileOutputStream> (j.destination);
+
+        if (out->failedToOpen())
+        {
+            state->result = Result::fail ("Couldn't create " + j.destination.getFullPathName());
+            out.reset();
+            j.destination.deleteFile();
+        }
+       #if JUCE_USE_FLAC
+        else if (dynamic_cast<FlacAudioFormat*> (j.format) != nullptr
+                  && state->numSections > 1
+                  && j.format->getPossibleBitDepths().contains (j.bitsPerSample))
+        {
+            state->encoder = std::make_unique<FlacEncoder> (j, std::move (out));
+            state->maxSectionsInFlight = pool.getNumThreads() + 2;
+        }
+       #endif
+        else
+        {
+            auto plain = std::make_unique<PlainEncoder> (j, std::move (out));
+
+            if (plain->isValid())
+            {
+                state->encoder = std::move (plain);
+            }
+            else
+            {
+                state->result = Result::fail ("Couldn't create a writer for " + j.destination.getFullPathName());
+                plain.reset();
+                j.destination.deleteFile();
+            }
+
+            state->maxSectionsInFlight = 3;
+        }
+
+        if (state->encoder != nullptr)
+            totalSamples += state->length;
+
+        states.push_back (std::move (state));
+    }
+
+    for (auto& state : states)
+    {
+        if (state->encoder != nullptr)
+        {
+            const ScopedLock sl (state->lock);
+
+            if (state->numSections == 0)
+                state->isComplete = state->encoder->finish();
+            else
+                scheduleWork (*state);
+        }
+    }
+
+    pool.waitForAll();
+
+    Array<Result> results;
+
+    for (auto& state : states)
+    {
+        if (state->encoder != nullptr)
+        {
+            if (state->result.wasOk() && ! state->isComplete)
+                state->result = Result::fail (cancelled ? "Cancelled" : "Error writing " + state->job.destination.getFullPathName());
+
+            state->encoder.reset();
+
+            if (state->result.failed())
+                state->job.destination.deleteFile();
+        }
+
+        results.add (state->result);
+    }
+
+    return results;
+}
+
+//==============================================================================
+void BatchAudioExporter::scheduleWork (JobState& state)
+{
+    // must be called with the state's lock held
+    if (state.result.failed() || cancelled)
+        return;
+
+    if (! state.isReading
+         && state.nextSectionToRead < state.numSections
+         && state.nextSectionToRead - state.nextSectionToWrite < state.maxSectionsInFlight)
+    {
+        state.isReading = true;
+        pool.addJob ([this, &state] { readNextSection (state); });
+    }
+
+    if (! state.isWriting)
+    {
+        auto next = state.sections.find (state.nextSectionToWrite);
+
+        if (next != state.sections.end() && next->second->isEncoded)
+        {
+            state.isWriting = true;
+            pool.addJob ([this, &state] { writeSections (state); });
+        }
+    }
+}
+
+void BatchAudioExporter::readNextSection (JobState& state)
+{
+    // only one of these runs at a time for each job, so this is the only thread using the reader
+    auto& job = state.job;
+    auto index = state.nextSectionToRead;
+    auto start = (int64) index * sectionLength;
+
+    auto section = std::make_unique<Section>();
+    section->numSamples = (int) jmin ((int64) sectionLength, state.length - start);
+    section->audio.setSize ((int) job.source->numChannels, section->numSamples);
+
+    auto ok = ! cancelled && job.source->read (&section->audio, 0, section->numSamples, job.startSample + start, true, true);
+
+    if (ok && job.process != nullptr)
+    {
+        for (int pos = 0; pos < section->numSamples; pos += job.processBlockSize)
+        {
+            AudioBuffer<float> block (section->audio.getArrayOfWritePointers(), section->audio.getNumChannels(),
+                                      pos, jmin (job.processBlockSize, section->numSamples - pos));
+
+            job.process (block, job.startSample + start + pos);
+        }
+    }
+
+    const ScopedLock sl (state.lock);
+    state.isReading = false;
+
+    if (! ok)
+    {
+        if (! cancelled)
+            state.result = Result::fail ("Error reading the source for " + job.destination.getFullPathName());
+
+        return;
+    }
+
+    auto* s = section.get();
+    state.sections[index] = std::move (section);
+    ++state.nextSectionToRead;
+
+    if (state.encoder->encodesInParallel())
+        pool.addJob ([this, &state, index] { encodeSection (state, index); });
+    else
+        s->isEncoded = true;
+
+    scheduleWork (state);
+}
+
+void BatchAudioExporter::encodeSection (JobState& state, int sectionIndex)
+{
+    Section* section = nullptr;
+
+    {
+        const ScopedLock sl (state.lock);
+        section = state.sections[sectionIndex].get();
+    }
+
+    auto ok = ! cancelled && state.encoder->encode (sectionIndex, *section);
+
+    const ScopedLock sl (state.lock);
+    section->isEncoded = true;
+
+    if (! ok && ! cancelled)
+        state.result = Result::fail ("Error encoding " + state.job.destination.getFullPathName());
+
+    scheduleWork (state);
+}
+
+void BatchAudioExporter::writeSections (JobState& state)
+{
+    // only one of these runs at a time for each job, and it writes whichever sections are ready, in order
+    for (;;)
+    {
+        Section* section = nullptr;
+        auto index = state.nextSectionToWrite;
+
+        {
+            const ScopedLock sl (state.lock);
+            auto next = state.sections.find (index);
+
+            if (state.result.failed() || cancelled || next == state.sections.end() || ! next->second->isEncoded)
+            {
+                state.isWriting = false;
+                scheduleWork (state);
+                return;
+            }
+
+            section = next->second.get();
+        }
+
+        auto ok = state.encoder->write (index, *section);
+        samplesWritten += section->numSamples;
+
+        auto isLast = (index == state.numSections - 1);
+
+        if (ok && isLast)
+            ok = state.encoder->finish();
+
+        const ScopedLock sl (state.lock);
+        state.sections.erase (index);
+        ++state.nextSectionToWrite;
+
+        if (! ok)
+            state.result = Result::fail ("Error writing " + state.job.destination.getFullPathName());
+        else if (isLast)
+            state.isComplete = true;
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class BatchAudioExporterTests  : public UnitTest
+{
+public:
+    BatchAudioExporterTests()
+        : UnitTest ("BatchAudioExporter", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        const int numChannels = 2;
+        const int64 length = BatchAudioExporter::sectionLength * 3 + 12345;
+
+        beginTest ("Long FLAC files are encoded in sections and joined up");
+        {
+            TemporaryFile flacFile (".flac"), wavFile (".wav"), shortFlacFile (".flac");
+            FlacAudioFormat flac;
+            WavAudioFormat wav;
+
+            int64 lastPosition = -1;
+            bool processedInOrder = true;
+
+            std::vector<BatchAudioExporter::Job> jobs;
+            jobs.push_back (createJob (numChannels, length, flac, flacFile.getFile()));
+            jobs.back().qualityOptionIndex = 5;
+            jobs.back().process = [&] (AudioBuffer<float>& block, int64 position)
+            {
+                processedInOrder = processedInOrder && position > lastPosition;
+                lastPosition = position;
+                block.applyGain (0.5f);
+            };
+
+            jobs.push_back (createJob (numChannels, length, wav, wavFile.getFile()));
+            jobs.push_back (createJob (1, 5000, flac, shortFlacFile.getFile()));
+
+            BatchAudioExporter exporter (4);
+            auto results = exporter.exportAll (std::move (jobs));
+
+            expectEquals (results.size(), 3);
+
+            for (auto& r : results)
+                expect (r.wasOk(), r.getErrorMessage());
+
+            expect (processedInOrder);
+            expectEquals (exporter.getProgress(), 1.0);
+
+            auto expected = createSignal (numChannels, (int) length);
+            expected.applyGain (0.5f);
+
+            expect (readFile (flac, flacFile.getFile()) == quantise (flac, expected));
+            expect (readFile (wav, wavFile.getFile()) == quantise (wav, createSignal (numChannels, (int) length)));
+            expect (readFile (flac, shortFlacFile.getFile()) == quantise (flac, createSignal (1, 5000)));
+
+            // seeking depends on every frame having the right number
+            std::unique_ptr<AudioFormatReader> reader (flac.createReaderFor (new FileInputStream (flacFile.getFile()), true));
+            const int start = BatchAudioExporter::sectionLength * 2 + 1000, num = 20000;
+            AudioBuffer<float> section (numChannels, num);
+            reader->read (&section, 0, num, start, true, true);
+
+            auto all = quantise (flac, expected);
+            bool sectionMatches = true;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < num; ++i)
+                    sectionMatches = sectionMatches && exactlyEqual (section.getSample (ch, i), all.getSample (ch, start + i));
+
+            expect (sectionMatches);
+        }
+
+        beginTest ("Failed jobs don't leave files behind");
+        {
+            TemporaryFile goodFile (".flac"), badFile (".flac");
+            FlacAudioFormat flac;
+
+            std::vector<BatchAudioExporter::Job> jobs;
+            jobs.push_back (createJob (numChannels, length, flac, goodFile.getFile()));
+            jobs.push_back (createJob (numChannels, length, flac, badFile.getFile()));
+            static_cast<TestSource*> (jobs.back().source.get())->failAfter = BatchAudioExporter::sectionLength * 2;
+
+            auto results = BatchAudioExporter (2).exportAll (std::move (jobs));
+
+            expect (results.getReference (0).wasOk());
+            expect (results.getReference (1).failed());
+            expect (goodFile.getFile().existsAsFile());
+            expect (! badFile.getFile().existsAsFile());
+        }
+    }
+
+private:
+    struct TestSource  : public AudioFormatReader
+    {
+        TestSource (int numChans, int64 length)  : AudioFormatReader (nullptr, "test")
+        {
+            sampleRate = 44100.0;
+            bitsPerSample = 32;
+            usesFloatingPointData = true;
+            numChannels = (unsigned int) numChans;
+            lengthInSamples = length;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            if (startSampleInFile + numSamples > failAfter)
+                return false;
+
+            for (int ch = 0; ch < numDestChannels; ++ch)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[ch]))
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = getSample (ch, startSampleInFile + i);
+
+            return true;
+        }
+
+        static float getSample (int channel, int64 index)
+        {
+            auto t = (double) index;
+            return (float) (0.6 * std::sin (t * (0.01 + 0.003 * channel)) + 0.3 * std::sin (t * t * 1.0e-9));
+        }
+
+        int64 failAfter = std::numeric_limits<int64>::max();
+    };
+
+    static BatchAudioExporter::Job createJob (int numChannels, int64 length, AudioFormat& format, const File& file)
+    {
+        BatchAudioExporter::Job job;
+        job.source = std::make_unique<TestSource> (numChannels, length);
+        job.format = &format;
+        job.destination = file;
+        job.bitsPerSample = 16;
+        return job;
+    }
+
+    static AudioBuffer<float> createSignal (int numChannels, int length)
+    {
+        AudioBuffer<float> buffer (numChannels, length);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < length; ++i)
+                buffer.setSample (ch, i, TestSource::getSample (ch, i));
+
+        return buffer;
+    }
+
+    // Writes the audio with the format's normal writer, and reads it back
+    static AudioBuffer<float> quantise (AudioFormat& format, const AudioBuffer<float>& source)
+    {
+        TemporaryFile temp (format.getFileExtensions()[0]);
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new FileOutputStream (temp.getFile()), 44100.0,
+                                                                               (unsigned int) source.getNumChannels(), 16, {}, 5));
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+        }
+
+        return readFile (format, temp.getFile());
+    }
+
+    static AudioBuffer<float> readFile (AudioFormat& format, const File& file)
+    {
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new FileInputStream (file), true));
+
+        if (reader == nullptr)
+            return {};
+
+        AudioBuffer<float> buffer ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+};
+
+static BatchAudioExporterTests batchAudioExporterTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders and encodes a batch of audio files, spreading the work across several
+    threads.
+
+    Each Job reads audio from an AudioFormatReader, passes it through an optional
+    processing callback, and writes the result to a file using an AudioFormat. The
+    jobs are cut into sections of a few seconds each, and each section goes through
+    three stages - reading and processing, encoding, and writing - so that while one
+    section of a file is being encoded, the next one can already be read. Sections from
+    all the jobs share the same pool of threads, so a batch of many files keeps all the
+    cores busy, and so does a single long file.
+
+    For most formats, encoding has to happen in order on a single stream, so each file
+    can only use one thread for encoding at any moment. FLAC files are different: their
+    sections are encoded independently on as many threads as are free, and then the
+    encoded frames are joined up into one stream. The result decodes to exactly the same
+    audio as a file written by FlacAudioFormat's own writer, but its STREAMINFO block
+    doesn't contain an MD5 signature.
+
+    The processing callback for a job is always called in order, and never for more than
+    one block of the same job at a time, so it can safely keep state from one block to
+    the next, e.g. a filter or a reverb. Callbacks for different jobs may be called
+    concurrently on different threads.
+
+    @code
+    BatchAudioExporter exporter;
+    std::vector<BatchAudioExporter::Job> jobs;
+
+    for (auto& stem : stems)
+    {
+        BatchAudioExporter::Job job;
+        job.source.reset (formatManager.createReaderFor (stem.sourceFile));
+        job.process = [&stem] (AudioBuffer<float>& block, int64) { stem.applyEffects (block); };
+        job.format = &flacFormat;
+        job.destination = stem.destinationFile;
+        jobs.push_back (std::move (job));
+    }
+
+    auto results = exporter.exportAll (std::move (jobs));
+    @endcode
+
+    @see AudioFormatWriter, AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  BatchAudioExporter
+{
+public:
+    //==============================================================================
+    /** A callback which processes a block of audio in-place before it gets written.
+
+        The position is the index of the block's first sample in the job's source reader.
+    */
+    using ProcessCallback = std::function<void (AudioBuffer<float>& block, int64 positionInSource)>;
+
+    /** Describes one file to export. */
+    struct Job
+    {
+        /** The reader to take the audio from. This must not be null. */
+        std::unique_ptr<AudioFormatReader> source;
+
+        /** The first sample of the source to export. */
+        int64 startSample = 0;
+
+        /** The number of samples to export, or -1 to export up to the end of the source. */
+        int64 numSamples = -1;
+
+        /** An optional callback that processes the audio before it's written. */
+        ProcessCallback process;
+
+        /** The maximum number of samples that will be passed to the process callback at once. */
+        int processBlockSize = 4096;
+
+        /** The format to write. This must not be null, and must outlive the call to exportAll(). */
+        AudioFormat* format = nullptr;
+
+        /** The file to create. If it already exists, it'll be overwritten. */
+        File destination;
+
+        /** The bit depth to write, which must be one of the format's supported depths. */
+        int bitsPerSample = 24;
+
+        /** The quality option to pass to AudioFormat::createWriterFor(). */
+        int qualityOptionIndex = 0;
+
+        /** Any metadata to pass to AudioFormat::createWriterFor(). */
+        StringPairArray metadataValues;
+    };
+
+    //==============================================================================
+    /** Creates an exporter which will use the given number of threads. */
+    explicit BatchAudioExporter (int numThreads = SystemStats::getNumCpus());
+
+    /** Destructor. */
+    ~BatchAudioExporter();
+
+    //==============================================================================
+    /** Runs a batch of jobs, and waits for them all to finish.
+
+        The calling thread helps to run the jobs while it waits.
+
+        Returns one Result for each job, in the same order as the jobs. If a job fails,
+        any file it had started writing is deleted, and the other jobs carry on.
+    */
+    Array<Result> exportAll (std::vector<Job> jobs);
+
+    /** Can be called from any thread while exportAll() is running to abandon the jobs
+        that haven't finished yet. Their files will be deleted, and their results will
+        be failures.
+    */
+    void cancel() noexcept                              { cancelled = true; }
+
+    /** Returns the proportion of the current batch's samples that have been written so far. */
+    double getProgress() const noexcept;
+
+    //==============================================================================
+    /** The length of the sections that the jobs are cut into. */
+    static constexpr int sectionLength = 4 * 36864;
+
+private:
+    //==============================================================================
+    struct Section;
+    class JobState;
+    class SectionEncoder;
+    class PlainEncoder;
+    class FlacEncoder;
+
+    void scheduleWork (JobState&);
+    void readNextSection (JobState&);
+    void encodeSection (JobState&, int sectionIndex);
+    void writeSections (JobState&);
+
+    WorkStealingThreadPool pool;
+    std::atomic<bool> cancelled { false };
+    std::atomic<int64> totalSamples { 0 }, samplesWritten { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BatchAudioExporter)
+};
+
+} // namespace juce
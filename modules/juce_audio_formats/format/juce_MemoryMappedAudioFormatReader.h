@@ -39,6 +39,10 @@ namespace juce
     call mapEntireFile() or mapSectionOfFile() to ensure that the region you want to
     read has been mapped.
 
+    Readers for compressed formats such as FLAC and Ogg-Vorbis can't map individual
+    ranges of samples, so for these, mapSectionOfFile() will always map the whole file,
+    and the samples are decoded directly from the mapped memory.
+
     @see AudioFormat::createMemoryMappedReader, AudioFormatReader
 
     @tags{Audio}
@@ -52,6 +56,10 @@ protected:
         Note that before attempting to read any data, you must call mapEntireFile()
         or mapSectionOfFile() to ensure that the region you want to read has
         been mapped.
+
+        If the data is compressed, so that there's no fixed relationship between sample
+        positions and positions in the file, pass 0 as the bytesPerFrame, and the whole
+        data chunk will be mapped whenever any section of it is requested.
     */
     MemoryMappedAudioFormatReader (const File& file, const AudioFormatReader& details,
                                    int64 dataChunkStart, int64 dataChunkLength, int bytesPerFrame);
@@ -94,6 +102,9 @@ protected:
     /** Converts a byte position in the file to a sample index. */
     inline int64 filePosToSample (int64 filePos) const noexcept      { return (filePos - dataChunkStart) / bytesPerFrame; }
 
+    /** Returns true if the data can't be addressed by sample position, because it's compressed. */
+    bool isCompressed() const noexcept                                 { return bytesPerFrame == 0; }
+
     /** Converts a sample index to a pointer to the mapped file memory. */
     inline const void* sampleToPointer (int64 sample) const noexcept { return addBytesToPointer (map->getData(), sampleToFilePos (sample) - map->getRange().getStart()); }
 
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+/*  Checks that a format's memory-mapped reader decodes exactly the same samples as the
+    stream reader that the format creates for the same file.
+*/
+template <typename FormatType>
+class MemoryMappedAudioFormatReaderTests  : public UnitTest
+{
+public:
+    MemoryMappedAudioFormatReaderTests (const String& formatName, const String& fileExtension, int bitsPerSampleToWrite)
+        : UnitTest (formatName, UnitTestCategories::audio),
+          extension (fileExtension),
+          bitsPerSample (bitsPerSampleToWrite)
+    {}
+
+    void runTest() override
+    {
+        TemporaryFile tempFile (extension);
+        const auto file = tempFile.getFile();
+
+        beginTest ("Files can be opened with a memory-mapped reader");
+        FormatType format;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new FileOutputStream (file), 44100.0, 2, bitsPerSample, {}, 0));
+            expect (writer != nullptr);
+            writer->writeFromAudioSampleBuffer (createTestSignal(), 0, numTestSamples);
+        }
+
+        std::unique_ptr<AudioFormatReader> streamReader (format.createReaderFor (file.createInputStream().release(), true));
+        std::unique_ptr<MemoryMappedAudioFormatReader> mappedReader (format.createMemoryMappedReader (file));
+
+        expect (streamReader != nullptr);
+        expect (mappedReader != nullptr);
+        expect (mappedReader->mapEntireFile());
+        expectEquals (mappedReader->lengthInSamples, streamReader->lengthInSamples);
+
+        if (streamReader == nullptr || mappedReader == nullptr)
+            return;
+
+        const auto reference = read (*streamReader, 0, numTestSamples);
+
+        beginTest ("Memory-mapped reader decodes the same samples as a stream reader");
+        {
+            expect (read (*mappedReader, 0, numTestSamples) == reference);
+        }
+
+        beginTest ("Memory-mapped reader seeks to the same samples as a stream reader");
+        {
+            auto random = getRandom();
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto start = (int64) random.nextInt (numTestSamples);
+                const auto length = 1 + random.nextInt (5000);
+                expect (read (*mappedReader, start, length) == read (*streamReader, start, length));
+            }
+        }
+
+        beginTest ("getSample returns the decoded samples");
+        {
+            const auto expected = read (*streamReader, 12345, 1);
+            float values[2] = {};
+            mappedReader->getSample (12345, values);
+
+            expectEquals (values[0], expected.getSample (0, 0));
+            expectEquals (values[1], expected.getSample (1, 0));
+        }
+
+        beginTest ("A second reader of the same file decodes the same samples");
+        {
+            std::unique_ptr<MemoryMappedAudioFormatReader> secondReader (format.createMemoryMappedReader (file));
+            expect (secondReader != nullptr && secondReader->mapEntireFile());
+
+            if (secondReader == nullptr)
+                return;
+
+            auto random = getRandom();
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto start = random.nextInt (numTestSamples);
+                const auto length = jmin (1 + random.nextInt (5000), numTestSamples - start);
+                const auto samples = read (*secondReader, start, length);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    expect (std::equal (samples.getReadPointer (channel), samples.getReadPointer (channel) + length,
+                                        reference.getReadPointer (channel, start)));
+            }
+        }
+    }
+
+private:
+    static constexpr int numTestSamples = 100000;
+
+    static AudioBuffer<float> createTestSignal()
+    {
+        AudioBuffer<float> buffer (2, numTestSamples);
+        Random random (1234);
+
+        for (int i = 0; i < numTestSamples; ++i)
+        {
+            const auto sine = 0.5f * std::sin ((float) i * 0.01f);
+            buffer.setSample (0, i, sine + 0.1f * (random.nextFloat() - 0.5f));
+            buffer.setSample (1, i, -sine);
+        }
+
+        return buffer;
+    }
+
+    static AudioBuffer<float> read (AudioFormatReader& reader, int64 start, int numSamples)
+    {
+        AudioBuffer<float> buffer (2, numSamples);
+        reader.read (&buffer, 0, numSamples, start, true, true);
+        return buffer;
+    }
+
+    const String extension;
+    const int bitsPerSample;
+};
+
+#if JUCE_USE_FLAC
+static MemoryMappedAudioFormatReaderTests<FlacAudioFormat> flacMemoryMappedReaderTests ("FLAC", ".flac", 16);
+#endif
+
+#if JUCE_USE_OGGVORBIS
+static MemoryMappedAudioFormatReaderTests<OggVorbisAudioFormat> oggVorbisMemoryMappedReaderTests ("Ogg-Vorbis", ".ogg", 32);
+#endif
+
+} // namespace juce
@@ -60,6 +60,7 @@
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
 #include "sampler/juce_Sampler.cpp"
+#include "sampler/juce_StreamingSampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
 #include "codecs/juce_FlacAudioFormat.cpp"
@@ -67,6 +68,11 @@
 #include "codecs/juce_OggVorbisAudioFormat.cpp"
 #include "codecs/juce_WavAudioFormat.cpp"
 #include "codecs/juce_LAMEEncoderAudioFormat.cpp"
+#include "format/juce_BatchAudioExporter.cpp" // uses some of the codecs' internals
+
+#if JUCE_UNIT_TESTS
+ #include "format/juce_MemoryMappedAudioFormatReader_test.cpp"
+#endif
 
 #if JucePlugin_Enable_ARA
  #include "juce_audio_processors/utilities/ARA/juce_ARADocumentControllerCommon.cpp"
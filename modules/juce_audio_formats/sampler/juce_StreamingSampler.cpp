@@ -0,0 +1,713 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/*  The FIFO that a SamplerDiskStreamer fills for one StreamingSamplerVoice.
+
+    The voice asks for a new sound to be streamed by posting a request, and ignores the
+    FIFO until a reader thread has acknowledged that request. The reader thread is the only
+    one that resets the FIFO, which it does while acknowledging, so there's never a reset
+    while the voice might be reading.
+
+    A request only holds a raw pointer to its sound, so the audio thread never changes a
+    sound's reference count. The voice keeps the sound alive until it has posted another
+    request, and the reader thread takes its own reference when it acknowledges the request,
+    so the sound can only be deleted by a reader thread or when the voice is deleted.
+*/
+class SamplerDiskStreamer::Stream
+{
+public:
+    Stream (int bufferSize, detail::Semaphore& workAvailableSignal)
+        : fifo (bufferSize), buffer (2, bufferSize), mask (bufferSize - 1), workAvailable (workAvailableSignal)
+    {
+        jassert (isPowerOfTwo (bufferSize));
+    }
+
+    //==============================================================================
+    // These are called by the voice, on the audio thread
+
+    // The sound must stay alive until the next call to start()
+    void start (StreamingSamplerSound* soundToStream, int64 startPosition)
+    {
+        {
+            const SpinLock::ScopedLockType sl (requestLock);
+            request.sound = soundToStream;
+            request.startPosition = startPosition;
+            request.generation = ++consumerGeneration;
+            requestedGeneration.store (consumerGeneration, std::memory_order_release);
+        }
+
+        streamPosition = startPosition;
+        numAvailable = 0;
+        workAvailable.signal();
+    }
+
+    // Discards any data before the given sample, and works out how much is available after it
+    void beginRead (int64 firstSampleNeeded)
+    {
+        numAvailable = 0;
+
+        if (acknowledgedGeneration.load (std::memory_order_acquire) != consumerGeneration)
+            return;
+
+        discardUpTo (firstSampleNeeded);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead (fifo.getNumReady(), start1, size1, start2, size2);
+        readIndex = start1;
+        numAvailable = size1 + size2;
+    }
+
+    float getSample (int channel, int64 sourcePosition) noexcept
+    {
+        const auto offset = sourcePosition - streamPosition;
+
+        if (! isPositiveAndBelow (offset, (int64) numAvailable))
+        {
+            hadUnderrun = true;
+            return 0.0f;
+        }
+
+        return buffer.getSample (channel, (readIndex + (int) offset) & mask);
+    }
+
+    // Frees up the space used by samples before the given one, and returns true if there was an underrun
+    bool endRead (int64 firstSampleNeeded)
+    {
+        if (numAvailable > 0 && discardUpTo (firstSampleNeeded) > 0)
+            workAvailable.signal();
+
+        numAvailable = 0;
+        return std::exchange (hadUnderrun, false);
+    }
+
+    //==============================================================================
+    // These are called by the reader threads, with the owner's lock held
+
+    // Returns how full the FIFO is, or nothing if it doesn't need any more data
+    std::optional<float> getFillLevel() const noexcept
+    {
+        if (requestedGeneration.load (std::memory_order_acquire) != generation)
+            return -1.0f; // a new request is the most urgent thing of all
+
+        if (sound == nullptr || readPosition >= endPosition || fifo.getFreeSpace() < minReadSize)
+            return {};
+
+        return (float) fifo.getNumReady() / (float) fifo.getTotalSize();
+    }
+
+    bool isClaimed = false, isWaitingForRelease = false;
+    WaitableEvent released;
+
+    //==============================================================================
+    // This is called by a reader thread that has claimed the stream
+
+    void service()
+    {
+        if (requestedGeneration.load (std::memory_order_acquire) != generation)
+        {
+            StreamingSamplerSound::Ptr previousSound; // so that it gets released outside the lock
+
+            {
+                const SpinLock::ScopedLockType sl (requestLock);
+                previousSound = std::move (sound);
+                sound = request.sound;
+                readPosition = request.startPosition;
+                generation = request.generation;
+            }
+
+            fifo.reset();
+            endPosition = sound != nullptr ? sound->getLengthInSamples() + 4 : 0;
+            acknowledgedGeneration.store (generation, std::memory_order_release);
+        }
+
+        if (sound == nullptr)
+            return;
+
+        const auto numToRead = (int) jmin ((int64) fifo.getFreeSpace(), endPosition - readPosition, (int64) maxReadSize);
+
+        if (numToRead <= 0)
+            return;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+        sound->readFromSource (buffer, start1, size1, readPosition);
+        sound->readFromSource (buffer, start2, size2, readPosition + size1);
+        fifo.finishedWrite (size1 + size2);
+        readPosition += size1 + size2;
+    }
+
+private:
+    int discardUpTo (int64 sample)
+    {
+        const auto numToDiscard = (int) jlimit ((int64) 0, (int64) fifo.getNumReady(), sample - streamPosition);
+        fifo.finishedRead (numToDiscard);
+        streamPosition += numToDiscard;
+        return numToDiscard;
+    }
+
+    static constexpr int minReadSize = 2048, maxReadSize = 16384;
+
+    AbstractFifo fifo;
+    AudioBuffer<float> buffer;
+    const int mask;
+    detail::Semaphore& workAvailable;
+
+    struct Request
+    {
+        StreamingSamplerSound* sound = nullptr;
+        int64 startPosition = 0;
+        uint32 generation = 0;
+    };
+
+    SpinLock requestLock;
+    Request request;
+    std::atomic<uint32> requestedGeneration { 0 }, acknowledgedGeneration { 0 };
+
+    // only used by the voice
+    uint32 consumerGeneration = 0;
+    int64 streamPosition = 0;
+    int readIndex = 0, numAvailable = 0;
+    bool hadUnderrun = false;
+
+    // only used by the reader threads
+    StreamingSamplerSound::Ptr sound;
+    int64 readPosition = 0, endPosition = 0;
+    uint32 generation = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Stream)
+};
+
+//==============================================================================
+class SamplerDiskStreamer::ReaderThread  : public Thread
+{
+public:
+    explicit ReaderThread (SamplerDiskStreamer& s)
+        : Thread ("Sampler disk streaming"), owner (s)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto* stream = owner.claimMostUrgentStream())
+            {
+                stream->service();
+                owner.releaseStream (stream);
+            }
+            else
+            {
+                owner.readerWentIdle.signal();
+                owner.workAvailable.wait();
+            }
+        }
+    }
+
+private:
+    SamplerDiskStreamer& owner;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReaderThread)
+};
+
+//==============================================================================
+SamplerDiskStreamer::SamplerDiskStreamer (int numThreads)
+{
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        threads.add (new ReaderThread (*this))->startThread (Thread::Priority::high);
+}
+
+SamplerDiskStreamer::~SamplerDiskStreamer()
+{
+    // All the voices that use this object must be deleted before it is!
+    jassert (streams.isEmpty());
+
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    // Any of the threads might be woken by each of these, so they must all have been told to exit first
+    for (int i = 0; i < threads.size(); ++i)
+        workAvailable.signal();
+
+    for (auto* t : threads)
+        t->stopThread (5000);
+}
+
+void SamplerDiskStreamer::waitUntilIdle()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (streamLock);
+
+            const auto isBusy = std::any_of (streams.begin(), streams.end(), [] (const Stream* stream)
+            {
+                return stream->isClaimed || stream->getFillLevel().has_value();
+            });
+
+            if (! isBusy)
+                return;
+        }
+
+        readerWentIdle.wait();
+    }
+}
+
+void SamplerDiskStreamer::addStream (Stream* stream)
+{
+    const ScopedLock sl (streamLock);
+    streams.add (stream);
+}
+
+void SamplerDiskStreamer::removeStream (Stream* stream)
+{
+    {
+        const ScopedLock sl (streamLock);
+        streams.removeFirstMatchingValue (stream);
+
+        if (! stream->isClaimed)
+            return;
+
+        stream->isWaitingForRelease = true;
+    }
+
+    // wait for the thread that's reading into this stream to finish
+    stream->released.wait();
+}
+
+SamplerDiskStreamer::Stream* SamplerDiskStreamer::claimMostUrgentStream()
+{
+    const ScopedLock sl (streamLock);
+    Stream* mostUrgent = nullptr;
+    float lowestFillLevel = 1.0f;
+
+    for (auto* stream : streams)
+    {
+        if (! stream->isClaimed)
+        {
+            if (auto fillLevel = stream->getFillLevel(); fillLevel.has_value() && *fillLevel < lowestFillLevel)
+            {
+                mostUrgent = stream;
+                lowestFillLevel = *fillLevel;
+            }
+        }
+    }
+
+    if (mostUrgent != nullptr)
+        mostUrgent->isClaimed = true;
+
+    return mostUrgent;
+}
+
+void SamplerDiskStreamer::releaseStream (Stream* stream)
+{
+    const ScopedLock sl (streamLock);
+    stream->isClaimed = false;
+
+    if (stream->isWaitingForRelease)
+        stream->released.signal();
+}
+
+//==============================================================================
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadLengthSeconds)
+    : name (soundName),
+      reader (std::move (source)),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (auto* mappedReader = dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()))
+        if (! mappedReader->mapEntireFile())
+            reader.reset();
+
+    if (reader != nullptr && reader->sampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        sourceSampleRate = reader->sampleRate;
+        length = reader->lengthInSamples;
+        preloadLength = (int) jlimit ((int64) 0, length, (int64) (preloadLengthSeconds * sourceSampleRate));
+
+        preload.setSize (jmin (2, (int) reader->numChannels), preloadLength + 4);
+        reader->read (&preload, 0, preloadLength + 4, 0, true, true);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+void StreamingSamplerSound::readFromSource (AudioBuffer<float>& dest, int startSample, int numSamples, int64 sourcePosition)
+{
+    if (numSamples > 0)
+    {
+        const ScopedLock sl (readerLock);
+        reader->read (&dest, startSample, numSamples, sourcePosition, true, true);
+    }
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SamplerDiskStreamer& streamer, int bufferSize)
+    : owner (streamer),
+      stream (std::make_unique<SamplerDiskStreamer::Stream> (nextPowerOfTwo (jmax (8192, bufferSize)), streamer.workAvailable))
+{
+    owner.addStream (stream.get());
+}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    owner.removeStream (stream.get());
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                        * sound->sourceSampleRate / getSampleRate();
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        adsr.noteOn();
+
+        // the start of the sample is already in memory, so the stream picks up where that ends
+        if (sound->preloadLength < sound->length)
+            stream->start (sound, sound->preloadLength);
+        else
+            stream->start (nullptr, 0);
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        stopPlaying();
+    }
+}
+
+void StreamingSamplerVoice::stopPlaying()
+{
+    // The stream needs the sound to stay alive until it has been given a new request
+    stream->start (nullptr, 0);
+    clearCurrentNote();
+    adsr.reset();
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        const auto& preload = playingSound->preload;
+        const auto preloadLength = (int64) playingSound->preloadLength;
+        const auto length = playingSound->length;
+        const auto isStereo = preload.getNumChannels() > 1;
+
+        const auto getSourceSample = [&] (int channel, int64 index)
+        {
+            if (index < preloadLength)
+                return preload.getSample (channel, (int) index);
+
+            if (index >= length)
+                return 0.0f;
+
+            return stream->getSample (channel, index);
+        };
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+        stream->beginRead ((int64) sourceSamplePosition);
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            auto alpha = (float) (sourceSamplePosition - (double) pos);
+            auto invAlpha = 1.0f - alpha;
+
+            // just using a very simple linear interpolation here..
+            float l = (getSourceSample (0, pos) * invAlpha + getSourceSample (0, pos + 1) * alpha);
+            float r = isStereo ? (getSourceSample (1, pos) * invAlpha + getSourceSample (1, pos + 1) * alpha)
+                               : l;
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > (double) length || ! adsr.isActive())
+            {
+                stopPlaying();
+                break;
+            }
+        }
+
+        if (stream->endRead ((int64) sourceSamplePosition))
+            ++owner.numUnderruns;
+    }
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class StreamingSamplerTests  : public UnitTest
+{
+public:
+    StreamingSamplerTests()
+        : UnitTest ("Streaming sampler", UnitTestCategories::audio) {}
+
+    void runTest() override
+    {
+        const auto wavData = createTestFile();
+
+        beginTest ("Streamed output matches the in-memory sampler");
+        {
+            SamplerDiskStreamer streamer;
+
+            for (auto note : { 60, 67, 48 })
+            {
+                const auto expected = render (std::make_unique<SamplerVoice>(), createSamplerSound (wavData), note);
+                const auto streamed = render (std::make_unique<StreamingSamplerVoice> (streamer),
+                                              new StreamingSamplerSound ("test", createReader (wavData), getAllNotes(), 60, 0.0, 0.0, 0.1),
+                                              note, &streamer);
+
+                expect (getMaxDifference (streamed, expected) < 1.0e-6f);
+            }
+
+            expectEquals (streamer.getNumUnderruns(), 0);
+        }
+
+        beginTest ("Sounds that fit in the preload are played from memory");
+        {
+            SamplerDiskStreamer streamer;
+            StreamingSamplerSound::Ptr sound = new StreamingSamplerSound ("test", createReader (wavData), getAllNotes(), 60, 0.0, 0.0, 10.0);
+            expectEquals ((int64) sound->getPreloadedData().getNumSamples(), sound->getLengthInSamples() + 4);
+
+            const auto expected = render (std::make_unique<SamplerVoice>(), createSamplerSound (wavData), 60);
+            const auto streamed = render (std::make_unique<StreamingSamplerVoice> (streamer), sound.get(), 60, &streamer);
+            expect (getMaxDifference (streamed, expected) < 1.0e-6f);
+            expectEquals (streamer.getNumUnderruns(), 0);
+        }
+
+        beginTest ("Voices output silence rather than waiting for the disk");
+        {
+            SamplerDiskStreamer streamer (1);
+            auto* reader = new BlockingReader (createReader (wavData));
+            StreamingSamplerSound::Ptr sound = new StreamingSamplerSound ("test", std::unique_ptr<AudioFormatReader> (reader),
+                                                                          getAllNotes(), 60, 0.0, 0.0, 0.005);
+            reader->isBlocked = true;
+
+            Synthesiser synth;
+            synth.addVoice (new StreamingSamplerVoice (streamer));
+            synth.addSound (sound.get());
+            synth.setCurrentPlaybackSampleRate (44100.0);
+
+            AudioBuffer<float> output (2, blockSize);
+            output.clear();
+
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+            synth.renderNextBlock (output, midi, 0, blockSize);
+
+            const auto preloadLength = sound->getPreloadedData().getNumSamples() - 4;
+            expect (output.getMagnitude (0, 0, preloadLength) > 0.0f);
+            expectEquals (output.getMagnitude (0, preloadLength, blockSize - preloadLength), 0.0f);
+            expect (streamer.getNumUnderruns() > 0);
+
+            reader->allowReads.signal();
+        }
+    }
+
+private:
+    static constexpr int blockSize = 512, numTestSamples = 44100;
+
+    // Stands in for a disk that has stalled, until it's told to carry on
+    struct BlockingReader  : public AudioFormatReader
+    {
+        explicit BlockingReader (std::unique_ptr<AudioFormatReader> r)
+            : AudioFormatReader (nullptr, r->getFormatName()), source (std::move (r))
+        {
+            sampleRate = source->sampleRate;
+            bitsPerSample = source->bitsPerSample;
+            lengthInSamples = source->lengthInSamples;
+            numChannels = source->numChannels;
+            usesFloatingPointData = source->usesFloatingPointData;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            if (isBlocked)
+                allowReads.wait();
+
+            return source->readSamples (destChannels, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+        }
+
+        std::unique_ptr<AudioFormatReader> source;
+        std::atomic<bool> isBlocked { false };
+        WaitableEvent allowReads { true };
+    };
+
+    static MemoryBlock createTestFile()
+    {
+        AudioBuffer<float> signal (2, numTestSamples);
+        Random random (42);
+
+        for (int i = 0; i < numTestSamples; ++i)
+        {
+            signal.setSample (0, i, 0.5f * std::sin ((float) i * 0.03f));
+            signal.setSample (1, i, random.nextFloat() - 0.5f);
+        }
+
+        MemoryBlock block;
+
+        {
+            WavAudioFormat format;
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (block, false),
+                                                                               44100.0, 2, 24, {}, 0));
+            writer->writeFromAudioSampleBuffer (signal, 0, numTestSamples);
+        }
+
+        return block;
+    }
+
+    static std::unique_ptr<AudioFormatReader> createReader (const MemoryBlock& wavData)
+    {
+        return std::unique_ptr<AudioFormatReader> (WavAudioFormat().createReaderFor (new MemoryInputStream (wavData, false), true));
+    }
+
+    static BigInteger getAllNotes()
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+        return notes;
+    }
+
+    static SynthesiserSound* createSamplerSound (const MemoryBlock& wavData)
+    {
+        return new SamplerSound ("test", *createReader (wavData), getAllNotes(), 60, 0.0, 0.0, 10.0);
+    }
+
+    // Renders a note, letting the disk streamer catch up between blocks
+    static AudioBuffer<float> render (std::unique_ptr<SynthesiserVoice> voice, SynthesiserSound* sound, int note,
+                                      SamplerDiskStreamer* streamer = nullptr)
+    {
+        Synthesiser synth;
+        synth.addVoice (voice.release());
+        synth.addSound (sound);
+        synth.setCurrentPlaybackSampleRate (44100.0);
+
+        AudioBuffer<float> result (2, 2 * numTestSamples);
+        result.clear();
+
+        for (int pos = 0; pos < result.getNumSamples(); pos += blockSize)
+        {
+            MidiBuffer midi;
+
+            if (pos == 0)
+                midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), 0);
+
+            const auto numThisTime = jmin (blockSize, result.getNumSamples() - pos);
+            AudioBuffer<float> block (result.getArrayOfWritePointers(), 2, pos, numThisTime);
+            synth.renderNextBlock (block, midi, 0, numThisTime);
+
+            if (streamer != nullptr)
+                streamer->waitUntilIdle();
+        }
+
+        return result;
+    }
+
+    // The two voices interpolate in the same way, but the compiler may not evaluate it in the same way
+    static float getMaxDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        float result = 0;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return result;
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,242 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of background threads that stream sample data from disk for a set of
+    StreamingSamplerVoice objects.
+
+    Each voice owns a lock-free FIFO, and whenever a voice starts playing a
+    StreamingSamplerSound, the threads in this pool begin filling its FIFO from the
+    sound's AudioFormatReader. The threads always service the voice whose FIFO is
+    emptiest first, so that voices that are close to running out of data get priority.
+
+    One pool can be shared by any number of voices, in any number of Synthesisers, and
+    it must outlive all of them.
+
+    @see StreamingSamplerVoice, StreamingSamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerDiskStreamer
+{
+public:
+    //==============================================================================
+    /** Creates a pool with the given number of reader threads. */
+    explicit SamplerDiskStreamer (int numThreads = 2);
+
+    /** Destructor. All the voices that use this pool must have been deleted first. */
+    ~SamplerDiskStreamer();
+
+    //==============================================================================
+    /** Returns the number of audio blocks in which a voice ran out of data because the
+        disk couldn't keep up.
+
+        When this happens, the voice outputs silence until the data arrives. If this count
+        keeps going up, try a longer preload time, or larger voice buffers.
+    */
+    int getNumUnderruns() const noexcept                    { return numUnderruns; }
+
+    /** Blocks until the reader threads have nothing left to do.
+
+        When this returns, every voice's stream has started reading the sound that the voice
+        most recently asked for, and its FIFO is either full or holds the rest of the sound.
+        This is useful when rendering offline, where you can call it between blocks so that
+        the voices never run out of data.
+    */
+    void waitUntilIdle();
+
+    /** @internal */
+    class Stream;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+    class ReaderThread;
+
+    void addStream (Stream*);
+    void removeStream (Stream*);
+    Stream* claimMostUrgentStream();
+    void releaseStream (Stream*);
+
+    CriticalSection streamLock;
+    Array<Stream*> streams;
+    OwnedArray<ReaderThread> threads;
+    detail::Semaphore workAvailable;
+    WaitableEvent readerWentIdle;
+    std::atomic<int> numUnderruns { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerDiskStreamer)
+};
+
+//==============================================================================
+/**
+    A sampled sound that only keeps the start of its audio in memory, and streams
+    the rest from disk while it plays.
+
+    This is used like a SamplerSound, but the sound keeps hold of the AudioFormatReader
+    and loads only the first few milliseconds of the sample when it is created. This lets
+    you play libraries that would be far too large to load into memory. For the fastest
+    streaming, give it a MemoryMappedAudioFormatReader where the format supports one.
+
+    It must be played by StreamingSamplerVoice objects.
+
+    @see StreamingSamplerVoice, SamplerDiskStreamer, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streaming sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the reader to stream the audio from. If this is a
+                            MemoryMappedAudioFormatReader, the whole file will be mapped
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadLengthSeconds     the length of audio to load into memory, in seconds.
+                                        This must be long enough to cover the time that it
+                                        takes for a voice's stream to start
+    */
+    StreamingSamplerSound (const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadLengthSeconds = 0.25);
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    /** A pointer type for StreamingSamplerSound objects. */
+    using Ptr = ReferenceCountedObjectPtr<StreamingSamplerSound>;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                  { return name; }
+
+    /** Returns the length of the whole sample. */
+    int64 getLengthInSamples() const noexcept               { return length; }
+
+    /** Returns the part of the sample that is kept in memory. */
+    const AudioBuffer<float>& getPreloadedData() const noexcept     { return preload; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+    friend class SamplerDiskStreamer;
+
+    void readFromSource (AudioBuffer<float>&, int startSample, int numSamples, int64 sourcePosition);
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    AudioBuffer<float> preload;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    A subclass of SynthesiserVoice that plays a StreamingSamplerSound.
+
+    Each voice reads the start of the sample from memory, while a SamplerDiskStreamer
+    fills the voice's FIFO with the rest of it from disk. The audio thread never waits
+    for the disk. If the data hasn't arrived in time, the voice outputs silence and
+    the underrun is counted by the SamplerDiskStreamer.
+
+    @see StreamingSamplerSound, SamplerDiskStreamer, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice that uses the given pool of reader threads.
+
+        The bufferSize is the number of samples that the voice's FIFO can hold, and will be
+        rounded up to a power of two. The pool will try to keep it full, so it needs to hold
+        enough audio to cover the longest delay you expect from the disk, at the highest
+        pitch that you'll play the sound at.
+    */
+    explicit StreamingSamplerVoice (SamplerDiskStreamer& streamer, int bufferSize = 32768);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    void stopPlaying();
+
+    SamplerDiskStreamer& owner;
+    std::unique_ptr<SamplerDiskStreamer::Stream> stream;
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+
+    ADSR adsr;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
@@ -1084,6 +1084,48 @@ public:
     // (Note that this isn't marked 'override' in case older versions of the SDK don't include it)
     bool CanScheduleParameters() const override          { return false; }
 
+    // Scheduled events arrive on the render thread just before the Render call that they
+    // belong to, so this is where their offsets get recorded for the processor.
+    ComponentResult ScheduleParameter (const AudioUnitParameterEvent* inParameterEvent, UInt32 inNumEvents) override
+    {
+        if (juceFilter != nullptr)
+        {
+            auto& queue = juceFilter->getParameterChanges();
+
+            for (UInt32 i = 0; i < inNumEvents; ++i)
+            {
+                const auto& event = inParameterEvent[i];
+
+                if (event.scope != kAudioUnitScope_Global)
+                    continue;
+
+                if (auto* param = getParameterForAUParameterID (event.parameter))
+                {
+                    const auto index = param->getParameterIndex();
+                    const auto maximum = getMaximumParameterValue (param);
+
+                    if (event.eventType == kParameterEvent_Immediate)
+                    {
+                        const auto& immediate = event.eventValues.immediate;
+                        queue.addStep (index, (int) immediate.bufferOffset, immediate.value / maximum);
+                    }
+                    else if (event.eventType == kParameterEvent_Ramped)
+                    {
+                        const auto& ramp = event.eventValues.ramp;
+                        queue.addStep  (index, (int) ramp.startBufferOffset, ramp.startValue / maximum);
+                        queue.addPoint (index, (int) ramp.startBufferOffset + (int) ramp.durationInFrames, ramp.endValue / maximum);
+
+                        // The base class only applies immediate events, so make sure the parameter
+                        // still ends up at the end of the ramp
+                        SetParameter (event.parameter, event.scope, event.element, ramp.endValue, 0);
+                    }
+                }
+            }
+        }
+
+        return MusicDeviceBase::ScheduleParameter (inParameterEvent, inNumEvents);
+    }
+
     //==============================================================================
     bool SupportsTail() override                         { return true; }
     Float64 GetTailTime() override                       { return juceFilter->getTailLengthSeconds(); }
@@ -2074,6 +2116,8 @@ private:
         {
             juceFilter->processBlock (buffer, midiBuffer);
         }
+
+        juceFilter->getParameterChanges().clear();
     }
 
     void pushMidiOutput ([[maybe_unused]] UInt32 nFrames) noexcept
@@ -135,7 +135,7 @@ public:
         return ttlSanitised;
     }
 
-    void setValueFromHost (LV2_URID urid, float value) noexcept
+    void setValueFromHost (LV2_URID urid, float value, ParameterChangeQueue& changes, int sampleOffset) noexcept
     {
         const auto it = uridToIndexMap.find (urid);
 
@@ -158,6 +158,8 @@ public:
 
             if (! approximatelyEqual (scaledValue, param->getValue()))
             {
+                changes.addStep (param->getParameterIndex(), sampleOffset, scaledValue);
+
                 ScopedValueSetter<bool> scope (ignoreCallbacks, true);
                 param->setValueNotifyingHost (scaledValue);
             }
@@ -522,6 +524,7 @@ public:
         jassert (static_cast<int> (numSteps) <= processor->getBlockSize());
 
         midi.clear();
+        processor->getParameterChanges().clear();
         playHead.invalidate();
         audio.setSize (audio.getNumChannels(), static_cast<int> (numSteps), true, false, true);
 
@@ -529,20 +532,21 @@ public:
         {
             struct Callback
             {
-                explicit Callback (LV2PluginInstance& s) : self (s) {}
+                Callback (LV2PluginInstance& s, int offset) : self (s), sampleOffset (offset) {}
 
                 void setParameter (LV2_URID property, float value) const noexcept
                 {
-                    self.parameters.setValueFromHost (property, value);
+                    self.parameters.setValueFromHost (property, value, self.processor->getParameterChanges(), sampleOffset);
                 }
 
                 // The host probably shouldn't send us 'touched' messages.
                 void gesture (LV2_URID, bool) const noexcept {}
 
                 LV2PluginInstance& self;
+                int sampleOffset;
             };
 
-            patchSetHelper.processPatchSet (event, Callback { *this });
+            patchSetHelper.processPatchSet (event, Callback { *this, static_cast<int> (event->time.frames) });
 
             playHead.readNewInfo (event);
 
@@ -3501,9 +3501,18 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    auto& queue = pluginInstance->getParameterChanges();
+                    const auto parameterIndex = param->getParameterIndex();
+
+                    for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                    {
+                        if (const auto change = getPointFromQueue (paramQueue, point))
+                            queue.addPoint (parameterIndex, change->offsetSamples, (float) change->value);
+                    }
+
+                    if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                         setValueAndNotifyIfChanged (*param, (float) change->value);
                 }
             }
@@ -3556,6 +3565,7 @@ public:
         }
 
         midiBuffer.clear();
+        pluginInstance->getParameterChanges().clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -368,6 +368,7 @@ void AudioProcessor::setRateAndBufferSizeDetails (double newSampleRate, int newB
 {
     currentSampleRate = newSampleRate;
     blockSize = newBlockSize;
+    parameterChanges.prepare (flatParameterList);
 }
 
 //==============================================================================
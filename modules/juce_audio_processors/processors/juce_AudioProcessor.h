@@ -727,6 +727,33 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    //==============================================================================
+    /** Returns the sample-accurate parameter changes for the block that is currently
+        being processed.
+
+        Your processor's parameters will already have been set to the last value that
+        the host sent for this block, but if the host supplied any timestamped changes
+        or automation ramps, they can be found in this queue. The parameter indices used
+        by the queue are the indices into the array returned by getParameters().
+
+        As with getPlayHead(), you should only call this from your processBlock() method,
+        because the contents of the queue only describe the block that is currently
+        being processed, and the plugin wrapper or host will clear it between blocks.
+
+        The queue is allocated by setRateAndBufferSizeDetails(), so a host that wants to
+        send sample-accurate changes to a processor can add points to it before calling
+        processBlock().
+
+        @see ParameterChangeQueue
+    */
+    ParameterChangeQueue& getParameterChanges() noexcept                { return parameterChanges; }
+
+    /** Returns the sample-accurate parameter changes for the block that is currently
+        being processed.
+        @see ParameterChangeQueue
+    */
+    const ParameterChangeQueue& getParameterChanges() const noexcept    { return parameterChanges; }
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1528,6 +1555,7 @@ private:
 
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
+    ParameterChangeQueue parameterChanges;
 
     AudioProcessorParameter* getParamChecked (int) const;
 
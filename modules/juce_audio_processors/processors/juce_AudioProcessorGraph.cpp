@@ -548,6 +548,23 @@ struct GraphRenderSequence
         currentMidiInputBuffer = &midiMessages;
         currentMidiOutputBuffer.clear();
 
+        if (parallelJob != nullptr)
+        {
+            // Processors may query the play head from any of the worker threads, so they're
+            // given a snapshot of the position that was taken here, on the audio thread.
+            playHeadSnapshot.update (audioPlayHead);
+
+            const Context context { { *currentAudioInputBuffer,
+                                      currentAudioOutputBuffer,
+                                      *currentMidiInputBuffer,
+                                      currentMidiOutputBuffer },
+                                    audioPlayHead != nullptr ? &playHeadSnapshot : nullptr,
+                                    numSamples };
+
+            parallelJob->prepareToRun (context);
+            workers->perform (*parallelJob);
+        }
+        else
         {
             const Context context { { *currentAudioInputBuffer,
                                       currentAudioOutputBuffer,
@@ -590,7 +607,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), {}, { audioResource (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -615,7 +632,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { audioResource (srcIndex) }, { audioResource (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -640,7 +657,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { audioResource (srcIndex) }, { audioResource (dstIndex) });
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -665,7 +682,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addOp (std::make_unique<ClearOp> (index), {}, { midiResource (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -690,7 +707,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { midiResource (srcIndex) }, { midiResource (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -715,7 +732,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addOp (std::make_unique<AddOp> (srcIndex, dstIndex), { midiResource (srcIndex) }, { midiResource (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
@@ -754,7 +771,7 @@ struct GraphRenderSequence
             int readIndex = 0, writeIndex;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        addOp (std::make_unique<DelayChannelOp> (chan, delaySize), {}, { audioResource (chan) });
     }
 
     void addProcessOp (const Node::Ptr& node,
@@ -762,6 +779,14 @@ struct GraphRenderSequence
                        int totalNumChans,
                        int midiBuffer)
     {
+        std::vector<int> reads, writes { midiResource (midiBuffer) };
+
+        // When rendering in parallel, each node gets its own scratch channels in place of the
+        // shared empty buffer (see RenderOp::useScratchForEmptyChannels), so it isn't a dependency
+        for (auto index : audioChannelsUsed)
+            if (index != readOnlyEmptyBufferIndex)
+                writes.push_back (audioResource (index));
+
         auto op = [&]() -> std::unique_ptr<NodeOp>
         {
             if (auto* ioNode = dynamic_cast<const AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()))
@@ -769,15 +794,19 @@ struct GraphRenderSequence
                 switch (ioNode->getType())
                 {
                     case AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode:
+                        reads.push_back (globalAudioIn);
                         return std::make_unique<AudioInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode:
+                        writes.push_back (globalAudioOut);
                         return std::make_unique<AudioOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiInputNode:
+                        reads.push_back (globalMidiIn);
                         return std::make_unique<MidiInOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
 
                     case AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode:
+                        writes.push_back (globalMidiOut);
                         return std::make_unique<MidiOutOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
                 }
             }
@@ -785,10 +814,10 @@ struct GraphRenderSequence
             return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        addOp (std::move (op), std::move (reads), std::move (writes));
     }
 
-    void prepareBuffers (int blockSize)
+    void prepareBuffers (int blockSize, RealtimeWorkerGroup* workersToUse)
     {
         renderingBuffer.setSize (numBuffersNeeded + 1, blockSize);
         renderingBuffer.clear();
@@ -809,8 +838,25 @@ struct GraphRenderSequence
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
 
+        workers = workersToUse;
+        const auto renderInParallel = workers != nullptr && workers->getNumWorkerThreads() > 0 && renderOps.size() > 1;
+
         for (const auto& op : renderOps)
+        {
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
+
+            // Nodes running at the same time mustn't share the empty buffer, because a processor
+            // that writes into its unused channels would be racing with the others
+            if (renderInParallel)
+                op->useScratchForEmptyChannels (blockSize);
+        }
+
+        // The job keeps a reference to this sequence, so it can only be created once the sequence
+        // has reached its final location.
+        if (renderInParallel)
+            parallelJob = std::make_unique<ParallelRenderJob> (*this);
+        else
+            parallelJob.reset();
     }
 
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
@@ -825,12 +871,24 @@ struct GraphRenderSequence
     MidiBuffer midiChunk;
 
 private:
+    //==============================================================================
+    /*  Every op declares the buffers that it reads and writes, so that the ops can be arranged
+        into a dependency graph for parallel rendering. Audio buffers map to even resource IDs,
+        MIDI buffers to odd IDs, and the graph's own inputs and outputs to negative IDs.
+    */
+    enum { readOnlyEmptyBufferIndex = 0 };
+    enum { globalAudioIn = -1, globalAudioOut = -2, globalMidiIn = -3, globalMidiOut = -4 };
+
+    static int audioResource (int index) { return index * 2; }
+    static int midiResource  (int index) { return index * 2 + 1; }
+
     //==============================================================================
     struct RenderOp
     {
         virtual ~RenderOp() = default;
         virtual void prepare (FloatType* const*, MidiBuffer*) = 0;
         virtual void process (const Context&) = 0;
+        virtual void useScratchForEmptyChannels (int /*blockSize*/) {}
     };
 
     struct NodeOp : public RenderOp
@@ -855,12 +913,28 @@ private:
                 audioChannels[i] = renderBuffer[audioChannelsToUse.getUnchecked ((int) i)];
 
             midiBuffer = buffers + midiBufferToUse;
+            scratchChannels.setSize (0, 0);
+        }
+
+        void useScratchForEmptyChannels (int blockSize) final
+        {
+            const auto numEmpty = (int) std::count (audioChannelsToUse.begin(), audioChannelsToUse.end(), (int) readOnlyEmptyBufferIndex);
+            scratchChannels.setSize (numEmpty, blockSize);
+
+            for (int i = 0, scratchIndex = 0; i < (int) audioChannels.size(); ++i)
+                if (audioChannelsToUse.getUnchecked (i) == readOnlyEmptyBufferIndex)
+                    audioChannels[(size_t) i] = scratchChannels.getWritePointer (scratchIndex++);
         }
 
         void process (const Context& c) final
         {
             processor.setPlayHead (c.audioPlayHead);
 
+            // the processor may have written into its scratch channels last time round. These are
+            // written through raw pointers, so the buffer's own isClear flag can't be trusted here.
+            for (int i = 0; i < scratchChannels.getNumChannels(); ++i)
+                FloatVectorOperations::clear (scratchChannels.getWritePointer (i), c.numSamples);
+
             auto numAudioChannels = [this]
             {
                 if (const auto* proc = node->getProcessor())
@@ -891,6 +965,7 @@ private:
 
         Array<int> audioChannelsToUse;
         std::vector<FloatType*> audioChannels;
+        AudioBuffer<FloatType> scratchChannels;
         const int midiBufferToUse;
     };
 
@@ -938,6 +1013,9 @@ private:
                 p.processBlockBypassed (audio, midi);
             else
                 p.processBlock (audio, midi);
+
+            // Any changes that the host queued up for this node only apply to this block
+            p.getParameterChanges().clear();
         }
 
         AudioBuffer<float> tempBufferFloat, tempBufferDouble;
@@ -993,7 +1071,208 @@ private:
         }
     };
 
+    //==============================================================================
+    struct OpResources
+    {
+        std::vector<int> reads, writes;
+    };
+
+    //==============================================================================
+    /*  Hands out a fixed play head position to processors running on the worker threads. */
+    struct PlayHeadSnapshot  : public AudioPlayHead
+    {
+        void update (AudioPlayHead* s)
+        {
+            source = s;
+            position = source != nullptr ? source->getPosition() : nullopt;
+        }
+
+        Optional<PositionInfo> getPosition() const override { return position; }
+
+        bool canControlTransport() override                 { return source != nullptr && source->canControlTransport(); }
+        void transportPlay (bool shouldPlay) override       { if (source != nullptr) source->transportPlay (shouldPlay); }
+        void transportRecord (bool shouldRecord) override   { if (source != nullptr) source->transportRecord (shouldRecord); }
+        void transportRewind() override                     { if (source != nullptr) source->transportRewind(); }
+
+        AudioPlayHead* source = nullptr;
+        Optional<PositionInfo> position;
+    };
+
+    //==============================================================================
+    /*  Runs the render ops on a RealtimeWorkerGroup, starting each op as soon as all of the ops
+        it depends on have finished.
+
+        Ops are pushed onto a queue as they become ready. Each thread claims the next slot in the
+        queue, waits for that slot to be filled if necessary, and then runs the op. Because every
+        op is pushed exactly once, all threads stop claiming slots once every op has been claimed.
+    */
+    struct ParallelRenderJob  : public RealtimeWorkerGroup::Job
+    {
+        explicit ParallelRenderJob (GraphRenderSequence& s)
+            : sequence (s),
+              numOps ((int) s.renderOps.size()),
+              remainingDependencies ((size_t) numOps),
+              readyQueue ((size_t) numOps)
+        {
+            const auto numDependencies = createDependencyGraph (s.renderOpResources, dependents);
+
+            for (int i = 0; i < numOps; ++i)
+            {
+                if (numDependencies[(size_t) i] == 0)
+                    initialOps.push_back (i);
+
+                initialDependencyCounts.push_back (numDependencies[(size_t) i]);
+            }
+        }
+
+        /*  Call from the audio thread before handing the job to the workers. */
+        void prepareToRun (const Context& c)
+        {
+            context = &c;
+
+            for (size_t i = 0; i < (size_t) numOps; ++i)
+            {
+                remainingDependencies[i].store (initialDependencyCounts[i], std::memory_order_relaxed);
+                readyQueue[i].store (-1, std::memory_order_relaxed);
+            }
+
+            readIndex.store (0);
+            writeIndex.store (0);
+
+            for (auto op : initialOps)
+                push (op);
+        }
+
+        void run (int) override
+        {
+            for (;;)
+            {
+                auto slot = readIndex.load();
+
+                do
+                {
+                    if (slot >= numOps)
+                        return;
+                }
+                while (! readIndex.compare_exchange_weak (slot, slot + 1));
+
+                auto opIndex = readyQueue[(size_t) slot].load (std::memory_order_acquire);
+
+                while (opIndex < 0)
+                {
+                    Thread::yield();
+                    opIndex = readyQueue[(size_t) slot].load (std::memory_order_acquire);
+                }
+
+                sequence.renderOps[(size_t) opIndex]->process (*context);
+
+                for (auto dependent : dependents[(size_t) opIndex])
+                    if (remainingDependencies[(size_t) dependent].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                        push (dependent);
+            }
+        }
+
+        void push (int opIndex)
+        {
+            readyQueue[(size_t) writeIndex.fetch_add (1)].store (opIndex, std::memory_order_release);
+        }
+
+        /*  Works out which ops must finish before each op may start, by tracking the last writer
+            and the readers since that write for each resource. Returns the number of ops that
+            each op depends on, and fills in the list of dependents for each op.
+        */
+        static std::vector<int> createDependencyGraph (const std::vector<OpResources>& resources,
+                                                       std::vector<std::vector<int>>& dependentsOut)
+        {
+            struct ResourceState
+            {
+                int lastWriter = -1;
+                std::vector<int> readersSinceWrite;
+            };
+
+            std::map<int, ResourceState> states;
+            std::vector<int> numDependencies (resources.size(), 0);
+            dependentsOut.assign (resources.size(), {});
+
+            for (size_t i = 0; i < resources.size(); ++i)
+            {
+                const auto opIndex = (int) i;
+                std::set<int> dependencies;
+
+                for (auto r : resources[i].reads)
+                    if (const auto writer = states[r].lastWriter; writer >= 0)
+                        dependencies.insert (writer);
+
+                for (auto w : resources[i].writes)
+                {
+                    auto& state = states[w];
+
+                    if (state.lastWriter >= 0)
+                        dependencies.insert (state.lastWriter);
+
+                    dependencies.insert (state.readersSinceWrite.begin(), state.readersSinceWrite.end());
+                }
+
+                for (auto r : resources[i].reads)
+                    states[r].readersSinceWrite.push_back (opIndex);
+
+                for (auto w : resources[i].writes)
+                {
+                    auto& state = states[w];
+                    state.lastWriter = opIndex;
+                    state.readersSinceWrite.clear();
+                }
+
+                dependencies.erase (opIndex);
+
+                for (auto d : dependencies)
+                    dependentsOut[(size_t) d].push_back (opIndex);
+
+                numDependencies[i] = (int) dependencies.size();
+            }
+
+            return numDependencies;
+        }
+
+        GraphRenderSequence& sequence;
+        const int numOps;
+        const Context* context = nullptr;
+
+        std::vector<std::vector<int>> dependents;
+        std::vector<int> initialDependencyCounts, initialOps;
+
+        std::vector<std::atomic<int>> remainingDependencies, readyQueue;
+        std::atomic<int> readIndex { 0 }, writeIndex { 0 };
+    };
+
+    void addOp (std::unique_ptr<RenderOp> op, std::vector<int> reads, std::vector<int> writes)
+    {
+        const auto sortAndRemoveDuplicates = [] (auto& v)
+        {
+            std::sort (v.begin(), v.end());
+            v.erase (std::unique (v.begin(), v.end()), v.end());
+        };
+
+        sortAndRemoveDuplicates (writes);
+        sortAndRemoveDuplicates (reads);
+
+        // Anything that's written is treated as a read too, so it doesn't need listing twice
+        reads.erase (std::remove_if (reads.begin(), reads.end(), [&] (auto r)
+                                     {
+                                         return std::binary_search (writes.begin(), writes.end(), r);
+                                     }),
+                     reads.end());
+
+        renderOps.push_back (std::move (op));
+        renderOpResources.push_back ({ std::move (reads), std::move (writes) });
+    }
+
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<OpResources> renderOpResources;
+
+    RealtimeWorkerGroup* workers = nullptr;
+    std::unique_ptr<ParallelRenderJob> parallelJob;
+    PlayHeadSnapshot playHeadSnapshot;
 };
 
 //==============================================================================
@@ -1517,10 +1796,15 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    std::shared_ptr<RealtimeWorkerGroup> w)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c)
+                              : RenderSequenceBuilder::build<double> (n, c),
+                          std::move (w))
     {
     }
 
@@ -1545,14 +1829,17 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<RealtimeWorkerGroup> w)
+        : settings (s), sequence (std::move (built)), workers (std::move (w))
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize, workers.get()); });
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+
+    // Shared with the graph, so that the workers outlive any sequence that might still be using them
+    std::shared_ptr<RealtimeWorkerGroup> workers;
 };
 
 //==============================================================================
@@ -1849,6 +2136,26 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumParallelRenderThreads (int numThreads)
+    {
+        numThreads = jmax (0, numThreads);
+
+        if (numThreads == getNumParallelRenderThreads())
+            return;
+
+        renderWorkers = numThreads > 0 ? std::make_shared<RealtimeWorkerGroup> (numThreads) : nullptr;
+
+        // The render sequence holds on to the workers, so it must be rebuilt even though the
+        // topology hasn't changed
+        lastBuiltSequence.reset();
+        rebuild (UpdateKind::sync);
+    }
+
+    int getNumParallelRenderThreads() const
+    {
+        return renderWorkers != nullptr ? renderWorkers->getNumWorkerThreads() : 0;
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1907,7 +2214,7 @@ private:
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, renderWorkers);
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1927,6 +2234,7 @@ private:
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
+    std::shared_ptr<RealtimeWorkerGroup> renderWorkers;
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
 };
 
@@ -1956,6 +2264,8 @@ void AudioProcessorGraph::releaseResources()
 bool AudioProcessorGraph::removeIllegalConnections (UpdateKind updateKind)                                  { return pimpl->removeIllegalConnections (updateKind); }
 void AudioProcessorGraph::rebuild()                                                                         { return pimpl->rebuild (UpdateKind::sync); }
 void AudioProcessorGraph::reset()                                                                           { return pimpl->reset(); }
+void AudioProcessorGraph::setNumParallelRenderThreads (int numThreads)                                      { return pimpl->setNumParallelRenderThreads (numThreads); }
+int AudioProcessorGraph::getNumParallelRenderThreads() const                                                { return pimpl->getNumParallelRenderThreads(); }
 bool AudioProcessorGraph::canConnect (const Connection& c) const                                            { return pimpl->canConnect (c); }
 bool AudioProcessorGraph::isConnected (const Connection& c) const noexcept                                  { return pimpl->isConnected (c); }
 bool AudioProcessorGraph::isConnected (NodeID a, NodeID b) const noexcept                                   { return pimpl->isConnected (a, b); }
@@ -2240,6 +2550,97 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("parallel rendering produces the same output as serial rendering");
+        {
+            const auto render = [] (int numThreads)
+            {
+                AudioProcessorGraph graph;
+                graph.setNumParallelRenderThreads (numThreads);
+                graph.setPlayConfigDetails (2, 2, 44100.0, 256);
+
+                using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+                const auto audioIn  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+                const auto audioOut = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+                const auto midiIn   = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::midiInputNode))->nodeID;
+                const auto midiOut  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::midiOutputNode))->nodeID;
+
+                constexpr auto numChains = 8;
+                constexpr auto chainLength = 4;
+
+                for (auto chain = 0; chain < numChains; ++chain)
+                {
+                    auto previous = audioIn;
+                    auto previousMidi = midiIn;
+
+                    for (auto step = 0; step < chainLength; ++step)
+                    {
+                        const auto index = chain * chainLength + step;
+                        const auto node = graph.addNode (std::make_unique<GainAndOffsetProcessor> (index, index % 3))->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            graph.addConnection ({ { previous, channel }, { node, channel } });
+
+                        graph.addConnection ({ { previousMidi, midiChannel }, { node, midiChannel } });
+                        previous = previousMidi = node;
+                    }
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        graph.addConnection ({ { previous, channel }, { audioOut, channel } });
+
+                    graph.addConnection ({ { previous, midiChannel }, { midiOut, midiChannel } });
+                }
+
+                graph.prepareToPlay (44100.0, 256);
+
+                AudioBuffer<float> result (2, 256 * 8);
+                AudioBuffer<float> block (2, 256);
+                std::vector<MidiMessage> midiResult;
+                MidiBuffer midi;
+
+                for (auto blockIndex = 0; blockIndex < 8; ++blockIndex)
+                {
+                    for (auto channel = 0; channel < 2; ++channel)
+                        for (auto sample = 0; sample < block.getNumSamples(); ++sample)
+                            block.setSample (channel, sample, std::sin ((float) (blockIndex * 256 + sample) * 0.01f * (float) (channel + 1)));
+
+                    midi.clear();
+                    midi.addEvent (MidiMessage::noteOn (1, blockIndex, 0.5f), blockIndex);
+
+                    graph.processBlock (block, midi);
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        result.copyFrom (channel, blockIndex * 256, block, channel, 0, 256);
+
+                    for (const auto metadata : midi)
+                        midiResult.push_back (metadata.getMessage());
+                }
+
+                graph.releaseResources();
+                return std::make_tuple (result, midiResult);
+            };
+
+            const auto [serialAudio, serialMidi] = render (0);
+            const auto [parallelAudio, parallelMidi] = render (3);
+
+            for (auto channel = 0; channel < 2; ++channel)
+                expect (FloatVectorOperations::findMaximum (serialAudio.getReadPointer (channel), serialAudio.getNumSamples()) > 0.0f);
+
+            auto audioMatches = true;
+
+            for (auto channel = 0; channel < 2; ++channel)
+                for (auto sample = 0; sample < serialAudio.getNumSamples(); ++sample)
+                    audioMatches = audioMatches && exactlyEqual (serialAudio.getSample (channel, sample), parallelAudio.getSample (channel, sample));
+
+            expect (audioMatches);
+            expectEquals ((int) parallelMidi.size(), (int) serialMidi.size());
+
+            for (size_t i = 0; i < jmin (serialMidi.size(), parallelMidi.size()); ++i)
+            {
+                expect (serialMidi[i].getDescription() == parallelMidi[i].getDescription());
+                expectEquals (serialMidi[i].getTimeStamp(), parallelMidi[i].getTimeStamp());
+            }
+        }
     }
 
 private:
@@ -2298,6 +2699,41 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    /*  Applies a gain and an offset which depend on the index, and adds a MIDI event, so that
+        every node leaves a distinct mark on the output.
+    */
+    class GainAndOffsetProcessor  : public BasicProcessor
+    {
+    public:
+        GainAndOffsetProcessor (int indexIn, int latency)
+            : BasicProcessor (getStereoProperties(), MidiIn::yes, MidiOut::yes),
+              index (indexIn)
+        {
+            setLatencySamples (latency);
+        }
+
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer& midi) override
+        {
+            const auto gain = 1.0f - (float) index * 0.01f;
+            const auto offset = (float) index * 0.001f;
+
+            for (auto channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                auto* data = audio.getWritePointer (channel);
+
+                for (auto sample = 0; sample < audio.getNumSamples(); ++sample)
+                    data[sample] = data[sample] * gain + offset;
+            }
+
+            midi.addEvent (MidiMessage::controllerEvent (1, index % 128, 64), index % audio.getNumSamples());
+        }
+
+        using BasicProcessor::processBlock;
+
+    private:
+        int index = 0;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
@@ -323,6 +323,32 @@ public:
     */
     void rebuild();
 
+    /** Allows the graph to process independent nodes concurrently.
+
+        By default, every node in the graph is processed in turn on the audio thread. If you
+        supply a number of threads greater than zero here, the graph will create that many
+        high-priority worker threads, which will help the audio thread to get through each
+        block by processing any nodes that don't depend on one another at the same time.
+
+        The output of the graph is identical in both modes. However, when parallel rendering
+        is enabled, the processBlock() methods of the nodes may be called on any of the
+        worker threads, and the AudioPlayHead seen by the nodes will return a copy of the
+        position that was reported by the graph's own play head at the start of the block.
+
+        Passing zero disables parallel rendering and destroys the worker threads. This should
+        only be called from the message thread.
+
+        @see getNumParallelRenderThreads
+    */
+    void setNumParallelRenderThreads (int numThreads);
+
+    /** Returns the number of worker threads used for parallel rendering, or zero if
+        parallel rendering is disabled.
+
+        @see setNumParallelRenderThreads
+    */
+    int getNumParallelRenderThreads() const;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -0,0 +1,327 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+void ParameterChangeQueue::prepare (const Array<AudioProcessorParameter*>& parameters, int maxPointsPerParameter)
+{
+    jassert (maxPointsPerParameter >= 2);
+
+    maxPoints = jmax (2, maxPointsPerParameter);
+    pointStorage.assign ((size_t) (parameters.size() * maxPoints), Point { 0, 0.0f });
+    parameterPoints.assign ((size_t) parameters.size(), ParameterPoints());
+    changedParameters.clear();
+    changedParameters.reserve ((size_t) parameters.size());
+
+    for (int i = 0; i < parameters.size(); ++i)
+    {
+        auto& p = parameterPoints[(size_t) i];
+        p.parameter = parameters.getUnchecked (i);
+        p.points = pointStorage.data() + i * maxPoints;
+    }
+}
+
+void ParameterChangeQueue::clear() noexcept
+{
+    for (auto index : changedParameters)
+        parameterPoints[(size_t) index].numPoints = 0;
+
+    changedParameters.clear();
+}
+
+//==============================================================================
+ParameterChangeQueue::ParameterPoints* ParameterChangeQueue::getParameterPoints (int parameterIndex) noexcept
+{
+    return isPositiveAndBelow (parameterIndex, (int) parameterPoints.size()) ? &parameterPoints[(size_t) parameterIndex]
+                                                                             : nullptr;
+}
+
+const ParameterChangeQueue::ParameterPoints* ParameterChangeQueue::getParameterPoints (int parameterIndex) const noexcept
+{
+    return isPositiveAndBelow (parameterIndex, (int) parameterPoints.size()) ? &parameterPoints[(size_t) parameterIndex]
+                                                                             : nullptr;
+}
+
+ParameterChangeQueue::Point* ParameterChangeQueue::insertPoint (ParameterPoints& p, int parameterIndex, int sampleOffset) noexcept
+{
+    if (p.numPoints == 0)
+    {
+        p.startValue = p.parameter != nullptr ? p.parameter->getValue() : 0.0f;
+        changedParameters.push_back (parameterIndex);
+    }
+
+    auto* end = p.points + p.numPoints;
+    auto* insertPos = std::upper_bound (p.points, end, sampleOffset,
+                                        [] (int offset, const Point& point) { return offset < point.sampleOffset; });
+
+    if (p.numPoints < maxPoints)
+    {
+        std::move_backward (insertPos, end, end + 1);
+        ++p.numPoints;
+        return insertPos;
+    }
+
+    // Out of space: a change that comes after all the others replaces the last point, so
+    // that the parameter still ends up in the right place, but earlier ones are dropped.
+    return insertPos == end ? end - 1 : nullptr;
+}
+
+bool ParameterChangeQueue::addPoint (int parameterIndex, int sampleOffset, float newValue) noexcept
+{
+    auto* p = getParameterPoints (parameterIndex);
+
+    if (p == nullptr)
+        return false;
+
+    const auto hadSpace = p->numPoints < maxPoints;
+    sampleOffset = jmax (0, sampleOffset);
+
+    if (auto* point = insertPoint (*p, parameterIndex, sampleOffset))
+        *point = { sampleOffset, newValue };
+
+    return hadSpace;
+}
+
+bool ParameterChangeQueue::addStep (int parameterIndex, int sampleOffset, float newValue) noexcept
+{
+    auto* p = getParameterPoints (parameterIndex);
+
+    if (p == nullptr)
+        return false;
+
+    if (p->numPoints + 2 > maxPoints)
+    {
+        addPoint (parameterIndex, sampleOffset, newValue);
+        return false;
+    }
+
+    sampleOffset = jmax (0, sampleOffset);
+    const auto previousValue = getValueAt (parameterIndex, sampleOffset);
+
+    // The second point goes in after the first, because points with equal offsets keep
+    // the order in which they were added.
+    *insertPoint (*p, parameterIndex, sampleOffset) = { sampleOffset, previousValue };
+    *insertPoint (*p, parameterIndex, sampleOffset) = { sampleOffset, newValue };
+    return true;
+}
+
+//==============================================================================
+int ParameterChangeQueue::getChangedParameterIndex (int index) const noexcept
+{
+    return isPositiveAndBelow (index, (int) changedParameters.size()) ? changedParameters[(size_t) index] : -1;
+}
+
+Span<const ParameterChangeQueue::Point> ParameterChangeQueue::getPoints (int parameterIndex) const noexcept
+{
+    if (auto* p = getParameterPoints (parameterIndex))
+        return { p->points, (size_t) p->numPoints };
+
+    return {};
+}
+
+float ParameterChangeQueue::getValueAtStartOfBlock (int parameterIndex) const noexcept
+{
+    if (auto* p = getParameterPoints (parameterIndex))
+    {
+        if (p->numPoints > 0)
+            return p->startValue;
+
+        if (p->parameter != nullptr)
+            return p->parameter->getValue();
+    }
+
+    return 0.0f;
+}
+
+float ParameterChangeQueue::getValueAt (int parameterIndex, int sampleOffset) const noexcept
+{
+    auto* p = getParameterPoints (parameterIndex);
+
+    if (p == nullptr || p->numPoints == 0)
+        return getValueAtStartOfBlock (parameterIndex);
+
+    Point previous { 0, p->startValue };
+
+    for (auto& point : getPoints (parameterIndex))
+    {
+        if (point.sampleOffset > sampleOffset)
+        {
+            const auto proportion = (float) (sampleOffset - previous.sampleOffset)
+                                  / (float) (point.sampleOffset - previous.sampleOffset);
+
+            return previous.value + (point.value - previous.value) * jmax (0.0f, proportion);
+        }
+
+        previous = point;
+    }
+
+    return previous.value;
+}
+
+void ParameterChangeQueue::fillRamp (int parameterIndex, float* destination, int numSamples) const noexcept
+{
+    auto* p = getParameterPoints (parameterIndex);
+
+    if (p == nullptr || p->numPoints == 0)
+    {
+        FloatVectorOperations::fill (destination, getValueAtStartOfBlock (parameterIndex), numSamples);
+        return;
+    }
+
+    Point previous { 0, p->startValue };
+    int pos = 0;
+
+    for (auto& point : getPoints (parameterIndex))
+    {
+        const auto segmentEnd = jmin (point.sampleOffset, numSamples);
+
+        if (segmentEnd > pos)
+        {
+            const auto delta = (point.value - previous.value) / (float) (point.sampleOffset - previous.sampleOffset);
+
+            for (; pos < segmentEnd; ++pos)
+                destination[pos] = previous.value + delta * (float) (pos - previous.sampleOffset);
+        }
+
+        previous = point;
+
+        if (pos >= numSamples)
+            return;
+    }
+
+    FloatVectorOperations::fill (destination + pos, previous.value, numSamples - pos);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterChangeQueueTests  : public UnitTest
+{
+public:
+    ParameterChangeQueueTests()
+        : UnitTest ("ParameterChangeQueue", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        AudioParameterFloat gain ("gain", "Gain", 0.0f, 1.0f, 0.5f);
+        AudioParameterFloat pan  ("pan",  "Pan",  0.0f, 1.0f, 0.0f);
+
+        Array<AudioProcessorParameter*> parameters { &gain, &pan };
+        ParameterChangeQueue queue;
+        queue.prepare (parameters, 4);
+
+        beginTest ("An unchanged parameter holds its current value");
+        {
+            expect (queue.isEmpty());
+            expect (queue.getPoints (0).empty());
+
+            float ramp[8];
+            queue.fillRamp (0, ramp, 8);
+
+            for (auto v : ramp)
+                expectEquals (v, 0.5f);
+        }
+
+        beginTest ("Points ramp linearly from the value at the start of the block");
+        {
+            expect (queue.addPoint (0, 4, 1.0f));
+            gain.setValueNotifyingHost (1.0f);
+
+            expectEquals (queue.getNumChangedParameters(), 1);
+            expectEquals (queue.getChangedParameterIndex (0), 0);
+            expectEquals (queue.getValueAtStartOfBlock (0), 0.5f);
+
+            float ramp[8];
+            queue.fillRamp (0, ramp, 8);
+
+            const float expected[] { 0.5f, 0.625f, 0.75f, 0.875f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+            for (int i = 0; i < 8; ++i)
+            {
+                expectWithinAbsoluteError (ramp[i], expected[i], 1.0e-6f);
+                expectWithinAbsoluteError (queue.getValueAt (0, i), expected[i], 1.0e-6f);
+            }
+
+            queue.clear();
+            expect (queue.isEmpty());
+            expect (queue.getPoints (0).empty());
+        }
+
+        beginTest ("Points are kept in order of their sample offsets");
+        {
+            queue.addPoint (1, 6, 0.6f);
+            queue.addPoint (1, 2, 0.2f);
+            queue.addPoint (1, 4, 0.4f);
+
+            auto points = queue.getPoints (1);
+            expectEquals ((int) points.size(), 3);
+            expectEquals (points[0].sampleOffset, 2);
+            expectEquals (points[1].sampleOffset, 4);
+            expectEquals (points[2].sampleOffset, 6);
+
+            queue.clear();
+        }
+
+        beginTest ("Steps change the value instantly");
+        {
+            expect (queue.addStep (1, 3, 1.0f));
+
+            float ramp[6];
+            queue.fillRamp (1, ramp, 6);
+
+            const float expected[] { 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+
+            for (int i = 0; i < 6; ++i)
+                expectEquals (ramp[i], expected[i]);
+
+            queue.clear();
+        }
+
+        beginTest ("A full queue still reaches the final value");
+        {
+            for (int i = 0; i < 4; ++i)
+                expect (queue.addPoint (0, i, (float) i * 0.1f));
+
+            expect (! queue.addPoint (0, 10, 0.9f));
+            expect (! queue.addStep (0, 12, 0.25f));
+
+            auto points = queue.getPoints (0);
+            expectEquals ((int) points.size(), 4);
+            expectEquals (points.back().sampleOffset, 12);
+            expectEquals (queue.getValueAt (0, 100), 0.25f);
+
+            queue.clear();
+        }
+    }
+};
+
+static ParameterChangeQueueTests parameterChangeQueueTests;
+
+#endif
+
+} // namespace juce
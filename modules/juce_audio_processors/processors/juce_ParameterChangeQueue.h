@@ -0,0 +1,188 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds the sample-accurate parameter changes that arrived with a block of audio.
+
+    An AudioProcessor's parameters always hold the most recent value sent by the
+    host, so reading them from processBlock() only tells you where each parameter
+    ends up at the end of the block. When the host provides timestamped changes,
+    the plugin wrappers and the AudioProcessorGraph also record them in the
+    processor's ParameterChangeQueue, which you can get hold of with
+    AudioProcessor::getParameterChanges() while processing a block.
+
+    For each parameter that changed during the block, the queue holds a list of
+    points, sorted by their sample offset within the block. Like the automation
+    curves of a VST3 IParamValueQueue, the value of the parameter moves linearly
+    from one point to the next, starting from the value it had at the start of the
+    block, and stays at the value of the last point after the last point. An
+    instantaneous jump is represented by two points at the same sample offset.
+
+    All the storage is allocated in prepare(), so adding points and reading them
+    back can safely be done on the audio thread.
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        auto& changes = getParameterChanges();
+
+        // gainRamp is a buffer that was allocated in prepareToPlay()
+        changes.fillRamp (gainParameter->getParameterIndex(), gainRamp.data(), buffer.getNumSamples());
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            FloatVectorOperations::multiply (buffer.getWritePointer (ch), gainRamp.data(), buffer.getNumSamples());
+    }
+    @endcode
+
+    Note that the values in the queue are normalised, in the range 0 to 1, just
+    like AudioProcessorParameter::getValue().
+
+    @see AudioProcessor::getParameterChanges
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterChangeQueue
+{
+public:
+    //==============================================================================
+    /** A timestamped parameter value. */
+    struct Point
+    {
+        /** The position of the change, in samples from the start of the block. */
+        int sampleOffset;
+
+        /** The normalised value of the parameter at this position. */
+        float value;
+    };
+
+    //==============================================================================
+    /** Creates an empty queue, which can't hold any points until prepare() is called. */
+    ParameterChangeQueue() = default;
+
+    /** Allocates space for the given parameters, and clears the queue.
+
+        The parameter indices used by the other methods are indices into this array,
+        which is normally the list returned by AudioProcessor::getParameters().
+
+        maxPointsPerParameter is the number of points that can be stored for each
+        parameter in a single block. If a host sends more changes than this, the
+        later ones will replace the last point in the list, so the parameter will
+        still reach its final value.
+
+        This allocates memory, so don't call it on the audio thread.
+    */
+    void prepare (const Array<AudioProcessorParameter*>& parameters, int maxPointsPerParameter = 64);
+
+    /** Removes all the points from the queue.
+
+        This is called by the wrappers once a block has been processed, and doesn't
+        allocate or free any memory.
+    */
+    void clear() noexcept;
+
+    //==============================================================================
+    /** Adds a point to the ramp for one of the parameters.
+
+        The value of the parameter will move linearly from the previous point (or from
+        its value at the start of the block, if this is the first point) to the new one.
+
+        The first time a parameter is given a point in a block, its current value is
+        stored as its value at the start of the block, so this must be called before
+        the new value is applied to the parameter itself.
+
+        Returns false if the parameter index was out of range, or if the parameter
+        had no space left and the point had to replace an existing one.
+    */
+    bool addPoint (int parameterIndex, int sampleOffset, float newValue) noexcept;
+
+    /** Adds an instantaneous change of value at the given sample offset.
+
+        The parameter will follow any earlier points up to the offset, and then
+        jump to the new value. This uses two points in the parameter's list.
+
+        Returns false if the parameter index was out of range, or if the parameter
+        didn't have enough space left for the change.
+    */
+    bool addStep (int parameterIndex, int sampleOffset, float newValue) noexcept;
+
+    //==============================================================================
+    /** Returns true if none of the parameters changed during this block. */
+    bool isEmpty() const noexcept                                   { return changedParameters.empty(); }
+
+    /** Returns the number of parameters that have any points in this block. */
+    int getNumChangedParameters() const noexcept                    { return (int) changedParameters.size(); }
+
+    /** Returns the parameter index of one of the parameters that have changed, in the
+        order in which they first received a point.
+
+        @see getNumChangedParameters
+    */
+    int getChangedParameterIndex (int index) const noexcept;
+
+    /** Returns the points that were added for the given parameter during this block,
+        sorted by their sample offset.
+    */
+    Span<const Point> getPoints (int parameterIndex) const noexcept;
+
+    /** Returns the normalised value that the parameter had at the start of the block. */
+    float getValueAtStartOfBlock (int parameterIndex) const noexcept;
+
+    /** Returns the normalised value of the parameter at a given position in the block. */
+    float getValueAt (int parameterIndex, int sampleOffset) const noexcept;
+
+    /** Fills a buffer with the normalised value of a parameter at each sample of the block.
+
+        If the parameter didn't change during this block, the buffer is filled with
+        its current value.
+    */
+    void fillRamp (int parameterIndex, float* destination, int numSamples) const noexcept;
+
+private:
+    //==============================================================================
+    struct ParameterPoints
+    {
+        AudioProcessorParameter* parameter = nullptr;
+        Point* points = nullptr;
+        int numPoints = 0;
+        float startValue = 0;
+    };
+
+    ParameterPoints* getParameterPoints (int parameterIndex) noexcept;
+    const ParameterPoints* getParameterPoints (int parameterIndex) const noexcept;
+    Point* insertPoint (ParameterPoints&, int parameterIndex, int sampleOffset) noexcept;
+
+    std::vector<ParameterPoints> parameterPoints;
+    std::vector<Point> pointStorage;
+    std::vector<int> changedParameters;
+    int maxPoints = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterChangeQueue)
+};
+
+} // namespace juce
@@ -108,6 +108,32 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
+    uint32 getChangeCount() const noexcept            { return changeCount.load (std::memory_order_acquire); }
+
+    // Used when applying a snapshot: this updates the parameter and the raw value, but
+    // leaves the listeners to be called later by sendPendingNotification()
+    void setDenormalisedValueWithoutNotifying (float value)
+    {
+        if (approximatelyEqual (value, unnormalisedValue.load()))
+            return;
+
+        // Unlike setValueNotifyingHost(), this doesn't call parameterValueChanged()
+        parameter.setValue (normalise (value));
+
+        unnormalisedValue = denormalise (parameter.getValue());
+        changeCount.fetch_add (1, std::memory_order_release);
+        notificationPending = true;
+    }
+
+    void sendPendingNotification()
+    {
+        if (! notificationPending.exchange (false))
+            return;
+
+        listenersNeedCalling = true;
+        parameter.sendValueChangedMessageToListeners (parameter.getValue());
+    }
+
     bool flushToTree (const Identifier& key, UndoManager* um)
     {
         auto needsUpdateTestValue = true;
@@ -132,6 +158,7 @@ public:
     }
 
     ValueTree tree;
+    int snapshotIndex = -1;
 
 private:
     void parameterGestureChanged (int, bool) override {}
@@ -144,6 +171,7 @@ private:
             return;
 
         unnormalisedValue = newValue;
+        changeCount.fetch_add (1, std::memory_order_release);
         listeners.call ([this] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
         needsUpdate = true;
@@ -198,6 +226,8 @@ private:
     LockedListeners listeners;
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
+    std::atomic<bool> notificationPending { false };
+    std::atomic<uint32> changeCount { 0 };
     bool ignoreParameterChangedCallbacks { false };
 };
 
@@ -323,7 +353,10 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    auto adapter = std::make_unique<ParameterAdapter> (param);
+    adapter->snapshotIndex = (int) adapterList.size();
+    adapterList.push_back (adapter.get());
+    adapterTable.emplace (param.paramID, std::move (adapter));
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -394,6 +427,109 @@ void AudioProcessorValueTreeState::replaceState (const ValueTree& newState)
         undoManager->clearUndoHistory();
 }
 
+//==============================================================================
+AudioProcessorValueTreeState::Snapshot AudioProcessorValueTreeState::takeSnapshot() const
+{
+    Snapshot snapshot;
+    takeSnapshot (snapshot);
+    return snapshot;
+}
+
+void AudioProcessorValueTreeState::takeSnapshot (Snapshot& destination) const
+{
+    destination.values.resize (adapterList.size());
+
+    // If a parameter changes while we're copying the values, try again a few times to get
+    // a consistent set. When the host is automating continuously we'll give up and use
+    // the latest values, which are still each valid on their own.
+    for (int attempt = 0; attempt < 4; ++attempt)
+    {
+        const auto versionBefore = getVersion();
+
+        for (size_t i = 0; i < adapterList.size(); ++i)
+            destination.values[i] = adapterList[i]->getDenormalisedValue();
+
+        destination.version = versionBefore;
+
+        if (getVersion() == versionBefore)
+            break;
+    }
+}
+
+void AudioProcessorValueTreeState::applySnapshot (const Snapshot& snapshot)
+{
+    // This snapshot must have been taken from, or created by, this object!
+    jassert (snapshot.values.size() == adapterList.size());
+
+    const auto numValues = jmin (snapshot.values.size(), adapterList.size());
+
+    {
+        const ScopedLock sl (processor.getCallbackLock());
+
+        for (size_t i = 0; i < numValues; ++i)
+            adapterList[i]->setDenormalisedValueWithoutNotifying (snapshot.values[i]);
+    }
+
+    for (size_t i = 0; i < numValues; ++i)
+        adapterList[i]->sendPendingNotification();
+}
+
+AudioProcessorValueTreeState::Snapshot AudioProcessorValueTreeState::createSnapshot (const ValueTree& stateToRead) const
+{
+    Snapshot snapshot;
+    snapshot.values.reserve (adapterList.size());
+
+    for (auto* adapter : adapterList)
+        snapshot.values.push_back (adapter->getDenormalisedDefaultValue());
+
+    for (const auto& child : stateToRead)
+    {
+        if (! child.hasType (valueType))
+            continue;
+
+        if (auto* adapter = getParameterAdapter (child.getProperty (idPropertyID).toString()))
+            snapshot.values[(size_t) adapter->snapshotIndex] = child.getProperty (valuePropertyID, adapter->getDenormalisedDefaultValue());
+    }
+
+    return snapshot;
+}
+
+ValueTree AudioProcessorValueTreeState::createValueTree (const Snapshot& snapshot, const Identifier& valueTreeType) const
+{
+    jassert (snapshot.values.size() == adapterList.size());
+
+    ValueTree result (valueTreeType);
+
+    for (size_t i = 0; i < jmin (snapshot.values.size(), adapterList.size()); ++i)
+    {
+        result.appendChild (ValueTree (valueType, { { idPropertyID,    adapterList[i]->getParameter().paramID },
+                                                    { valuePropertyID, snapshot.values[i] } }),
+                            nullptr);
+    }
+
+    return result;
+}
+
+int AudioProcessorValueTreeState::getSnapshotIndex (StringRef paramID) const noexcept
+{
+    if (auto* p = getParameterAdapter (paramID))
+        return p->snapshotIndex;
+
+    return -1;
+}
+
+uint64 AudioProcessorValueTreeState::getVersion() const noexcept
+{
+    // Starts at 1, so that it never matches a snapshot made by createSnapshot()
+    uint64 version = 1;
+
+    for (auto* adapter : adapterList)
+        version += adapter->getChangeCount();
+
+    return version;
+}
+
+//==============================================================================
 void AudioProcessorValueTreeState::setNewState (ValueTree vt)
 {
     jassert (vt.getParent() == state);
@@ -977,6 +1113,71 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("Snapshots hold the current parameter values");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (-10.0f, 10.0f), 0.0f),
+                                       std::make_unique<AudioParameterInt> ("b", "", 0, 8, 2) });
+
+            proc.state.getParameter ("a")->setValueNotifyingHost (0.75f);
+
+            const auto snapshot = proc.state.takeSnapshot();
+            expectEquals (snapshot.size(), 2);
+            expectEquals (snapshot.getValue (proc.state.getSnapshotIndex ("a")), 5.0f);
+            expectEquals (snapshot.getValue (proc.state.getSnapshotIndex ("b")), 2.0f);
+            expectEquals (proc.state.getSnapshotIndex ("c"), -1);
+
+            expect (snapshot.getVersion() == proc.state.getVersion());
+            proc.state.getParameter ("b")->setValueNotifyingHost (1.0f);
+            expect (snapshot.getVersion() != proc.state.getVersion());
+        }
+
+        beginTest ("Applying a snapshot updates the parameters and notifies listeners");
+        {
+            Listener listener;
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (-10.0f, 10.0f), 0.0f),
+                                       std::make_unique<AudioParameterInt> ("b", "", 0, 8, 2) });
+            proc.state.addParameterListener ("b", &listener);
+
+            auto snapshot = proc.state.takeSnapshot();
+            snapshot.setValue (proc.state.getSnapshotIndex ("a"), -5.0f);
+            snapshot.setValue (proc.state.getSnapshotIndex ("b"), 6.0f);
+
+            proc.state.applySnapshot (snapshot);
+
+            expectEquals (proc.state.getRawParameterValue ("a")->load(), -5.0f);
+            expectEquals (proc.state.getParameter ("a")->getValue(), 0.25f);
+            expectEquals (proc.state.getRawParameterValue ("b")->load(), 6.0f);
+            expectEquals (listener.id, String ("b"));
+            expectEquals (listener.value, 6.0f);
+
+            expectEquals ((float) proc.state.copyState().getChildWithProperty ("id", "a").getProperty ("value"), -5.0f);
+        }
+
+        beginTest ("Snapshots can be converted to and from ValueTrees");
+        {
+            TestAudioProcessor proc ({ std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (-10.0f, 10.0f), 0.0f),
+                                       std::make_unique<AudioParameterBool> ("b", "", true) });
+
+            auto snapshot = proc.state.takeSnapshot();
+            snapshot.setValue (0, 3.0f);
+            snapshot.setValue (1, 0.0f);
+
+            const auto tree = proc.state.createValueTree (snapshot, "state");
+            expectEquals (tree.getNumChildren(), 2);
+
+            for (auto child : tree)
+                expect (child.hasType ("PARAM"));
+
+            const auto parsed = proc.state.createSnapshot (tree);
+            expectEquals (parsed.getValue (0), 3.0f);
+            expectEquals (parsed.getValue (1), 0.0f);
+            expect (parsed.getVersion() != proc.state.getVersion());
+
+            const auto defaults = proc.state.createSnapshot (ValueTree ("state"));
+            expectEquals (defaults.getValue (0), 0.0f);
+            expectEquals (defaults.getValue (1), 1.0f);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
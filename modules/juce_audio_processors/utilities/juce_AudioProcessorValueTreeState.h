@@ -394,6 +394,116 @@ public:
     */
     void replaceState (const ValueTree& newState);
 
+    //==============================================================================
+    /** Holds the values of all the parameters in an AudioProcessorValueTreeState at a
+        particular moment.
+
+        A snapshot is a flat array of denormalised parameter values, one for each
+        parameter, in the order in which the parameters were added to the state.
+        You can find the position of a parameter in this array with
+        AudioProcessorValueTreeState::getSnapshotIndex().
+
+        Taking a snapshot, and applying one, doesn't involve the state's ValueTree,
+        so it can be done from any thread, and will never wait for the message thread.
+        This makes it a much cheaper way of saving and restoring the parameters than
+        copyState() and replaceState(), particularly for processors with a large number
+        of parameters.
+
+        @see takeSnapshot, applySnapshot
+    */
+    class JUCE_API  Snapshot
+    {
+    public:
+        /** Creates an empty snapshot. */
+        Snapshot() = default;
+
+        /** Returns the number of parameter values in the snapshot. */
+        int size() const noexcept                           { return (int) values.size(); }
+
+        /** Returns the denormalised value of one of the parameters. */
+        float getValue (int index) const noexcept           { return isPositiveAndBelow (index, size()) ? values[(size_t) index] : 0.0f; }
+
+        /** Changes the value of one of the parameters in the snapshot.
+            This won't affect the parameter itself until the snapshot is applied.
+        */
+        void setValue (int index, float newValue) noexcept  { if (isPositiveAndBelow (index, size())) values[(size_t) index] = newValue; }
+
+        /** Returns the version of the state that this snapshot was taken from.
+
+            Each change to a parameter increases the state's version number, so if this
+            is the same as AudioProcessorValueTreeState::getVersion(), none of the
+            parameters have changed since the snapshot was taken. Snapshots made by
+            AudioProcessorValueTreeState::createSnapshot() have a version of 0.
+        */
+        uint64 getVersion() const noexcept                  { return version; }
+
+    private:
+        friend class AudioProcessorValueTreeState;
+
+        std::vector<float> values;
+        uint64 version = 0;
+    };
+
+    /** Returns a snapshot of the current values of all the parameters.
+
+        This is lock-free and can be called from any thread. Each value is read
+        atomically, and if a parameter changes while the snapshot is being taken, the
+        values will be read again, a few times, to try to get a consistent set.
+
+        Note that this allocates the snapshot's storage, so if you need to call it from
+        the audio thread, use the other version of this method with a snapshot that
+        has already been allocated.
+    */
+    Snapshot takeSnapshot() const;
+
+    /** Fills a snapshot with the current values of all the parameters.
+
+        If the snapshot already has the right size, this won't allocate any memory,
+        so it's safe to call on the audio thread.
+    */
+    void takeSnapshot (Snapshot& destination) const;
+
+    /** Sets all the parameters to the values held in a snapshot.
+
+        The new values are written while holding the processor's callback lock, so
+        processBlock() will either see all the old values or all the new ones. Host
+        and listener notifications are sent after the lock has been released, and the
+        ValueTree will be updated asynchronously, in the same way as when a parameter
+        is changed by the host.
+
+        Don't call this from the audio thread.
+    */
+    void applySnapshot (const Snapshot& snapshot);
+
+    /** Creates a snapshot from a ValueTree in the format used by the state member.
+
+        Parameters that don't appear in the tree are given their default values. This
+        doesn't touch the state, so it can be used to parse a preset on a background
+        thread before applying it with applySnapshot().
+    */
+    Snapshot createSnapshot (const ValueTree& stateToRead) const;
+
+    /** Creates a ValueTree in the format used by the state member, containing the
+        parameter values from a snapshot.
+
+        This doesn't touch the state, so it can be used to serialise the parameters on
+        any thread. Note that only the parameter values are included, and not any other
+        properties or children that you may have added to the state.
+    */
+    ValueTree createValueTree (const Snapshot& snapshot, const Identifier& valueTreeType) const;
+
+    /** Returns the position of a parameter in the array of values held by a Snapshot,
+        or -1 if the parameter doesn't exist.
+    */
+    int getSnapshotIndex (StringRef parameterID) const noexcept;
+
+    /** Returns a number which increases whenever a parameter changes.
+
+        Comparing this to Snapshot::getVersion() is a cheap way of finding out whether
+        a snapshot is out of date. It's lock-free and can be called from any thread.
+    */
+    uint64 getVersion() const noexcept;
+
     //==============================================================================
     /** A reference to the processor with which this state is associated. */
     AudioProcessor& processor;
@@ -651,6 +761,7 @@ private:
     };
 
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
+    std::vector<ParameterAdapter*> adapterList;
 
     CriticalSection valueTreeChanging;
 
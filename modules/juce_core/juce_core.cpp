@@ -170,6 +170,7 @@
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_WorkStealingThreadPool.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
@@ -265,6 +266,7 @@
 #include "native/juce_AndroidDocument_android.cpp"
 #include "threads/juce_HighResolutionTimer.cpp"
 #include "threads/juce_WaitableEvent.cpp"
+#include "threads/juce_Semaphore.cpp"
 #include "network/juce_URL.cpp"
 
 #if ! JUCE_WASM
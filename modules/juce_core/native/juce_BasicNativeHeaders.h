@@ -193,6 +193,7 @@
  #include <pthread.h>
  #include <pwd.h>
  #include <sched.h>
+ #include <semaphore.h>
  #include <signal.h>
  #include <stddef.h>
  #include <sys/dir.h>
@@ -231,6 +232,7 @@
  #include <pthread.h>
  #include <pwd.h>
  #include <sched.h>
+ #include <semaphore.h>
  #include <signal.h>
  #include <stddef.h>
  #include <sys/file.h>
@@ -253,6 +255,7 @@
  #include <jni.h>
  #include <pthread.h>
  #include <sched.h>
+ #include <semaphore.h>
  #include <sys/time.h>
  #include <utime.h>
  #include <errno.h>
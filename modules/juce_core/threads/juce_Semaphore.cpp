@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace detail
+{
+
+#if JUCE_WINDOWS
+
+class Semaphore::NativeSemaphore
+{
+public:
+    NativeSemaphore() : handle (CreateSemaphore (nullptr, 0, std::numeric_limits<LONG>::max(), nullptr)) {}
+    ~NativeSemaphore()          { CloseHandle (handle); }
+
+    void signal() noexcept      { ReleaseSemaphore (handle, 1, nullptr); }
+    void wait() noexcept        { WaitForSingleObject (handle, INFINITE); }
+
+private:
+    HANDLE handle;
+};
+
+#elif JUCE_MAC || JUCE_IOS
+
+class Semaphore::NativeSemaphore
+{
+public:
+    NativeSemaphore() : semaphore (dispatch_semaphore_create (0)) {}
+    ~NativeSemaphore()          { dispatch_release (semaphore); }
+
+    void signal() noexcept      { dispatch_semaphore_signal (semaphore); }
+    void wait() noexcept        { dispatch_semaphore_wait (semaphore, DISPATCH_TIME_FOREVER); }
+
+private:
+    dispatch_semaphore_t semaphore;
+};
+
+#elif JUCE_LINUX || JUCE_BSD || JUCE_ANDROID
+
+class Semaphore::NativeSemaphore
+{
+public:
+    NativeSemaphore()           { sem_init (&semaphore, 0, 0); }
+    ~NativeSemaphore()          { sem_destroy (&semaphore); }
+
+    void signal() noexcept      { sem_post (&semaphore); }
+
+    void wait() noexcept
+    {
+        while (sem_wait (&semaphore) != 0 && errno == EINTR)
+        {}
+    }
+
+private:
+    sem_t semaphore;
+};
+
+#else
+
+class Semaphore::NativeSemaphore
+{
+public:
+    void signal() noexcept
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            ++numSignals;
+        }
+
+        condition.notify_one();
+    }
+
+    void wait() noexcept
+    {
+        std::unique_lock<std::mutex> lock (mutex);
+        condition.wait (lock, [this] { return numSignals > 0; });
+        --numSignals;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condition;
+    int numSignals = 0;
+};
+
+#endif
+
+//==============================================================================
+Semaphore::Semaphore (int initialCount)
+    : count (initialCount),
+      native (std::make_unique<NativeSemaphore>())
+{
+    jassert (initialCount >= 0);
+}
+
+Semaphore::~Semaphore()
+{
+    // Deleting a semaphore while a thread is still waiting on it will leave that thread stuck forever
+    jassert (count.load() >= 0);
+}
+
+void Semaphore::signal() noexcept
+{
+    if (count.fetch_add (1, std::memory_order_release) < 0)
+        native->signal();
+}
+
+void Semaphore::wait() noexcept
+{
+    if (count.fetch_sub (1, std::memory_order_acquire) <= 0)
+        native->wait();
+}
+
+bool Semaphore::tryWait() noexcept
+{
+    auto current = count.load (std::memory_order_relaxed);
+
+    while (current > 0)
+        if (count.compare_exchange_weak (current, current - 1, std::memory_order_acquire, std::memory_order_relaxed))
+            return true;
+
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SemaphoreTests  : public UnitTest
+{
+public:
+    SemaphoreTests()
+        : UnitTest ("Semaphore", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        beginTest ("tryWait only succeeds while the count is positive");
+        {
+            Semaphore semaphore (2);
+
+            expect (semaphore.tryWait());
+            expect (semaphore.tryWait());
+            expect (! semaphore.tryWait());
+
+            semaphore.signal();
+            expect (semaphore.tryWait());
+            expect (! semaphore.tryWait());
+        }
+
+        beginTest ("Every signal wakes exactly one wait");
+        {
+            constexpr auto numSignals = 10000;
+
+            Semaphore semaphore;
+            WaitableEvent finished;
+            std::atomic<int> numWoken { 0 };
+
+            Thread::launch ([&]
+            {
+                for (auto i = 0; i < numSignals; ++i)
+                {
+                    semaphore.wait();
+                    ++numWoken;
+                }
+
+                finished.signal();
+            });
+
+            for (auto i = 0; i < numSignals; ++i)
+                semaphore.signal();
+
+            expect (finished.wait (10000.0));
+
+            expectEquals (numWoken.load(), numSignals);
+            expect (! semaphore.tryWait());
+        }
+
+        beginTest ("Ping-pong between two threads");
+        {
+            constexpr auto numRounds = 1000;
+
+            Semaphore ping, pong;
+            WaitableEvent finished;
+            auto numPongs = 0;
+
+            Thread::launch ([&]
+            {
+                for (auto i = 0; i < numRounds; ++i)
+                {
+                    ping.wait();
+                    ++numPongs;
+                    pong.signal();
+                }
+
+                finished.signal();
+            });
+
+            for (auto i = 0; i < numRounds; ++i)
+            {
+                ping.signal();
+                pong.wait();
+                expectEquals (numPongs, i + 1);
+            }
+
+            expect (finished.wait (10000.0));
+        }
+    }
+};
+
+static SemaphoreTests semaphoreTests;
+
+#endif
+
+} // namespace detail
+} // namespace juce
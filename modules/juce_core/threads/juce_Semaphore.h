@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace detail
+{
+
+//==============================================================================
+/*  A counting semaphore which can be signalled from a realtime thread.
+
+    This is an internal helper for the Convolution class and the SamplerDiskStreamer,
+    which both hand work from the audio thread to background threads. It isn't part
+    of the public API, and may change or go away.
+
+    Each call to signal() increments the count, and each call to wait() blocks
+    until the count is greater than zero and then decrements it. Unlike WaitableEvent,
+    signalling never takes a lock: the count is kept in an atomic, and the operating
+    system is only involved when a thread is actually blocked in wait(), in which case
+    it's woken with the platform's native semaphore.
+*/
+class JUCE_API  Semaphore
+{
+public:
+    //==============================================================================
+    /** Creates a Semaphore with the given initial count. */
+    explicit Semaphore (int initialCount = 0);
+
+    /** Destructor.
+        No threads may be waiting on the semaphore when it's deleted.
+    */
+    ~Semaphore();
+
+    //==============================================================================
+    /** Increments the count, waking up one of the threads blocked in wait() if there are any.
+
+        This never blocks or allocates, so it's safe to call from a realtime thread.
+    */
+    void signal() noexcept;
+
+    /** Blocks the calling thread until the count is greater than zero, then decrements it. */
+    void wait() noexcept;
+
+    /** Decrements the count if it's greater than zero, without blocking.
+
+        @returns true if the count was decremented, or false if it was zero
+    */
+    bool tryWait() noexcept;
+
+private:
+    //==============================================================================
+    class NativeSemaphore;
+
+    // If this is negative, its magnitude is the number of threads blocked in wait()
+    std::atomic<int> count;
+    std::unique_ptr<NativeSemaphore> native;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Semaphore)
+};
+
+} // namespace detail
+#endif
+
+} // namespace juce
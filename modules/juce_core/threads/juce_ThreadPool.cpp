@@ -57,6 +57,7 @@ ThreadPoolJob::~ThreadPoolJob()
     // you mustn't delete a job while it's still in a pool! Use ThreadPool::removeJob()
     // to remove it first!
     jassert (pool == nullptr || ! pool->contains (this));
+    jassert (workStealingPool == nullptr);
 }
 
 String ThreadPoolJob::getJobName() const
@@ -90,7 +91,7 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
     if (auto* t = dynamic_cast<ThreadPool::ThreadPoolThread*> (Thread::getCurrentThread()))
         return t->currentJob.load();
 
-    return nullptr;
+    return WorkStealingThreadPool::getCurrentThreadPoolJob();
 }
 
 //==============================================================================
@@ -135,6 +136,9 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
     jassert (job != nullptr);
     jassert (job->pool == nullptr);
 
+    // This job is still in a WorkStealingThreadPool!
+    jassert (job->workStealingPool == nullptr);
+
     if (job->pool == nullptr)
     {
         job->pool = this;
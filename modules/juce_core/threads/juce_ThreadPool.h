@@ -24,6 +24,7 @@ namespace juce
 {
 
 class ThreadPool;
+class WorkStealingThreadPool;
 
 //==============================================================================
 /**
@@ -132,8 +133,10 @@ public:
     //==============================================================================
 private:
     friend class ThreadPool;
+    friend class WorkStealingThreadPool;
     String jobName;
     ThreadPool* pool = nullptr;
+    WorkStealingThreadPool* workStealingPool = nullptr;
     std::atomic<bool> shouldStop { false }, isActive { false }, shouldBeDeleted { false };
     ListenerList<Thread::Listener, Array<Thread::Listener*, CriticalSection>> listeners;
 
@@ -0,0 +1,792 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct WorkStealingThreadPool::Task
+{
+    ThreadPoolJob::JobStatus run()
+    {
+        if (job != nullptr)
+            return job->runJob();
+
+        return function();
+    }
+
+    ThreadPoolJob* job = nullptr;
+    bool deleteJobWhenFinished = false;
+    std::function<ThreadPoolJob::JobStatus()> function;
+    std::atomic<Task*> next { nullptr };
+};
+
+//==============================================================================
+/*  A Chase-Lev work-stealing deque.
+
+    Only the owning thread may call push() and pop(), which work at the bottom of the deque.
+    Any thread may call steal(), which takes the oldest task from the top. The storage grows
+    as needed, and old buffers are kept until the deque is destroyed, because a thief might
+    still be reading from one.
+*/
+class WorkStealingThreadPool::TaskDeque
+{
+public:
+    TaskDeque()
+    {
+        buffers.push_back (std::make_unique<Buffer> (256));
+        buffer.store (buffers.back().get());
+    }
+
+    void push (Task* task)
+    {
+        const auto b = bottom.load (std::memory_order_relaxed);
+        const auto t = top.load (std::memory_order_acquire);
+        auto* a = buffer.load (std::memory_order_relaxed);
+
+        if (b - t > a->capacity - 1)
+            a = grow (a, b, t);
+
+        a->put (b, task);
+        bottom.store (b + 1, std::memory_order_release);
+    }
+
+    Task* pop()
+    {
+        const auto b = bottom.load (std::memory_order_relaxed) - 1;
+        auto* a = buffer.load (std::memory_order_relaxed);
+        bottom.store (b, std::memory_order_seq_cst);
+        auto t = top.load (std::memory_order_seq_cst);
+
+        if (t > b)
+        {
+            bottom.store (b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* task = a->get (b);
+
+        if (t == b)
+        {
+            // This is the last task, so we might be racing a thief for it
+            if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+
+            bottom.store (b + 1, std::memory_order_relaxed);
+        }
+
+        return task;
+    }
+
+    Task* steal()
+    {
+        auto t = top.load (std::memory_order_seq_cst);
+        const auto b = bottom.load (std::memory_order_seq_cst);
+
+        if (t >= b)
+            return nullptr;
+
+        auto* task = buffer.load (std::memory_order_acquire)->get (t);
+
+        if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return task;
+    }
+
+private:
+    struct Buffer
+    {
+        explicit Buffer (int64 size)
+            : capacity (size), items ((size_t) size)
+        {
+            jassert (isPowerOfTwo (size));
+        }
+
+        Task* get (int64 index) const       { return items[(size_t) (index & (capacity - 1))].load (std::memory_order_relaxed); }
+        void put (int64 index, Task* task)  { items[(size_t) (index & (capacity - 1))].store (task, std::memory_order_relaxed); }
+
+        const int64 capacity;
+        std::vector<std::atomic<Task*>> items;
+    };
+
+    Buffer* grow (Buffer* old, int64 b, int64 t)
+    {
+        buffers.push_back (std::make_unique<Buffer> (old->capacity * 2));
+        auto* newBuffer = buffers.back().get();
+
+        for (auto i = t; i < b; ++i)
+            newBuffer->put (i, old->get (i));
+
+        buffer.store (newBuffer, std::memory_order_release);
+        return newBuffer;
+    }
+
+    std::atomic<int64> top { 0 }, bottom { 0 };
+    std::atomic<Buffer*> buffer { nullptr };
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
+
+//==============================================================================
+/*  An intrusive multiple-producer, single-consumer queue.
+
+    Any thread can push a task without taking a lock. Popping requires exclusive access,
+    which is obtained with tryBeginConsuming(), so that idle threads can empty the inbox of
+    a thread that is busy running a long job.
+*/
+class WorkStealingThreadPool::TaskInbox
+{
+public:
+    void push (Task* task)
+    {
+        task->next.store (nullptr, std::memory_order_relaxed);
+        auto* previous = head.exchange (task, std::memory_order_acq_rel);
+        previous->next.store (task, std::memory_order_release);
+    }
+
+    bool tryBeginConsuming()    { return ! consuming.exchange (true, std::memory_order_acquire); }
+    void endConsuming()         { consuming.store (false, std::memory_order_release); }
+
+    /*  Only call this between tryBeginConsuming() and endConsuming(). */
+    Task* pop()
+    {
+        auto* t = tail;
+        auto* next = t->next.load (std::memory_order_acquire);
+
+        if (t == &stub)
+        {
+            if (next == nullptr)
+                return nullptr;
+
+            tail = next;
+            t = next;
+            next = next->next.load (std::memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            tail = next;
+            return t;
+        }
+
+        // A producer has swapped the head but hasn't linked its task yet
+        if (t != head.load (std::memory_order_acquire))
+            return nullptr;
+
+        push (&stub);
+        next = t->next.load (std::memory_order_acquire);
+
+        if (next != nullptr)
+        {
+            tail = next;
+            return t;
+        }
+
+        return nullptr;
+    }
+
+private:
+    Task stub;
+    std::atomic<Task*> head { &stub };
+    Task* tail = &stub;
+    std::atomic<bool> consuming { false };
+};
+
+//==============================================================================
+class WorkStealingThreadPool::Worker  : public Thread
+{
+public:
+    Worker (WorkStealingThreadPool& p, const Options& options, int indexIn)
+        : Thread (options.threadName, options.threadStackSizeBytes),
+          pool (p),
+          index (indexIn)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            if (auto* task = pool.findTask (this))
+            {
+                pool.runTask (task, this);
+                continue;
+            }
+
+            // Once this thread is marked as idle, anything that submits a task will wake it,
+            // so checking the queues again afterwards means that no task can be missed
+            isIdle.store (true);
+            std::atomic_thread_fence (std::memory_order_seq_cst);
+
+            if (auto* task = pool.findTask (this))
+            {
+                isIdle.store (false);
+                pool.runTask (task, this);
+                continue;
+            }
+
+            wait (-1);
+            isIdle.store (false);
+        }
+    }
+
+    void setCurrentJob (ThreadPoolJob* job)
+    {
+        const SpinLock::ScopedLockType sl (currentJobLock);
+        currentJob = job;
+    }
+
+    void signalCurrentJobShouldExit()
+    {
+        const SpinLock::ScopedLockType sl (currentJobLock);
+
+        if (currentJob != nullptr)
+            currentJob->signalJobShouldExit();
+    }
+
+    WorkStealingThreadPool& pool;
+    const int index;
+    TaskDeque deque;
+    TaskInbox inbox;
+    std::atomic<bool> isIdle { false };
+
+    SpinLock currentJobLock;
+    ThreadPoolJob* currentJob = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+WorkStealingThreadPool::WorkStealingThreadPool (const Options& options)
+{
+    // not much point having a pool without any threads!
+    jassert (options.numberOfThreads > 0);
+
+    for (int i = 0; i < jmax (1, options.numberOfThreads); ++i)
+        workers.push_back (std::make_unique<Worker> (*this, options, i));
+
+    for (auto& w : workers)
+        w->startThread (options.desiredThreadPriority);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    for (auto& w : workers)
+    {
+        w->signalThreadShouldExit();
+        w->signalCurrentJobShouldExit();
+    }
+
+    for (auto& w : workers)
+        w->stopThread (5000);
+
+    // All the threads have stopped, so the remaining tasks can be discarded without any locking
+    const auto discard = [] (Task* task)
+    {
+        if (task->job != nullptr)
+        {
+            task->job->shouldStop = true;
+            task->job->workStealingPool = nullptr;
+
+            if (task->deleteJobWhenFinished)
+                delete task->job;
+        }
+
+        delete task;
+    };
+
+    for (auto& w : workers)
+    {
+        while (auto* task = w->deque.pop())
+            discard (task);
+
+        while (auto* task = w->inbox.pop())
+            discard (task);
+    }
+}
+
+//==============================================================================
+void WorkStealingThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
+{
+    jassert (job != nullptr);
+
+    // A job can only be in one pool at a time!
+    jassert (job->pool == nullptr && job->workStealingPool == nullptr && ! job->isActive);
+
+    job->workStealingPool = this;
+    job->shouldStop = false;
+    job->isActive = false;
+    job->shouldBeDeleted = deleteJobWhenFinished;
+
+    auto* task = new Task();
+    task->job = job;
+    task->deleteJobWhenFinished = deleteJobWhenFinished;
+
+    ++numOutstandingJobs;
+    submit (task, true);
+}
+
+void WorkStealingThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> job)
+{
+    auto* task = new Task();
+    task->function = std::move (job);
+
+    ++numOutstandingJobs;
+    submit (task, true);
+}
+
+void WorkStealingThreadPool::addJob (std::function<void()> job)
+{
+    addJob (std::function<ThreadPoolJob::JobStatus()> { [j = std::move (job)]
+                                                         {
+                                                             j();
+                                                             return ThreadPoolJob::jobHasFinished;
+                                                         } });
+}
+
+void WorkStealingThreadPool::submit (Task* task, bool mayUseLocalQueue)
+{
+    // Jobs added from inside the pool go onto the current thread's own queue, where
+    // the other threads can steal them if they're idle
+    if (auto* worker = mayUseLocalQueue ? getWorkerForCurrentThread() : nullptr)
+    {
+        worker->deque.push (task);
+    }
+    else
+    {
+        auto& target = *workers[(size_t) (nextWorkerIndex.fetch_add (1, std::memory_order_relaxed) % (uint32) workers.size())];
+        target.inbox.push (task);
+        target.notify();
+    }
+
+    // The task must be visible before checking for idle threads, because an idle thread
+    // looks for tasks again after it has marked itself as idle
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    wakeIdleWorker();
+}
+
+void WorkStealingThreadPool::wakeIdleWorker()
+{
+    // Clearing the flag stops the next submission from waking the same thread
+    for (auto& w : workers)
+    {
+        if (w->isIdle.load() && w->isIdle.exchange (false))
+        {
+            w->notify();
+            return;
+        }
+    }
+}
+
+WorkStealingThreadPool::Task* WorkStealingThreadPool::findTask (Worker* worker)
+{
+    const auto takeFromInbox = [this, worker] (TaskInbox& inbox) -> Task*
+    {
+        if (! inbox.tryBeginConsuming())
+            return nullptr;
+
+        auto* result = inbox.pop();
+        bool movedAnyTasks = false;
+
+        // Move a batch of the waiting tasks to our own queue, where they can be stolen
+        if (result != nullptr && worker != nullptr)
+        {
+            for (int i = 0; i < 64; ++i)
+            {
+                if (auto* task = inbox.pop())
+                {
+                    worker->deque.push (task);
+                    movedAnyTasks = true;
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        inbox.endConsuming();
+
+        // Only one thread at a time can empty an inbox, so another thread may have given
+        // up on these tasks while we were moving them
+        if (movedAnyTasks)
+            wakeIdleWorker();
+
+        return result;
+    };
+
+    if (worker != nullptr)
+    {
+        if (auto* task = worker->deque.pop())
+            return task;
+
+        if (auto* task = takeFromInbox (worker->inbox))
+            return task;
+    }
+
+    const auto numWorkers = workers.size();
+    const auto start = worker != nullptr ? (size_t) worker->index + 1 : 0;
+
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+        auto& victim = *workers[(start + i) % numWorkers];
+
+        if (&victim != worker)
+            if (auto* task = victim.deque.steal())
+                return task;
+    }
+
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+        auto& victim = *workers[(start + i) % numWorkers];
+
+        if (&victim != worker)
+            if (auto* task = takeFromInbox (victim.inbox))
+                return task;
+    }
+
+    return nullptr;
+}
+
+void WorkStealingThreadPool::runTask (Task* task, Worker* worker)
+{
+    auto* job = task->job;
+    auto result = ThreadPoolJob::jobHasFinished;
+
+    if (job == nullptr || ! job->shouldStop)
+    {
+        if (job != nullptr)
+        {
+            job->isActive = true;
+
+            if (worker != nullptr)
+                worker->setCurrentJob (job);
+        }
+
+        try
+        {
+            result = task->run();
+        }
+        catch (...)
+        {
+            jassertfalse; // Your runJob() method mustn't throw any exceptions!
+        }
+
+        if (job != nullptr)
+        {
+            if (worker != nullptr)
+                worker->setCurrentJob (nullptr);
+
+            job->isActive = false;
+        }
+    }
+
+    if (result == ThreadPoolJob::jobNeedsRunningAgain && (job == nullptr || ! job->shouldStop))
+    {
+        // Send the job to the back of an inbox, so that the other jobs get a turn first
+        submit (task, false);
+        return;
+    }
+
+    if (job != nullptr)
+    {
+        job->shouldStop = true;
+        job->workStealingPool = nullptr;
+
+        if (task->deleteJobWhenFinished)
+            delete job;
+    }
+
+    delete task;
+
+    if (--numOutstandingJobs == 0)
+        jobFinishedSignal.signal();
+}
+
+//==============================================================================
+void WorkStealingThreadPool::parallelFor (int numIterations, const std::function<void (int)>& function)
+{
+    if (numIterations <= 0)
+        return;
+
+    struct State
+    {
+        void runChunks()
+        {
+            for (;;)
+            {
+                const auto chunk = nextChunk.fetch_add (1);
+
+                if (chunk >= numChunks)
+                    return;
+
+                const auto end = jmin (numIterations, (chunk + 1) * chunkSize);
+
+                for (auto i = chunk * chunkSize; i < end; ++i)
+                    (*function) (i);
+
+                numChunksDone.fetch_add (1);
+            }
+        }
+
+        const std::function<void (int)>* function = nullptr;
+        int numIterations = 0, chunkSize = 1, numChunks = 0;
+        std::atomic<int> nextChunk { 0 }, numChunksDone { 0 };
+    };
+
+    // The helper jobs may not start until after this call has returned, so they share
+    // ownership of the state. They only touch the function after claiming a chunk, which
+    // can't happen once all the chunks have been completed.
+    auto state = std::make_shared<State>();
+    state->function = &function;
+    state->numIterations = numIterations;
+    state->chunkSize = jmax (1, numIterations / ((getNumThreads() + 1) * 4));
+    state->numChunks = (numIterations + state->chunkSize - 1) / state->chunkSize;
+
+    for (int i = jmin (getNumThreads(), state->numChunks - 1); --i >= 0;)
+        addJob ([state] { state->runChunks(); });
+
+    state->runChunks();
+
+    while (state->numChunksDone.load() < state->numChunks)
+        Thread::yield();
+}
+
+bool WorkStealingThreadPool::waitForAll (int timeOutMilliseconds)
+{
+    auto* worker = getWorkerForCurrentThread();
+
+    // A job can't wait for itself to finish!
+    jassert (worker == nullptr);
+
+    const auto start = Time::getMillisecondCounter();
+
+    while (numOutstandingJobs.load() > 0)
+    {
+        if (worker == nullptr)
+        {
+            if (auto* task = findTask (nullptr))
+            {
+                runTask (task, nullptr);
+                continue;
+            }
+        }
+
+        if (timeOutMilliseconds >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMilliseconds)
+            return false;
+
+        jobFinishedSignal.wait (2);
+    }
+
+    return true;
+}
+
+//==============================================================================
+WorkStealingThreadPool::Worker* WorkStealingThreadPool::getWorkerForCurrentThread() const
+{
+    if (auto* w = dynamic_cast<Worker*> (Thread::getCurrentThread()))
+        if (&w->pool == this)
+            return w;
+
+    return nullptr;
+}
+
+ThreadPoolJob* WorkStealingThreadPool::getCurrentThreadPoolJob()
+{
+    if (auto* w = dynamic_cast<Worker*> (Thread::getCurrentThread()))
+    {
+        const SpinLock::ScopedLockType sl (w->currentJobLock);
+        return w->currentJob;
+    }
+
+    return nullptr;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class WorkStealingThreadPoolTests  : public UnitTest
+{
+public:
+    WorkStealingThreadPoolTests()
+        : UnitTest ("WorkStealingThreadPool", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        beginTest ("Lambda jobs all run exactly once");
+        {
+            WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (4));
+
+            constexpr auto numJobs = 20000;
+            std::vector<std::atomic<int>> counts ((size_t) numJobs);
+
+            for (auto i = 0; i < numJobs; ++i)
+                pool.addJob ([&counts, i] { counts[(size_t) i].fetch_add (1); });
+
+            expect (pool.waitForAll (20000));
+            expectEquals (pool.getNumJobs(), 0);
+            expect (std::all_of (counts.begin(), counts.end(), [] (auto& c) { return c.load() == 1; }));
+        }
+
+        beginTest ("Jobs added from inside running jobs are run");
+        {
+            WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (3));
+            std::atomic<int> total { 0 };
+
+            for (auto i = 0; i < 100; ++i)
+            {
+                pool.addJob ([&]
+                {
+                    for (auto j = 0; j < 10; ++j)
+                        pool.addJob ([&] { total.fetch_add (1); });
+                });
+            }
+
+            expect (pool.waitForAll (20000));
+            expectEquals (total.load(), 1000);
+        }
+
+        beginTest ("ThreadPoolJobs can ask to be run again");
+        {
+            struct CountdownJob  : public ThreadPoolJob
+            {
+                CountdownJob() : ThreadPoolJob ("countdown") {}
+
+                JobStatus runJob() override
+                {
+                    wasCurrentJob = wasCurrentJob && getCurrentThreadPoolJob() == this;
+                    return --remaining > 0 ? jobNeedsRunningAgain : jobHasFinished;
+                }
+
+                std::atomic<int> remaining { 10 };
+                std::atomic<bool> wasCurrentJob { true };
+            };
+
+            WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (2));
+            CountdownJob job;
+            pool.addJob (&job, false);
+
+            // Don't let this thread help, so that the job always runs on a pool thread
+            while (pool.getNumJobs() > 0)
+                Thread::sleep (1);
+
+            expectEquals (job.remaining.load(), 0);
+            expect (job.wasCurrentJob.load());
+            expect (! job.isRunning());
+        }
+
+        beginTest ("Idle threads are woken as soon as there's work to steal");
+        {
+            struct SignallingJob  : public ThreadPoolJob
+            {
+                SignallingJob() : ThreadPoolJob ("signaller") {}
+
+                JobStatus runJob() override
+                {
+                    finished.signal();
+                    return jobHasFinished;
+                }
+
+                WaitableEvent finished;
+            };
+
+            WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (2));
+            SignallingJob job;
+            bool allStolenPromptly = true;
+
+            // Each job goes onto the queue of a thread that then blocks, so another
+            // thread has to wake up and steal it. The same job object is re-used each
+            // time, which is allowed once it has finished.
+            for (int i = 0; i < 50 && allStolenPromptly; ++i)
+            {
+                pool.addJob ([&]
+                {
+                    pool.addJob (&job, false);
+                    allStolenPromptly = job.finished.wait (400);
+                });
+
+                // Don't let this thread help, so that only the pool's threads can steal the job
+                while (pool.getNumJobs() > 0)
+                    Thread::sleep (1);
+            }
+
+            expect (allStolenPromptly);
+        }
+
+        beginTest ("parallelFor visits every index, including when nested");
+        {
+            WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (4));
+
+            constexpr auto outer = 16;
+            constexpr auto inner = 1000;
+            std::vector<std::atomic<int>> counts ((size_t) (outer * inner));
+
+            pool.parallelFor (outer, [&] (int i)
+            {
+                pool.parallelFor (inner, [&] (int j) { counts[(size_t) (i * inner + j)].fetch_add (1); });
+            });
+
+            expect (std::all_of (counts.begin(), counts.end(), [] (auto& c) { return c.load() == 1; }));
+        }
+
+        beginTest ("Queued jobs are discarded when the pool is deleted");
+        {
+            struct BlockingJob  : public ThreadPoolJob
+            {
+                BlockingJob() : ThreadPoolJob ("blocker") {}
+
+                JobStatus runJob() override
+                {
+                    started.signal();
+
+                    // holds on to the pool's only thread until the pool's destructor asks it to stop
+                    while (! shouldExit())
+                        Thread::sleep (1);
+
+                    return jobHasFinished;
+                }
+
+                WaitableEvent started;
+            };
+
+            std::atomic<int> numRun { 0 };
+            BlockingJob blocker;
+
+            {
+                WorkStealingThreadPool pool (WorkStealingThreadPool::Options{}.withNumberOfThreads (1));
+                pool.addJob (&blocker, false);
+                expect (blocker.started.wait (5000));
+
+                for (auto i = 0; i < 100; ++i)
+                    pool.addJob ([&] { ++numRun; });
+            }
+
+            expect (numRun.load() < 100);
+        }
+    }
+};
+
+static WorkStealingThreadPoolTests workStealingThreadPoolTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pool of threads that uses work-stealing to share out its jobs.
+
+    This behaves much like a ThreadPool, and runs the same ThreadPoolJob objects,
+    but it's designed for situations where huge numbers of short jobs are being
+    submitted, and where the single, locked job list in ThreadPool would become
+    a bottleneck.
+
+    Each thread keeps its own queue of jobs. A thread runs the most recently added
+    job in its own queue first, and when its queue is empty it steals the oldest job
+    from one of the other threads. Adding a job never takes a lock: jobs added from
+    outside the pool are handed to the threads in turn, and jobs added by a job that
+    is already running in the pool go straight onto the current thread's own queue.
+
+    Because the queues are lock-free, the pool doesn't keep a searchable list of its
+    jobs, so there are no equivalents of ThreadPool::removeJob(), ThreadPool::contains()
+    or ThreadPool::moveJobToFront(). Use waitForAll() to wait for all the work to be
+    done, or parallelFor() to split a loop across the pool.
+
+    @see ThreadPool, ThreadPoolJob
+
+    @tags{Core}
+*/
+class JUCE_API  WorkStealingThreadPool
+{
+public:
+    using Options = ThreadPoolOptions;
+
+    //==============================================================================
+    /** Creates a pool based on the provided options.
+        Once you've created a pool, you can give it some jobs by calling addJob().
+    */
+    explicit WorkStealingThreadPool (const Options& options);
+
+    /** Creates a pool using the default arguments provided by ThreadPoolOptions. */
+    WorkStealingThreadPool() : WorkStealingThreadPool { Options{} } {}
+
+    /** Destructor.
+
+        Any jobs that are currently running will be asked to stop by calling their
+        ThreadPoolJob::signalJobShouldExit() method, and any jobs that haven't started
+        yet will be discarded without being run. Call waitForAll() before deleting the
+        pool if you need all the jobs to complete.
+    */
+    ~WorkStealingThreadPool();
+
+    //==============================================================================
+    /** Adds a job to the pool.
+
+        The job's ThreadPoolJob::runJob() method will be called on one of the pool's threads.
+        If it returns ThreadPoolJob::jobNeedsRunningAgain, it will be queued again behind
+        any other jobs that are waiting.
+
+        If deleteJobWhenFinished is true, then the job object will be owned and deleted by
+        the pool when it's finished - if you do this, make sure that your object's destructor
+        is thread-safe. Otherwise, you must make sure that the job isn't deleted until it
+        has finished (e.g. by calling waitForAll()).
+
+        A job must not be added to this pool again, or to any other pool, until it
+        has finished.
+    */
+    void addJob (ThreadPoolJob* job, bool deleteJobWhenFinished);
+
+    /** Adds a lambda function to be called as a job. */
+    void addJob (std::function<ThreadPoolJob::JobStatus()> job);
+
+    /** Adds a lambda function to be called as a job. */
+    void addJob (std::function<void()> job);
+
+    //==============================================================================
+    /** Calls a function once for each index in the range [0, numIterations), spreading
+        the calls across the pool's threads.
+
+        The calling thread also takes part, and this method won't return until every call
+        has completed. It's safe to call this from inside a job that is running in this pool.
+    */
+    void parallelFor (int numIterations, const std::function<void (int)>& function);
+
+    /** Waits until all the jobs that have been added to the pool have finished.
+
+        If this is called from a thread outside the pool, it will help to run the queued
+        jobs while it waits.
+
+        @param timeOutMilliseconds  the maximum time to wait, or a negative value to wait forever
+        @returns true if all the jobs finished, or false if the timeout expired first
+    */
+    bool waitForAll (int timeOutMilliseconds = -1);
+
+    //==============================================================================
+    /** Returns the number of jobs that have been added and have not yet finished. */
+    int getNumJobs() const noexcept                 { return numOutstandingJobs.load(); }
+
+    /** Returns the number of threads assigned to this pool. */
+    int getNumThreads() const noexcept              { return (int) workers.size(); }
+
+private:
+    //==============================================================================
+    struct Task;
+    class TaskDeque;
+    class TaskInbox;
+    class Worker;
+
+    friend class ThreadPoolJob;
+    static ThreadPoolJob* getCurrentThreadPoolJob();
+
+    void submit (Task*, bool mayUseLocalQueue);
+    void wakeIdleWorker();
+    Task* findTask (Worker*);
+    void runTask (Task*, Worker*);
+    Worker* getWorkerForCurrentThread() const;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<uint32> nextWorkerIndex { 0 };
+    std::atomic<int> numOutstandingJobs { 0 };
+    WaitableEvent jobFinishedSignal;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkStealingThreadPool)
+};
+
+} // namespace juce
@@ -49,19 +49,25 @@ struct UndoManager::ActionSet
         return true;
     }
 
-    int getTotalSize() const
+    void add (std::unique_ptr<UndoableAction> action)
     {
-        int total = 0;
-
-        for (auto* a : actions)
-            total += a->getSizeInUnits();
+        totalSize += action->getSizeInUnits();
+        timeOfLastAction = Time::getCurrentTime();
+        actions.add (std::move (action));
+    }
 
-        return total;
+    void removeLast()
+    {
+        totalSize -= actions.getLast()->getSizeInUnits();
+        actions.removeLast();
     }
 
+    int getTotalSize() const noexcept   { return totalSize; }
+
     OwnedArray<UndoableAction> actions;
     String name;
-    Time time { Time::getCurrentTime() };
+    Time time { Time::getCurrentTime() }, timeOfLastAction { time };
+    int totalSize = 0;
 };
 
 //==============================================================================
@@ -94,6 +100,17 @@ void UndoManager::setMaxNumberOfStoredUnits (int maxUnits, int minTransactions)
     minimumTransactionsToKeep  = jmax (1, minTransactions);
 }
 
+void UndoManager::setHardLimitOnStoredUnits (int maxUnits)
+{
+    hardUnitLimit = jmax (0, maxUnits);
+    dropOldTransactionsIfTooLarge();
+}
+
+void UndoManager::setTransactionCoalescingInterval (int milliseconds)
+{
+    coalescingIntervalMs = jmax (0, milliseconds);
+}
+
 //==============================================================================
 bool UndoManager::perform (UndoableAction* newAction, const String& actionName)
 {
@@ -124,8 +141,9 @@ bool UndoManager::perform (UndoableAction* newAction)
         if (action->perform())
         {
             auto* actionSet = getCurrentSet();
+            bool coalesced = false;
 
-            if (actionSet != nullptr && ! newTransaction)
+            if (actionSet != nullptr && (! newTransaction || canMergeWithCurrentSet (*actionSet)))
             {
                 if (auto* lastAction = actionSet->actions.getLast())
                 {
@@ -133,11 +151,13 @@ bool UndoManager::perform (UndoableAction* newAction)
                     {
                         action.reset (coalescedAction);
                         totalUnitsStored -= lastAction->getSizeInUnits();
-                        actionSet->actions.removeLast();
+                        actionSet->removeLast();
+                        coalesced = true;
                     }
                 }
             }
-            else
+
+            if (actionSet == nullptr || (newTransaction && ! coalesced))
             {
                 actionSet = new ActionSet (newTransactionName);
                 transactions.insert (nextIndex, actionSet);
@@ -145,7 +165,7 @@ bool UndoManager::perform (UndoableAction* newAction)
             }
 
             totalUnitsStored += action->getSizeInUnits();
-            actionSet->actions.add (std::move (action));
+            actionSet->add (std::move (action));
             newTransaction = false;
 
             moveFutureTransactionsToStash();
@@ -158,6 +178,14 @@ bool UndoManager::perform (UndoableAction* newAction)
     return false;
 }
 
+bool UndoManager::canMergeWithCurrentSet (const ActionSet& actionSet) const
+{
+    return coalescingIntervalMs > 0
+            && nextIndex == transactions.size()
+            && (newTransactionName.isEmpty() || newTransactionName == actionSet.name)
+            && (Time::getCurrentTime() - actionSet.timeOfLastAction).inMilliseconds() < coalescingIntervalMs;
+}
+
 void UndoManager::moveFutureTransactionsToStash()
 {
     if (nextIndex < transactions.size())
@@ -196,16 +224,30 @@ void UndoManager::dropOldTransactionsIfTooLarge()
             && totalUnitsStored > maxNumUnitsToKeep
             && transactions.size() > minimumTransactionsToKeep)
     {
-        totalUnitsStored -= transactions.getFirst()->getTotalSize();
-        transactions.remove (0);
-        --nextIndex;
+        dropOldestTransaction();
+    }
 
-        // if this fails, then some actions may not be returning
-        // consistent results from their getSizeInUnits() method
-        jassert (totalUnitsStored >= 0);
+    // The hard limit overrides the minimum number of transactions, but never
+    // drops the one that's currently being built
+    while (hardUnitLimit > 0
+            && nextIndex > 1
+            && totalUnitsStored > hardUnitLimit)
+    {
+        dropOldestTransaction();
     }
 }
 
+void UndoManager::dropOldestTransaction()
+{
+    totalUnitsStored -= transactions.getFirst()->getTotalSize();
+    transactions.remove (0);
+    --nextIndex;
+
+    // if this fails, then some actions may not be returning
+    // consistent results from their getSizeInUnits() method
+    jassert (totalUnitsStored >= 0);
+}
+
 void UndoManager::beginNewTransaction()
 {
     beginNewTransaction ({});
@@ -213,6 +255,11 @@ void UndoManager::beginNewTransaction()
 
 void UndoManager::beginNewTransaction (const String& actionName)
 {
+    // The transaction that's being closed won't grow any further, so trim its storage
+    if (! newTransaction)
+        if (auto* s = getCurrentSet())
+            s->actions.minimiseStorageOverheads();
+
     newTransaction = true;
     newTransactionName = actionName;
 }
@@ -366,4 +413,132 @@ int UndoManager::getNumActionsInCurrentTransaction() const
     return 0;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class UndoManagerTests  : public UnitTest
+{
+public:
+    UndoManagerTests()
+        : UnitTest ("UndoManager", UnitTestCategories::values)
+    {}
+
+    struct SetValueAction  : public UndoableAction
+    {
+        SetValueAction (int& targetToUse, int newValueToUse, int sizeToUse = 10)
+            : target (targetToUse), oldValue (targetToUse), newValue (newValueToUse), size (sizeToUse)
+        {}
+
+        bool perform() override     { target = newValue; return true; }
+        bool undo() override        { target = oldValue; return true; }
+        int getSizeInUnits() override  { return size; }
+
+        UndoableAction* createCoalescedAction (UndoableAction* next) override
+        {
+            if (auto* nextSet = dynamic_cast<SetValueAction*> (next))
+            {
+                if (&nextSet->target == &target)
+                {
+                    auto* coalesced = new SetValueAction (target, nextSet->newValue, size);
+                    coalesced->oldValue = oldValue;
+                    return coalesced;
+                }
+            }
+
+            return nullptr;
+        }
+
+        int& target;
+        int oldValue, newValue, size;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Actions within a transaction are coalesced");
+        {
+            UndoManager um;
+            int value = 0;
+
+            um.beginNewTransaction();
+
+            for (int i = 1; i <= 100; ++i)
+                um.perform (new SetValueAction (value, i));
+
+            expectEquals (value, 100);
+            expectEquals (um.getNumActionsInCurrentTransaction(), 1);
+            expectEquals (um.getNumberOfUnitsTakenUpByStoredCommands(), 10);
+
+            um.undo();
+            expectEquals (value, 0);
+        }
+
+        beginTest ("Transactions are only coalesced within the interval");
+        {
+            UndoManager um;
+            int value = 0;
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                um.beginNewTransaction();
+                um.perform (new SetValueAction (value, i));
+            }
+
+            expectEquals (um.getUndoDescriptions().size(), 10);
+
+            um.clearUndoHistory();
+            um.setTransactionCoalescingInterval (60 * 60 * 1000);
+
+            for (int i = 1; i <= 10; ++i)
+            {
+                um.beginNewTransaction();
+                um.perform (new SetValueAction (value, i + 10));
+            }
+
+            expectEquals (um.getUndoDescriptions().size(), 1);
+            expectEquals (um.getNumberOfUnitsTakenUpByStoredCommands(), 10);
+
+            um.beginNewTransaction ("Different name");
+            um.perform (new SetValueAction (value, 100));
+            expectEquals (um.getUndoDescriptions().size(), 2);
+
+            um.undo();
+            um.undo();
+            expectEquals (value, 10);
+        }
+
+        beginTest ("The hard limit overrides the minimum number of transactions");
+        {
+            UndoManager um (100, 30);
+            int value = 0;
+
+            for (int i = 1; i <= 20; ++i)
+            {
+                um.beginNewTransaction();
+                um.perform (new SetValueAction (value, i, 50));
+            }
+
+            expectEquals (um.getUndoDescriptions().size(), 20);
+            expectEquals (um.getNumberOfUnitsTakenUpByStoredCommands(), 1000);
+
+            um.setHardLimitOnStoredUnits (200);
+            expectEquals (um.getUndoDescriptions().size(), 4);
+            expectEquals (um.getNumberOfUnitsTakenUpByStoredCommands(), 200);
+
+            um.beginNewTransaction();
+            um.perform (new SetValueAction (value, 1000, 500));
+            expectEquals (um.getUndoDescriptions().size(), 1);
+            expectEquals (um.getNumberOfUnitsTakenUpByStoredCommands(), 500);
+
+            um.undo();
+            expectEquals (value, 20);
+            expect (! um.canUndo());
+        }
+    }
+};
+
+static UndoManagerTests undoManagerTests;
+
+#endif
+
 } // namespace juce
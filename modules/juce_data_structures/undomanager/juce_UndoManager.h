@@ -97,6 +97,35 @@ public:
     void setMaxNumberOfStoredUnits (int maxNumberOfUnitsToKeep,
                                     int minimumTransactionsToKeep);
 
+    /** Sets an absolute limit on the amount of space used for storing UndoableAction objects.
+
+        Unlike the limit set by setMaxNumberOfStoredUnits(), this one is enforced even if it
+        means keeping fewer than the minimum number of transactions. The oldest transactions are
+        dropped until the total fits, although the most recent transaction is always kept.
+
+        @param maxNumberOfUnits     the limit, in the same units as UndoableAction::getSizeInUnits(),
+                                    or zero to remove the limit (the default)
+        @see setMaxNumberOfStoredUnits, getNumberOfUnitsTakenUpByStoredCommands
+    */
+    void setHardLimitOnStoredUnits (int maxNumberOfUnits);
+
+    /** Allows actions in separate transactions to be coalesced if they happen in quick succession.
+
+        Normally, UndoableAction::createCoalescedAction() is only used to merge actions
+        within the same transaction. If this interval is greater than zero, then when the first
+        action of a new transaction follows the previous transaction's last action within this
+        many milliseconds, and the two actions can be coalesced, the action will be merged into
+        the previous transaction instead of starting a new one. This stops continuous edits, such
+        as dragging a slider that begins a new transaction for each change, from filling the
+        history with lots of tiny transactions.
+
+        Transactions are only merged if the new transaction has no name, or has the same name
+        as the previous one, and there's nothing that could be redone.
+
+        @param milliseconds     the interval, or zero to disable this behaviour (the default)
+    */
+    void setTransactionCoalescingInterval (int milliseconds);
+
     //==============================================================================
     /** Performs an action and adds it to the undo history list.
 
@@ -251,12 +280,15 @@ private:
     OwnedArray<ActionSet> transactions, stashedFutureTransactions;
     String newTransactionName;
     int totalUnitsStored = 0, maxNumUnitsToKeep = 0, minimumTransactionsToKeep = 0, nextIndex = 0;
+    int hardUnitLimit = 0, coalescingIntervalMs = 0;
     bool newTransaction = true, isInsideUndoRedoCall = false;
     ActionSet* getCurrentSet() const;
     ActionSet* getNextSet() const;
+    bool canMergeWithCurrentSet (const ActionSet&) const;
     void moveFutureTransactionsToStash();
     void restoreStashedFutureTransactions();
     void dropOldTransactionsIfTooLarge();
+    void dropOldestTransaction();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoManager)
 };
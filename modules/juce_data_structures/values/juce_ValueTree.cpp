@@ -36,6 +36,8 @@ public:
     SharedObject (const SharedObject& other)
         : ReferenceCountedObject(), type (other.type), properties (other.properties)
     {
+        children.ensureStorageAllocated (other.children.size());
+
         for (auto* c : other.children)
         {
             auto* child = new SharedObject (*c);
@@ -55,7 +57,12 @@ public:
             const Ptr c (children.getObjectPointerUnchecked (i));
             c->parent = nullptr;
             children.remove (i);
-            c->sendParentChangeMessage();
+
+            // If nothing else refers to the child, no ValueTree can be listening to it, and it's
+            // about to be deleted, which will notify its own children. Skipping the message
+            // avoids walking every sub-tree once for each level above it.
+            if (c->getReferenceCount() > 1)
+                c->sendParentChangeMessage();
         }
     }
 
@@ -100,6 +107,21 @@ public:
         callListenersForAllParents (listenerToExclude, [&] (Listener& l) { l.valueTreePropertyChanged (tree, property); });
     }
 
+    void sendPropertiesChangeMessage (const Array<Identifier>& changedProperties)
+    {
+        if (changedProperties.isEmpty())
+            return;
+
+        ValueTree tree (*this);
+        callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreePropertiesChanged (tree, changedProperties); });
+    }
+
+    void sendChildrenAddedMessage (const Array<ValueTree>& newChildren)
+    {
+        ValueTree tree (*this);
+        callListenersForAllParents (nullptr, [&] (Listener& l) { l.valueTreeChildrenAdded (tree, newChildren); });
+    }
+
     void sendChildAddedMessage (ValueTree child)
     {
         ValueTree tree (*this);
@@ -153,6 +175,49 @@ public:
         }
     }
 
+    void setProperties (const NamedValueSet& newProperties, UndoManager* undoManager)
+    {
+        if (undoManager == nullptr)
+        {
+            applyPropertyChanges (newProperties, {});
+            return;
+        }
+
+        NamedValueSet oldValues;
+        Array<Identifier> addedProperties;
+
+        for (auto& p : newProperties)
+        {
+            if (auto* existingValue = properties.getVarPointer (p.name))
+            {
+                if (*existingValue != p.value)
+                    oldValues.set (p.name, *existingValue);
+            }
+            else
+            {
+                addedProperties.add (p.name);
+            }
+        }
+
+        if (oldValues.size() > 0 || ! addedProperties.isEmpty())
+            undoManager->perform (new SetPropertiesAction (*this, newProperties, std::move (oldValues), std::move (addedProperties)));
+    }
+
+    void applyPropertyChanges (const NamedValueSet& valuesToSet, const Array<Identifier>& propertiesToRemove)
+    {
+        Array<Identifier> changedProperties;
+
+        for (auto& p : valuesToSet)
+            if (properties.set (p.name, p.value))
+                changedProperties.add (p.name);
+
+        for (auto& name : propertiesToRemove)
+            if (properties.remove (name))
+                changedProperties.addIfNotAlreadyThere (name);
+
+        sendPropertiesChangeMessage (changedProperties);
+    }
+
     bool hasProperty (const Identifier& name) const noexcept
     {
         return properties.contains (name);
@@ -244,45 +309,93 @@ public:
         return children.indexOf (child.object);
     }
 
+    bool prepareToAdopt (SharedObject* child, UndoManager* undoManager)
+    {
+        if (child == nullptr || child->parent == this)
+            return false;
+
+        if (child == this || isAChildOf (child))
+        {
+            // You're attempting to create a recursive loop! A node
+            // can't be a child of one of its own children!
+            jassertfalse;
+            return false;
+        }
+
+        // You should always make sure that a child is removed from its previous parent before
+        // adding it somewhere else - otherwise, it's ambiguous as to whether a different
+        // undomanager should be used when removing it from its current parent..
+        jassert (child->parent == nullptr);
+
+        if (child->parent != nullptr)
+        {
+            jassert (child->parent->children.indexOf (child) >= 0);
+            child->parent->removeChild (child->parent->children.indexOf (child), undoManager);
+        }
+
+        return true;
+    }
+
     void addChild (SharedObject* child, int index, UndoManager* undoManager)
     {
-        if (child != nullptr && child->parent != this)
+        if (! prepareToAdopt (child, undoManager))
+            return;
+
+        if (undoManager == nullptr)
         {
-            if (child != this && ! isAChildOf (child))
-            {
-                // You should always make sure that a child is removed from its previous parent before
-                // adding it somewhere else - otherwise, it's ambiguous as to whether a different
-                // undomanager should be used when removing it from its current parent..
-                jassert (child->parent == nullptr);
+            children.insert (index, child);
+            child->parent = this;
+            sendChildAddedMessage (ValueTree (*child));
+            child->sendParentChangeMessage();
+        }
+        else
+        {
+            if (! isPositiveAndBelow (index, children.size()))
+                index = children.size();
 
-                if (child->parent != nullptr)
-                {
-                    jassert (child->parent->children.indexOf (child) >= 0);
-                    child->parent->removeChild (child->parent->children.indexOf (child), undoManager);
-                }
+            undoManager->perform (new AddOrRemoveChildAction (*this, index, child));
+        }
+    }
 
-                if (undoManager == nullptr)
-                {
-                    children.insert (index, child);
-                    child->parent = this;
-                    sendChildAddedMessage (ValueTree (*child));
-                    child->sendParentChangeMessage();
-                }
-                else
-                {
-                    if (! isPositiveAndBelow (index, children.size()))
-                        index = children.size();
+    void addChildren (const Array<ValueTree>& newChildren, int index, UndoManager* undoManager)
+    {
+        ReferenceCountedArray<SharedObject> childrenToAdd;
+        childrenToAdd.ensureStorageAllocated (newChildren.size());
 
-                    undoManager->perform (new AddOrRemoveChildAction (*this, index, child));
-                }
-            }
-            else
-            {
-                // You're attempting to create a recursive loop! A node
-                // can't be a child of one of its own children!
-                jassertfalse;
-            }
+        for (auto& c : newChildren)
+            if (! childrenToAdd.contains (c.object.get()) && prepareToAdopt (c.object.get(), undoManager))
+                childrenToAdd.add (c.object);
+
+        if (childrenToAdd.isEmpty())
+            return;
+
+        if (! isPositiveAndBelow (index, children.size()))
+            index = children.size();
+
+        if (undoManager == nullptr)
+            insertChildren (childrenToAdd, index);
+        else
+            undoManager->perform (new AddChildrenAction (*this, index, std::move (childrenToAdd)));
+    }
+
+    void insertChildren (const ReferenceCountedArray<SharedObject>& childrenToAdd, int index)
+    {
+        children.ensureStorageAllocated (children.size() + childrenToAdd.size());
+
+        Array<ValueTree> added;
+        added.ensureStorageAllocated (childrenToAdd.size());
+
+        for (auto* child : childrenToAdd)
+        {
+            children.insert (index + added.size(), child);
+            child->parent = this;
+            added.add (ValueTree (*child));
         }
+
+        sendChildrenAddedMessage (added);
+
+        for (auto* child : childrenToAdd)
+            child->sendParentChangeMessage();
     }
 
     void removeChild (int childIndex, UndoManager* undoManager)
@@ -471,6 +584,82 @@ public:
         JUCE_DECLARE_NON_COPYABLE (SetPropertyAction)
     };
 
+    //==============================================================================
+    struct SetPropertiesAction  : public UndoableAction
+    {
+        SetPropertiesAction (Ptr targetObject, const NamedValueSet& newVals,
+                             NamedValueSet oldVals, Array<Identifier> addedProps)
+            : target (std::move (targetObject)),
+              newValues (newVals),
+              oldValues (std::move (oldVals)),
+              addedProperties (std::move (addedProps))
+        {
+        }
+
+        bool perform() override
+        {
+            target->applyPropertyChanges (newValues, {});
+            return true;
+        }
+
+        bool undo() override
+        {
+            target->applyPropertyChanges (oldValues, addedProperties);
+            return true;
+        }
+
+        int getSizeInUnits() override
+        {
+            return (int) sizeof (*this) + (newValues.size() + oldValues.size()) * (int) sizeof (NamedValueSet::NamedValue);
+        }
+
+    private:
+        const Ptr target;
+        const NamedValueSet newValues, oldValues;
+        const Array<Identifier> addedProperties;
+
+        JUCE_DECLARE_NON_COPYABLE (SetPropertiesAction)
+    };
+
+    //==============================================================================
+    struct AddChildrenAction  : public UndoableAction
+    {
+        AddChildrenAction (Ptr parentObject, int index, ReferenceCountedArray<SharedObject> newChildren)
+            : target (std::move (parentObject)), children (std::move (newChildren)), startIndex (index)
+        {
+        }
+
+        bool perform() override
+        {
+            target->insertChildren (children, startIndex);
+            return true;
+        }
+
+        bool undo() override
+        {
+            // If you hit this, it seems that your object's state is getting confused - probably
+            // because you've interleaved some undoable and non-undoable operations?
+            jassert (startIndex + children.size() <= target->children.size());
+
+            for (auto i = children.size(); --i >= 0;)
+                target->removeChild (startIndex + i, nullptr);
+
+            return true;
+        }
+
+        int getSizeInUnits() override
+        {
+            return (int) sizeof (*this) + children.size() * (int) sizeof (SharedObject*);
+        }
+
+    private:
+        const Ptr target;
+        const ReferenceCountedArray<SharedObject> children;
+        const int startIndex;
+
+        JUCE_DECLARE_NON_COPYABLE (AddChildrenAction)
+    };
+
     //==============================================================================
     struct AddOrRemoveChildAction  : public UndoableAction
     {
@@ -763,6 +952,16 @@ ValueTree& ValueTree::setProperty (const Identifier& name, const var& newValue,
     return setPropertyExcludingListener (nullptr, name, newValue, undoManager);
 }
 
+ValueTree& ValueTree::setProperties (const NamedValueSet& newProperties, UndoManager* undoManager)
+{
+    jassert (object != nullptr); // Trying to add properties to a null ValueTree will fail!
+
+    if (object != nullptr)
+        object->setProperties (newProperties, undoManager);
+
+    return *this;
+}
+
 ValueTree& ValueTree::setPropertyExcludingListener (Listener* listenerToExclude, const Identifier& name,
                                                     const var& newValue, UndoManager* undoManager)
 {
@@ -926,6 +1125,14 @@ void ValueTree::appendChild (const ValueTree& child, UndoManager* undoManager)
     addChild (child, -1, undoManager);
 }
 
+void ValueTree::addChildren (const Array<ValueTree>& newChildren, int index, UndoManager* undoManager)
+{
+    jassert (object != nullptr); // Trying to add children to a null ValueTree!
+
+    if (object != nullptr)
+        object->addChildren (newChildren, index, undoManager);
+}
+
 void ValueTree::removeChild (int childIndex, UndoManager* undoManager)
 {
     if (object != nullptr)
@@ -1003,9 +1210,20 @@ ValueTree ValueTree::fromXml (const XmlElement& xml)
     {
         ValueTree v (xml.getTagName());
         v.object->properties.setFromXmlAttributes (xml);
+        v.object->children.ensureStorageAllocated (xml.getNumChildElements());
 
+        // Nothing can be listening to this new tree yet, so the children can be attached
+        // directly, as readFromStream() does, without any notifications.
         for (auto* e : xml.getChildIterator())
-            v.appendChild (fromXml (*e), nullptr);
+        {
+            auto child = fromXml (*e);
+
+            if (child.isValid())
+            {
+                v.object->children.add (child.object);
+                child.object->parent = v.object.get();
+            }
+        }
 
         return v;
     }
@@ -1096,6 +1314,18 @@ ValueTree ValueTree::readFromGZIPData (const void* data, size_t numBytes)
 
 void ValueTree::Listener::valueTreePropertyChanged   (ValueTree&, const Identifier&) {}
 void ValueTree::Listener::valueTreeChildAdded        (ValueTree&, ValueTree&)        {}
+
+void ValueTree::Listener::valueTreePropertiesChanged (ValueTree& tree, const Array<Identifier>& properties)
+{
+    for (auto& property : properties)
+        valueTreePropertyChanged (tree, property);
+}
+
+void ValueTree::Listener::valueTreeChildrenAdded (ValueTree& parent, const Array<ValueTree>& children)
+{
+    for (auto child : children)
+        valueTreeChildAdded (parent, child);
+}
 void ValueTree::Listener::valueTreeChildRemoved      (ValueTree&, ValueTree&, int)   {}
 void ValueTree::Listener::valueTreeChildOrderChanged (ValueTree&, int, int)          {}
 void ValueTree::Listener::valueTreeParentChanged     (ValueTree&)                    {}
@@ -1247,6 +1477,131 @@ public:
                 expectEquals (lines[numLines - 1], "<Test number=\"" + test.second + "\"/>");
             }
         }
+
+        {
+            beginTest ("Bulk property changes");
+
+            struct Counter final : public ValueTree::Listener
+            {
+                void valueTreePropertiesChanged (ValueTree&, const Array<Identifier>& properties) override
+                {
+                    ++numCallbacks;
+                    numProperties += properties.size();
+                }
+
+                int numCallbacks = 0, numProperties = 0;
+            };
+
+            UndoManager undoManager;
+            ValueTree tree ("Test");
+            tree.setProperty ("a", 1, nullptr);
+
+            Counter counter;
+            tree.addListener (&counter);
+
+            undoManager.beginNewTransaction();
+            tree.setProperties ({ { "a", 1 }, { "b", 2 }, { "c", "three" } }, &undoManager);
+            expectEquals (counter.numCallbacks, 1);
+            expectEquals (counter.numProperties, 2);
+            expectEquals ((int) tree["b"], 2);
+            expectEquals (tree["c"].toString(), String ("three"));
+
+            undoManager.beginNewTransaction();
+            tree.setProperties ({ { "a", 10 }, { "b", 20 } }, &undoManager);
+            expectEquals (counter.numCallbacks, 2);
+
+            undoManager.undo();
+            expectEquals (counter.numCallbacks, 3);
+            expectEquals ((int) tree["a"], 1);
+            expectEquals ((int) tree["b"], 2);
+
+            undoManager.undo();
+            expectEquals ((int) tree["a"], 1);
+            expect (! tree.hasProperty ("b"));
+            expect (! tree.hasProperty ("c"));
+
+            undoManager.redo();
+            expectEquals ((int) tree["b"], 2);
+
+            tree.removeListener (&counter);
+        }
+
+        {
+            beginTest ("Bulk child insertion");
+
+            struct Counter final : public ValueTree::Listener
+            {
+                void valueTreeChildrenAdded (ValueTree&, const Array<ValueTree>& children) override
+                {
+                    ++numCallbacks;
+                    numChildren += children.size();
+                }
+
+                int numCallbacks = 0, numChildren = 0;
+            };
+
+            UndoManager undoManager;
+            ValueTree tree ("Test");
+            tree.appendChild (ValueTree ("First"), nullptr);
+            tree.appendChild (ValueTree ("Last"), nullptr);
+
+            Counter counter;
+            tree.addListener (&counter);
+
+            Array<ValueTree> children;
+
+            for (int i = 0; i < 5; ++i)
+                children.add (ValueTree ("Child", { { "index", i } }));
+
+            tree.addChildren (children, 1, &undoManager);
+
+            expectEquals (counter.numCallbacks, 1);
+            expectEquals (counter.numChildren, 5);
+            expectEquals (tree.getNumChildren(), 7);
+            expect (tree.getChild (0).hasType ("First"));
+            expect (tree.getChild (6).hasType ("Last"));
+
+            for (int i = 0; i < 5; ++i)
+            {
+                expect (tree.getChild (i + 1) == children[i]);
+                expect (children[i].getParent() == tree);
+            }
+
+            undoManager.undo();
+            expectEquals (tree.getNumChildren(), 2);
+            expect (! children[0].getParent().isValid());
+
+            undoManager.redo();
+            expectEquals (tree.getNumChildren(), 7);
+            expectEquals ((int) tree.getChild (3)["index"], 2);
+
+            tree.removeListener (&counter);
+        }
+
+        {
+            beginTest ("Default bulk callbacks forward to the individual ones");
+
+            struct Recorder final : public ValueTree::Listener
+            {
+                void valueTreePropertyChanged (ValueTree&, const Identifier& property) override  { properties.add (property.toString()); }
+                void valueTreeChildAdded (ValueTree&, ValueTree&) override                       { ++numChildren; }
+
+                StringArray properties;
+                int numChildren = 0;
+            };
+
+            ValueTree tree ("Test");
+            Recorder recorder;
+            tree.addListener (&recorder);
+
+            tree.setProperties ({ { "x", 1 }, { "y", 2 } }, nullptr);
+            tree.addChildren ({ ValueTree ("A"), ValueTree ("B") }, -1, nullptr);
+
+            expect (recorder.properties == StringArray { "x", "y" });
+            expectEquals (recorder.numChildren, 2);
+
+            tree.removeListener (&recorder);
+        }
     }
 };
 
@@ -241,6 +241,19 @@ public:
     */
     ValueTree& setProperty (const Identifier& name, const var& newValue, UndoManager* undoManager);
 
+    /** Changes a group of properties of the tree in one operation.
+
+        This is equivalent to calling setProperty() for each of the values in the set, but
+        registered listeners will receive a single Listener::valueTreePropertiesChanged()
+        callback listing all the properties that actually changed, and if an UndoManager is
+        supplied, the whole group of changes will be undone and redone as a single action.
+        Properties that aren't in the set are left unchanged.
+
+        @see setProperty, Listener::valueTreePropertiesChanged
+        @returns a reference to the value tree, so that you can daisy-chain calls to this method.
+    */
+    ValueTree& setProperties (const NamedValueSet& newProperties, UndoManager* undoManager);
+
     /** Returns true if the tree contains a named property. */
     bool hasProperty (const Identifier& name) const noexcept;
 
@@ -332,6 +345,21 @@ public:
     */
     void appendChild (const ValueTree& child, UndoManager* undoManager);
 
+    /** Adds a group of children to this tree in one operation.
+
+        The children are inserted in order, starting at the given index. If the index is < 0 or
+        greater than the current number of sub-trees, they will be added at the end of the list.
+        As with addChild(), make sure that none of the children already have a parent.
+
+        Registered listeners will receive a single Listener::valueTreeChildrenAdded() callback
+        for the whole group, and if an UndoManager is supplied, adding the group will be undone
+        and redone as a single action. This makes it much cheaper than calling addChild()
+        repeatedly when building large trees.
+
+        @see addChild, Listener::valueTreeChildrenAdded
+    */
+    void addChildren (const Array<ValueTree>& newChildren, int index, UndoManager* undoManager);
+
     /** Removes the specified child from this tree's child-list.
         If the undoManager parameter is not nullptr, its UndoManager::perform() method will be used,
         so that this change can be undone. Be very careful not to mix undoable and non-undoable changes!
@@ -492,6 +520,16 @@ public:
         virtual void valueTreePropertyChanged (ValueTree& treeWhosePropertyHasChanged,
                                                const Identifier& property);
 
+        /** This method is called when a group of properties has been changed in a single
+            operation, e.g. by ValueTree::setProperties().
+
+            The default implementation simply calls valueTreePropertyChanged() for each of
+            the properties, so you only need to override this if you can handle a batch of
+            changes more efficiently than handling them individually.
+        */
+        virtual void valueTreePropertiesChanged (ValueTree& treeWhosePropertiesHaveChanged,
+                                                 const Array<Identifier>& properties);
+
         /** This method is called when a child sub-tree is added.
             Note that when you register a listener to a tree, it will receive this callback for
             child changes in both that tree and any of its children, (recursively, at any depth).
@@ -501,6 +539,16 @@ public:
         virtual void valueTreeChildAdded (ValueTree& parentTree,
                                           ValueTree& childWhichHasBeenAdded);
 
+        /** This method is called when a group of children has been added in a single
+            operation, e.g. by ValueTree::addChildren().
+
+            The default implementation simply calls valueTreeChildAdded() for each of the
+            children, so you only need to override this if you can handle a batch of
+            children more efficiently than handling them individually.
+        */
+        virtual void valueTreeChildrenAdded (ValueTree& parentTree,
+                                             const Array<ValueTree>& childrenWhichHaveBeenAdded);
+
         /** This method is called when a child sub-tree is removed.
 
             Note that when you register a listener to a tree, it will receive this callback for
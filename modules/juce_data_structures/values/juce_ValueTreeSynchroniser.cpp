@@ -35,7 +35,12 @@ namespace ValueTreeSynchroniserHelpers
         childAdded       = 3,
         childRemoved     = 4,
         childMoved       = 5,
-        propertyRemoved  = 6
+        propertyRemoved  = 6,
+        batch            = 7,
+
+        // These only appear inside a batch
+        subtreeReplaced    = 8,
+        propertiesReplaced = 9
     };
 
     static void getValueTreePath (ValueTree v, const ValueTree& topLevelTree, Array<int>& path)
@@ -90,8 +95,577 @@ namespace ValueTreeSynchroniserHelpers
 
         return v;
     }
+
+    static Array<int> getPathFromRoot (const ValueTree& v, const ValueTree& topLevelTree)
+    {
+        Array<int> path;
+        getValueTreePath (v, topLevelTree, path);
+
+        for (int i = 0, j = path.size() - 1; i < j; ++i, --j)
+            path.swap (i, j);
+
+        return path;
+    }
+
+    //==============================================================================
+    /*  Batches start with a table of the identifiers that they use, and then refer to
+        identifiers by their index in the table. Trees are written in a matching form,
+        with the type and property names as table indices.
+    */
+    class BatchReader
+    {
+    public:
+        explicit BatchReader (MemoryInputStream& in)  : input (in) {}
+
+        bool readIdentifierTable()
+        {
+            const auto numIdentifiers = input.readCompressedInt();
+
+            // each name has at least one character and a terminating zero
+            if (! isPlausibleCount (numIdentifiers, 2))
+                return false;
+
+            identifiers.ensureStorageAllocated (numIdentifiers);
+
+            for (int i = 0; i < numIdentifiers; ++i)
+            {
+                auto name = input.readString();
+
+                if (name.isEmpty())
+                    return false;
+
+                identifiers.add (name);
+            }
+
+            return true;
+        }
+
+        bool readIdentifier (Identifier& result)
+        {
+            const auto index = input.readCompressedInt();
+
+            if (! isPositiveAndBelow (index, identifiers.size()))
+                return false;
+
+            result = identifiers.getReference (index);
+            return true;
+        }
+
+        bool readProperties (NamedValueSet& properties)
+        {
+            const auto numProperties = input.readCompressedInt();
+
+            if (numProperties < 0)
+                return false;
+
+            for (int i = 0; i < numProperties; ++i)
+            {
+                Identifier name;
+
+                if (! readIdentifier (name))
+                    return false;
+
+                properties.set (name, var::readFromStream (input));
+            }
+
+            return true;
+        }
+
+        ValueTree readTree (int depth = 0)
+        {
+            Identifier type;
+
+            if (depth > 1024 || ! readIdentifier (type))
+                return {};
+
+            ValueTree v (type);
+            NamedValueSet properties;
+
+            if (! readProperties (properties))
+                return {};
+
+            v.setProperties (properties, nullptr);
+
+            const auto numChildren = input.readCompressedInt();
+
+            // each child has at least a type, a property count and a child count
+            if (! isPlausibleCount (numChildren, 3))
+                return {};
+
+            Array<ValueTree> children;
+            children.ensureStorageAllocated (numChildren);
+
+            for (int i = 0; i < numChildren; ++i)
+            {
+                auto child = readTree (depth + 1);
+
+                if (! child.isValid())
+                    return {};
+
+                children.add (child);
+            }
+
+            v.addChildren (children, -1, nullptr);
+            return v;
+        }
+
+        MemoryInputStream& input;
+
+    private:
+        Array<Identifier> identifiers;
+
+        // The counts come from the stream, so they're used to preallocate storage only
+        // if there are enough bytes left for that many items
+        bool isPlausibleCount (int count, int minBytesPerItem) const
+        {
+            return count >= 0 && (int64) count * minBytesPerItem <= input.getNumBytesRemaining();
+        }
+    };
+
+    static bool readPath (MemoryInputStream& input, Array<int>& path)
+    {
+        const int numLevels = input.readCompressedInt();
+
+        if (! isPositiveAndBelow (numLevels, 65536)) // sanity-check
+            return false;
+
+        for (int i = 0; i < numLevels; ++i)
+            path.add (input.readCompressedInt());
+
+        return true;
+    }
+
+    static ValueTree followPath (ValueTree v, const Array<int>& path, int numLevels)
+    {
+        for (int i = 0; i < numLevels; ++i)
+        {
+            if (! isPositiveAndBelow (path.getUnchecked (i), v.getNumChildren()))
+                return {};
+
+            v = v.getChild (path.getUnchecked (i));
+        }
+
+        return v;
+    }
+
+    static bool applyBatchedChange (ValueTree& root, BatchReader& reader, UndoManager* undoManager)
+    {
+        auto& input = reader.input;
+        const auto type = (ChangeType) input.readByte();
+
+        Array<int> path;
+
+        if (! readPath (input, path))
+            return false;
+
+        if (type == subtreeReplaced)
+        {
+            auto newTree = reader.readTree();
+
+            if (! newTree.isValid())
+                return false;
+
+            if (path.isEmpty())
+            {
+                if (root.hasType (newTree.getType()))
+                    root.copyPropertiesAndChildrenFrom (newTree, undoManager);
+                else
+                    root = newTree;
+
+                return true;
+            }
+
+            auto parent = followPath (root, path, path.size() - 1);
+            const auto index = path.getLast();
+
+            if (! isPositiveAndBelow (index, parent.getNumChildren()))
+                return false;
+
+            parent.removeChild (index, undoManager);
+            parent.addChild (newTree, index, undoManager);
+            return true;
+        }
+
+        auto v = followPath (root, path, path.size());
+
+        if (! v.isValid())
+            return false;
+
+        switch (type)
+        {
+            case propertyChanged:
+            {
+                Identifier property;
+
+                if (! reader.readIdentifier (property))
+                    return false;
+
+                v.setProperty (property, var::readFromStream (input), undoManager);
+                return true;
+            }
+
+            case propertyRemoved:
+            {
+                Identifier property;
+
+                if (! reader.readIdentifier (property))
+                    return false;
+
+                v.removeProperty (property, undoManager);
+                return true;
+            }
+
+            case propertiesReplaced:
+            {
+                NamedValueSet properties;
+
+                if (! reader.readProperties (properties))
+                    return false;
+
+                for (auto i = v.getNumProperties(); --i >= 0;)
+                {
+                    const auto name = v.getPropertyName (i);
+
+                    if (! properties.contains (name))
+                        v.removeProperty (name, undoManager);
+                }
+
+                v.setProperties (properties, undoManager);
+                return true;
+            }
+
+            case childAdded:
+            {
+                const auto index = input.readCompressedInt();
+                auto child = reader.readTree();
+
+                if (! child.isValid())
+                    return false;
+
+                v.addChild (child, index, undoManager);
+                return true;
+            }
+
+            case childRemoved:
+            {
+                const auto index = input.readCompressedInt();
+
+                if (! isPositiveAndBelow (index, v.getNumChildren()))
+                    return false;
+
+                v.removeChild (index, undoManager);
+                return true;
+            }
+
+            case childMoved:
+            {
+                const auto oldIndex = input.readCompressedInt();
+                const auto newIndex = input.readCompressedInt();
+
+                if (! (isPositiveAndBelow (oldIndex, v.getNumChildren())
+                        && isPositiveAndBelow (newIndex, v.getNumChildren())))
+                    return false;
+
+                v.moveChild (oldIndex, newIndex, undoManager);
+                return true;
+            }
+
+            case fullSync:
+            case batch:
+            case subtreeReplaced:
+            default:
+                break;
+        }
+
+        return false;
+    }
+
+    static bool applyBatch (ValueTree& root, MemoryInputStream& input, UndoManager* undoManager)
+    {
+        BatchReader reader (input);
+
+        if (! reader.readIdentifierTable())
+            return false;
+
+        const auto numChanges = input.readCompressedInt();
+
+        if (numChanges < 0)
+            return false;
+
+        for (int i = 0; i < numChanges; ++i)
+            if (! applyBatchedChange (root, reader, undoManager))
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
+    /*  A resync request holds a hash of every node in the target tree, in depth-first
+        order. Each entry stores enough information to skip over the node's sub-tree,
+        so the source can walk its own tree alongside it and only descend into the
+        sub-trees whose hashes differ.
+    */
+    struct NodeHash
+    {
+        uint32 typeHash = 0;
+        uint64 propertiesHash = 0, subtreeHash = 0;
+        int numChildren = 0, subtreeSize = 1;
+    };
+
+    static constexpr size_t nodeHashSize = 4 + 8 + 8 + 4 + 4;
+
+    static uint64 hashBytes (const void* data, size_t numBytes, uint64 hash = 0xcbf29ce484222325ULL) noexcept
+    {
+        for (auto* p = static_cast<const uint8*> (data); numBytes > 0; --numBytes, ++p)
+            hash = (hash ^ *p) * 0x100000001b3ULL;
+
+        return hash;
+    }
+
+    static uint64 hashValue (uint64 value, uint64 hash) noexcept
+    {
+        const auto littleEndian = ByteOrder::swapIfBigEndian (value);
+        return hashBytes (&littleEndian, sizeof (littleEndian), hash);
+    }
+
+    static uint64 hashString (const String& s) noexcept
+    {
+        return hashBytes (s.toRawUTF8(), s.getNumBytesAsUTF8());
+    }
+
+    static uint64 appendNodeHashes (const ValueTree& v, std::vector<NodeHash>& hashes, MemoryOutputStream& scratch)
+    {
+        const auto index = hashes.size();
+        hashes.emplace_back();
+
+        NodeHash node;
+        node.typeHash = (uint32) hashString (v.getType().toString());
+        node.numChildren = v.getNumChildren();
+
+        // Properties are combined with an addition so that their order doesn't matter
+        for (int i = 0; i < v.getNumProperties(); ++i)
+        {
+            const auto name = v.getPropertyName (i);
+            scratch.reset();
+            scratch.writeString (name.toString());
+            v[name].writeToStream (scratch);
+            node.propertiesHash += hashBytes (scratch.getData(), scratch.getDataSize());
+        }
+
+        auto subtreeHash = hashValue (node.propertiesHash, hashValue (node.typeHash, hashValue ((uint64) node.numChildren, 0xcbf29ce484222325ULL)));
+
+        for (const auto& child : v)
+            subtreeHash = hashValue (appendNodeHashes (child, hashes, scratch), subtreeHash);
+
+        node.subtreeHash = subtreeHash;
+        node.subtreeSize = (int) (hashes.size() - index);
+        hashes[index] = node;
+        return subtreeHash;
+    }
+
+    static std::vector<NodeHash> createNodeHashes (const ValueTree& v)
+    {
+        std::vector<NodeHash> hashes;
+        MemoryOutputStream scratch;
+
+        if (v.isValid())
+            appendNodeHashes (v, hashes, scratch);
+
+        return hashes;
+    }
+
+    static bool readNodeHashes (const void* data, size_t dataSize, std::vector<NodeHash>& hashes)
+    {
+        MemoryInputStream input (data, dataSize, false);
+        const auto numNodes = input.readInt();
+
+        if (numNodes < 0 || (size_t) numNodes * nodeHashSize + 4 != dataSize)
+            return false;
+
+        hashes.resize ((size_t) numNodes);
+
+        for (auto& node : hashes)
+        {
+            node.typeHash       = (uint32) input.readInt();
+            node.propertiesHash = (uint64) input.readInt64();
+            node.subtreeHash    = (uint64) input.readInt64();
+            node.numChildren    = input.readInt();
+            node.subtreeSize    = input.readInt();
+        }
+
+        // Check that the structure is self-consistent before trusting it
+        for (size_t i = 0; i < hashes.size(); ++i)
+            if (hashes[i].numChildren < 0 || hashes[i].subtreeSize < 1 + hashes[i].numChildren
+                 || i + (size_t) hashes[i].subtreeSize > hashes.size())
+                return false;
+
+        return true;
+    }
 }
 
+//==============================================================================
+class ValueTreeSynchroniser::BatchWriter
+{
+public:
+    bool isEmpty() const noexcept   { return changes.isEmpty(); }
+
+    void clear()
+    {
+        changes.clear();
+        identifiers.clear();
+        identifierIndices.clear();
+        propertyChangeIndices.clear();
+    }
+
+    void addPropertyChange (const Array<int>& path, const ValueTree& v, const Identifier& property)
+    {
+        using namespace ValueTreeSynchroniserHelpers;
+
+        // A later change to the same property replaces any earlier one, as long as nothing has
+        // happened to the structure of the tree in between that could have changed its path.
+        String key;
+
+        for (auto index : path)
+            key << index << '/';
+
+        key << property.toString();
+
+        auto existing = propertyChangeIndices.find (key);
+        auto& out = existing != propertyChangeIndices.end() ? *changes.getUnchecked (existing->second)
+                                                          : beginChange();
+
+        if (existing == propertyChangeIndices.end())
+            propertyChangeIndices.emplace (key, changes.size() - 1);
+
+        out.reset();
+
+        if (auto* value = v.getPropertyPointer (property))
+        {
+            writeChangeHeader (out, propertyChanged, path);
+            out.writeCompressedInt (getIdentifierIndex (property));
+            value->writeToStream (out);
+        }
+        else
+        {
+            writeChangeHeader (out, propertyRemoved, path);
+            out.writeCompressedInt (getIdentifierIndex (property));
+        }
+    }
+
+    void addChildAdded (const Array<int>& path, int index, const ValueTree& child)
+    {
+        auto& out = beginStructuralChange (ValueTreeSynchroniserHelpers::childAdded, path);
+        out.writeCompressedInt (index);
+        writeTree (out, child);
+    }
+
+    void addChildRemoved (const Array<int>& path, int index)
+    {
+        auto& out = beginStructuralChange (ValueTreeSynchroniserHelpers::childRemoved, path);
+        out.writeCompressedInt (index);
+    }
+
+    void addChildMoved (const Array<int>& path, int oldIndex, int newIndex)
+    {
+        auto& out = beginStructuralChange (ValueTreeSynchroniserHelpers::childMoved, path);
+        out.writeCompressedInt (oldIndex);
+        out.writeCompressedInt (newIndex);
+    }
+
+    void addSubtreeReplaced (const Array<int>& path, const ValueTree& v)
+    {
+        auto& out = beginStructuralChange (ValueTreeSynchroniserHelpers::subtreeReplaced, path);
+        writeTree (out, v);
+    }
+
+    void addPropertiesReplaced (const Array<int>& path, const ValueTree& v)
+    {
+        auto& out = beginStructuralChange (ValueTreeSynchroniserHelpers::propertiesReplaced, path);
+        writeProperties (out, v);
+    }
+
+    MemoryBlock createMessage() const
+    {
+        MemoryOutputStream m;
+        ValueTreeSynchroniserHelpers::writeHeader (m, ValueTreeSynchroniserHelpers::batch);
+
+        m.writeCompressedInt (identifiers.size());
+
+        for (auto& id : identifiers)
+            m.writeString (id.toString());
+
+        m.writeCompressedInt (changes.size());
+
+        for (auto* change : changes)
+            m.write (change->getData(), change->getDataSize());
+
+        return m.getMemoryBlock();
+    }
+
+private:
+    OwnedArray<MemoryOutputStream> changes;
+    Array<Identifier> identifiers;
+    std::unordered_map<const void*, int> identifierIndices;
+    std::unordered_map<String, int> propertyChangeIndices;
+
+    int getIdentifierIndex (const Identifier& id)
+    {
+        // Identifiers are pooled, so their string pointers are unique
+        const auto result = identifierIndices.emplace (id.getCharPointer().getAddress(), identifiers.size());
+
+        if (result.second)
+            identifiers.add (id);
+
+        return result.first->second;
+    }
+
+    MemoryOutputStream& beginChange()
+    {
+        return *changes.add (new MemoryOutputStream());
+    }
+
+    MemoryOutputStream& beginStructuralChange (ValueTreeSynchroniserHelpers::ChangeType type, const Array<int>& path)
+    {
+        propertyChangeIndices.clear();
+
+        auto& out = beginChange();
+        writeChangeHeader (out, type, path);
+        return out;
+    }
+
+    static void writeChangeHeader (MemoryOutputStream& out, ValueTreeSynchroniserHelpers::ChangeType type, const Array<int>& path)
+    {
+        ValueTreeSynchroniserHelpers::writeHeader (out, type);
+        out.writeCompressedInt (path.size());
+
+        for (auto index : path)
+            out.writeCompressedInt (index);
+    }
+
+    void writeProperties (MemoryOutputStream& out, const ValueTree& v)
+    {
+        out.writeCompressedInt (v.getNumProperties());
+
+        for (int i = 0; i < v.getNumProperties(); ++i)
+        {
+            const auto name = v.getPropertyName (i);
+            out.writeCompressedInt (getIdentifierIndex (name));
+            v[name].writeToStream (out);
+        }
+    }
+
+    void writeTree (MemoryOutputStream& out, const ValueTree& v)
+    {
+        out.writeCompressedInt (getIdentifierIndex (v.getType()));
+        writeProperties (out, v);
+        out.writeCompressedInt (v.getNumChildren());
+
+        for (const auto& child : v)
+            writeTree (out, child);
+    }
+};
+
+//==============================================================================
 ValueTreeSynchroniser::ValueTreeSynchroniser (const ValueTree& tree)  : valueTree (tree)
 {
     valueTree.addListener (this);
@@ -104,14 +678,217 @@ ValueTreeSynchroniser::~ValueTreeSynchroniser()
 
 void ValueTreeSynchroniser::sendFullSyncCallback()
 {
+    if (pendingChanges != nullptr)
+        pendingChanges->clear();
+
     MemoryOutputStream m;
     writeHeader (m, ValueTreeSynchroniserHelpers::fullSync);
     valueTree.writeToStream (m);
     stateChanged (m.getData(), m.getDataSize());
 }
 
+//==============================================================================
+MemoryBlock ValueTreeSynchroniser::createResyncRequest (const ValueTree& target)
+{
+    const auto hashes = ValueTreeSynchroniserHelpers::createNodeHashes (target);
+
+    MemoryOutputStream m (hashes.size() * ValueTreeSynchroniserHelpers::nodeHashSize + 4);
+    m.writeInt ((int) hashes.size());
+
+    for (auto& node : hashes)
+    {
+        m.writeInt ((int) node.typeHash);
+        m.writeInt64 ((int64) node.propertiesHash);
+        m.writeInt64 ((int64) node.subtreeHash);
+        m.writeInt (node.numChildren);
+        m.writeInt (node.subtreeSize);
+    }
+
+    return m.getMemoryBlock();
+}
+
+void ValueTreeSynchroniser::sendResyncCallback (const void* resyncRequest, size_t resyncRequestSize)
+{
+    using namespace ValueTreeSynchroniserHelpers;
+
+    std::vector<NodeHash> remote;
+
+    if (! readNodeHashes (resyncRequest, resyncRequestSize, remote))
+    {
+        jassertfalse; // This doesn't seem to be a valid request
+        return;
+    }
+
+    const auto local = createNodeHashes (valueTree);
+
+    if (pendingChanges != nullptr)
+        pendingChanges->clear();
+
+    BatchWriter writer;
+    Array<int> path;
+
+    std::function<void (const ValueTree&, size_t, size_t)> compare = [&] (const ValueTree& v, size_t localIndex, size_t remoteIndex)
+    {
+        const auto& localNode = local[localIndex];
+        const auto& remoteNode = remote[remoteIndex];
+
+        if (localNode.subtreeHash == remoteNode.subtreeHash)
+            return;
+
+        if (localNode.typeHash != remoteNode.typeHash)
+        {
+            writer.addSubtreeReplaced (path, v);
+            return;
+        }
+
+        if (localNode.propertiesHash != remoteNode.propertiesHash)
+            writer.addPropertiesReplaced (path, v);
+
+        std::vector<size_t> localChildren, remoteChildren;
+
+        for (auto i = localIndex + 1; localChildren.size() < (size_t) localNode.numChildren; i += (size_t) local[i].subtreeSize)
+            localChildren.push_back (i);
+
+        for (auto i = remoteIndex + 1; remoteChildren.size() < (size_t) remoteNode.numChildren; i += (size_t) remote[i].subtreeSize)
+            remoteChildren.push_back (i);
+
+        // The two lists of children are walked together. Unchanged children are skipped,
+        // children that only exist on one side are added or removed, and any others are
+        // paired up and compared recursively.
+        std::unordered_map<uint64, int> unusedLocal, unusedRemote;
+
+        for (auto i : localChildren)   ++unusedLocal[local[i].subtreeHash];
+        for (auto i : remoteChildren)  ++unusedRemote[remote[i].subtreeHash];
+
+        const auto isUnused = [] (const std::unordered_map<uint64, int>& counts, uint64 hash)
+        {
+            auto iter = counts.find (hash);
+            return iter != counts.end() && iter->second > 0;
+        };
+
+        size_t l = 0, r = 0;
+        int index = 0;
+
+        while (l < localChildren.size() && r < remoteChildren.size())
+        {
+            const auto localHash  = local[localChildren[l]].subtreeHash;
+            const auto remoteHash = remote[remoteChildren[r]].subtreeHash;
+            const auto remoteChildIsUsedLater = isUnused (unusedLocal, remoteHash);
+            const auto localChildIsUsedLater = isUnused (unusedRemote, localHash);
+
+            if (localHash != remoteHash && localChildIsUsedLater && ! remoteChildIsUsedLater)
+            {
+                writer.addChildRemoved (path, index);
+                --unusedRemote[remoteHash];
+                ++r;
+            }
+            else if (localHash != remoteHash && remoteChildIsUsedLater && ! localChildIsUsedLater)
+            {
+                writer.addChildAdded (path, index, v.getChild ((int) l));
+                --unusedLocal[localHash];
+                ++l;
+                ++index;
+            }
+            else
+            {
+                path.add (index);
+                compare (v.getChild ((int) l), localChildren[l], remoteChildren[r]);
+                path.removeLast();
+
+                --unusedLocal[localHash];
+                --unusedRemote[remoteHash];
+                ++l;
+                ++r;
+                ++index;
+            }
+        }
+
+        for (; r < remoteChildren.size(); ++r)
+            writer.addChildRemoved (path, index);
+
+        for (; l < localChildren.size(); ++l, ++index)
+            writer.addChildAdded (path, index, v.getChild ((int) l));
+    };
+
+    if (remote.empty() || local.empty())
+        writer.addSubtreeReplaced (path, valueTree);
+    else
+        compare (valueTree, 0, 0);
+
+    const auto message = writer.createMessage();
+    stateChanged (message.getData(), message.getSize());
+}
+
+//==============================================================================
+void ValueTreeSynchroniser::setBatchingInterval (int milliseconds)
+{
+    batchingInterval = jmax (0, milliseconds);
+
+    if (batchingInterval > 0)
+    {
+        if (pendingChanges == nullptr)
+            pendingChanges = std::make_unique<BatchWriter>();
+
+        if (isTimerRunning())
+            startTimer (batchingInterval);
+    }
+    else
+    {
+        flushPendingChanges();
+        pendingChanges.reset();
+    }
+}
+
+void ValueTreeSynchroniser::flushPendingChanges()
+{
+    stopTimer();
+
+    if (pendingChanges == nullptr || pendingChanges->isEmpty())
+        return;
+
+    const auto message = pendingChanges->createMessage();
+    pendingChanges->clear();
+    stateChanged (message.getData(), message.getSize());
+}
+
+void ValueTreeSynchroniser::timerCallback()
+{
+    flushPendingChanges();
+}
+
+ValueTreeSynchroniser::BatchWriter& ValueTreeSynchroniser::getBatchWriter (std::unique_ptr<BatchWriter>& temporary)
+{
+    if (pendingChanges != nullptr)
+        return *pendingChanges;
+
+    temporary = std::make_unique<BatchWriter>();
+    return *temporary;
+}
+
+void ValueTreeSynchroniser::sendBatch (std::unique_ptr<BatchWriter>& temporary)
+{
+    if (temporary != nullptr)
+    {
+        const auto message = temporary->createMessage();
+        stateChanged (message.getData(), message.getSize());
+    }
+    else if (! isTimerRunning())
+    {
+        startTimer (batchingInterval);
+    }
+}
+
+//==============================================================================
 void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Identifier& property)
 {
+    if (pendingChanges != nullptr)
+    {
+        std::unique_ptr<BatchWriter> temporary;
+        getBatchWriter (temporary).addPropertyChange (ValueTreeSynchroniserHelpers::getPathFromRoot (vt, valueTree), vt, property);
+        sendBatch (temporary);
+        return;
+    }
+
     MemoryOutputStream m;
 
     if (auto* value = vt.getPropertyPointer (property))
@@ -129,11 +906,41 @@ void ValueTreeSynchroniser::valueTreePropertyChanged (ValueTree& vt, const Ident
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::valueTreePropertiesChanged (ValueTree& vt, const Array<Identifier>& properties)
+{
+    // Without batching, each change is sent in the format that older receivers understand
+    if (pendingChanges == nullptr)
+    {
+        for (auto& property : properties)
+            valueTreePropertyChanged (vt, property);
+
+        return;
+    }
+
+    const auto path = ValueTreeSynchroniserHelpers::getPathFromRoot (vt, valueTree);
+
+    std::unique_ptr<BatchWriter> temporary;
+    auto& writer = getBatchWriter (temporary);
+
+    for (auto& property : properties)
+        writer.addPropertyChange (path, vt, property);
+
+    sendBatch (temporary);
+}
+
 void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTree& childTree)
 {
     const int index = parentTree.indexOf (childTree);
     jassert (index >= 0);
 
+    if (pendingChanges != nullptr)
+    {
+        std::unique_ptr<BatchWriter> temporary;
+        getBatchWriter (temporary).addChildAdded (ValueTreeSynchroniserHelpers::getPathFromRoot (parentTree, valueTree), index, childTree);
+        sendBatch (temporary);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childAdded, parentTree);
     m.writeCompressedInt (index);
@@ -141,8 +948,41 @@ void ValueTreeSynchroniser::valueTreeChildAdded (ValueTree& parentTree, ValueTre
     stateChanged (m.getData(), m.getDataSize());
 }
 
+void ValueTreeSynchroniser::valueTreeChildrenAdded (ValueTree& parentTree, const Array<ValueTree>& children)
+{
+    if (pendingChanges == nullptr)
+    {
+        for (auto child : children)
+            valueTreeChildAdded (parentTree, child);
+
+        return;
+    }
+
+    const auto path = ValueTreeSynchroniserHelpers::getPathFromRoot (parentTree, valueTree);
+
+    std::unique_ptr<BatchWriter> temporary;
+    auto& writer = getBatchWriter (temporary);
+
+    // The children of a bulk add always end up next to each other
+    const auto firstIndex = parentTree.indexOf (children.getFirst());
+    jassert (firstIndex >= 0);
+
+    for (int i = 0; i < children.size(); ++i)
+        writer.addChildAdded (path, firstIndex + i, children.getReference (i));
+
+    sendBatch (temporary);
+}
+
 void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueTree&, int oldIndex)
 {
+    if (pendingChanges != nullptr)
+    {
+        std::unique_ptr<BatchWriter> temporary;
+        getBatchWriter (temporary).addChildRemoved (ValueTreeSynchroniserHelpers::getPathFromRoot (parentTree, valueTree), oldIndex);
+        sendBatch (temporary);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childRemoved, parentTree);
     m.writeCompressedInt (oldIndex);
@@ -151,6 +991,14 @@ void ValueTreeSynchroniser::valueTreeChildRemoved (ValueTree& parentTree, ValueT
 
 void ValueTreeSynchroniser::valueTreeChildOrderChanged (ValueTree& parent, int oldIndex, int newIndex)
 {
+    if (pendingChanges != nullptr)
+    {
+        std::unique_ptr<BatchWriter> temporary;
+        getBatchWriter (temporary).addChildMoved (ValueTreeSynchroniserHelpers::getPathFromRoot (parent, valueTree), oldIndex, newIndex);
+        sendBatch (temporary);
+        return;
+    }
+
     MemoryOutputStream m;
     ValueTreeSynchroniserHelpers::writeHeader (*this, m, ValueTreeSynchroniserHelpers::childMoved, parent);
     m.writeCompressedInt (oldIndex);
@@ -170,6 +1018,15 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         return true;
     }
 
+    if (type == ValueTreeSynchroniserHelpers::batch)
+    {
+        if (ValueTreeSynchroniserHelpers::applyBatch (root, input, undoManager))
+            return true;
+
+        jassertfalse; // Either received some corrupt data, or the trees have drifted out of sync
+        return false;
+    }
+
     ValueTree v (ValueTreeSynchroniserHelpers::readSubTreeLocation (input, root));
 
     if (! v.isValid())
@@ -229,6 +1086,9 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
         }
 
         case ValueTreeSynchroniserHelpers::fullSync:
+        case ValueTreeSynchroniserHelpers::batch:
+        case ValueTreeSynchroniserHelpers::subtreeReplaced:
+        case ValueTreeSynchroniserHelpers::propertiesReplaced:
             break;
 
         default:
@@ -239,4 +1099,219 @@ bool ValueTreeSynchroniser::applyChange (ValueTree& root, const void* data, size
     return false;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ValueTreeSynchroniserTests  : public UnitTest
+{
+public:
+    ValueTreeSynchroniserTests()
+        : UnitTest ("ValueTreeSynchroniser", UnitTestCategories::values)
+    {}
+
+    struct TestSynchroniser  : public ValueTreeSynchroniser
+    {
+        TestSynchroniser (const ValueTree& source, ValueTree& targetTree)
+            : ValueTreeSynchroniser (source), target (targetTree)
+        {}
+
+        void stateChanged (const void* data, size_t size) override
+        {
+            ++numMessages;
+            lastMessageSize = size;
+            applyChange (target, data, size, nullptr);
+        }
+
+        ValueTree& target;
+        int numMessages = 0;
+        size_t lastMessageSize = 0;
+    };
+
+    static ValueTree createTree (int numChildren)
+    {
+        ValueTree root ("root");
+        root.setProperty ("name", "test", nullptr);
+
+        for (int i = 0; i < numChildren; ++i)
+        {
+            ValueTree child ("child");
+            child.setProperty ("index", i, nullptr);
+            child.setProperty ("value", i * 0.5, nullptr);
+            child.appendChild (ValueTree ("leaf").setProperty ("text", String (i), nullptr), nullptr);
+            root.appendChild (child, nullptr);
+        }
+
+        return root;
+    }
+
+    void runTest() override
+    {
+        beginTest ("Individual changes are sent immediately when batching is disabled");
+        {
+            ValueTree source ("root"), target;
+            TestSynchroniser sync (source, target);
+            sync.sendFullSyncCallback();
+
+            source.setProperty ("a", 1, nullptr);
+            source.appendChild (ValueTree ("child"), nullptr);
+            source.getChild (0).setProperty ("b", "text", nullptr);
+            source.removeProperty ("a", nullptr);
+
+            expectEquals (sync.numMessages, 5);
+            expect (source.isEquivalentTo (target));
+        }
+
+        const auto applyBulkChanges = [] (ValueTree& source)
+        {
+            NamedValueSet properties;
+            properties.set ("x", 1);
+            properties.set ("y", 2.0);
+            properties.set ("z", "three");
+            source.setProperties (properties, nullptr);
+
+            Array<ValueTree> children;
+
+            for (int i = 0; i < 10; ++i)
+                children.add (ValueTree ("child").setProperty ("index", i, nullptr));
+
+            source.addChildren (children, 0, nullptr);
+        };
+
+        beginTest ("Bulk operations send one change per item when batching is disabled");
+        {
+            ValueTree source ("root"), target;
+            TestSynchroniser sync (source, target);
+            sync.sendFullSyncCallback();
+
+            applyBulkChanges (source);
+
+            expectEquals (sync.numMessages, 1 + 3 + 10);
+            expect (source.isEquivalentTo (target));
+        }
+
+        beginTest ("Bulk operations are sent as a single message when batching is enabled");
+        {
+            ValueTree source ("root"), target;
+            TestSynchroniser sync (source, target);
+            sync.sendFullSyncCallback();
+            sync.setBatchingInterval (1000);
+
+            applyBulkChanges (source);
+            sync.flushPendingChanges();
+
+            expectEquals (sync.numMessages, 2);
+            expect (source.isEquivalentTo (target));
+        }
+
+        beginTest ("Batched changes are coalesced");
+        {
+            auto source = createTree (4);
+            ValueTree target;
+            TestSynchroniser sync (source, target);
+            sync.sendFullSyncCallback();
+            sync.setBatchingInterval (1000);
+
+            for (int i = 0; i < 100; ++i)
+                source.getChild (2).setProperty ("value", i, nullptr);
+
+            source.getChild (1).getChild (0).setProperty ("text", "changed", nullptr);
+            source.removeChild (0, nullptr);
+            source.getChild (0).removeProperty ("index", nullptr);
+            source.moveChild (0, 2, nullptr);
+            source.appendChild (ValueTree ("extra").setProperty ("n", 5, nullptr), nullptr);
+
+            expectEquals (sync.numMessages, 1);
+            expect (! source.isEquivalentTo (target));
+
+            sync.flushPendingChanges();
+
+            expectEquals (sync.numMessages, 2);
+            expect (source.isEquivalentTo (target));
+
+            sync.flushPendingChanges();
+            expectEquals (sync.numMessages, 2);
+        }
+
+        beginTest ("Resync only sends the differences");
+        {
+            auto source = createTree (200);
+            auto target = source.createCopy();
+
+            source.getChild (10).setProperty ("value", "new", nullptr);
+            source.getChild (50).getChild (0).removeProperty ("text", nullptr);
+            source.removeChild (120, nullptr);
+            source.addChild (ValueTree ("inserted"), 30, nullptr);
+            target.getChild (199).appendChild (ValueTree ("stale"), nullptr);
+            target.setProperty ("remoteOnly", true, nullptr);
+
+            TestSynchroniser sync (source, target);
+            const auto request = ValueTreeSynchroniser::createResyncRequest (target);
+            sync.sendResyncCallback (request.getData(), request.getSize());
+
+            expectEquals (sync.numMessages, 1);
+            expect (source.isEquivalentTo (target));
+
+            MemoryOutputStream fullState;
+            source.writeToStream (fullState);
+            expect (sync.lastMessageSize < fullState.getDataSize() / 4);
+        }
+
+        beginTest ("Resync replaces trees of a different type");
+        {
+            auto source = createTree (3);
+            ValueTree target ("somethingElse");
+
+            TestSynchroniser sync (source, target);
+            const auto request = ValueTreeSynchroniser::createResyncRequest (target);
+            sync.sendResyncCallback (request.getData(), request.getSize());
+
+            expect (source.isEquivalentTo (target));
+
+            // Resyncing two identical trees should result in an empty batch
+            const auto secondRequest = ValueTreeSynchroniser::createResyncRequest (target);
+            sync.sendResyncCallback (secondRequest.getData(), secondRequest.getSize());
+
+            expectEquals (sync.numMessages, 2);
+            expect (source.isEquivalentTo (target));
+        }
+
+        beginTest ("Batches with impossible counts are rejected");
+        {
+            const auto createBatch = [] (int numIdentifiers, int numChildren)
+            {
+                MemoryOutputStream m;
+                m.writeByte ((char) ValueTreeSynchroniserHelpers::batch);
+                m.writeCompressedInt (numIdentifiers);
+                m.writeString ("tree");
+                m.writeCompressedInt (1); // number of changes
+                m.writeByte ((char) ValueTreeSynchroniserHelpers::subtreeReplaced);
+                m.writeCompressedInt (0); // path length
+                m.writeCompressedInt (0); // type
+                m.writeCompressedInt (0); // number of properties
+                m.writeCompressedInt (numChildren);
+                return m.getMemoryBlock();
+            };
+
+            // These counts would have been used to preallocate gigabytes of storage
+            for (const auto& [numIdentifiers, numChildren] : { std::make_pair ((1 << 24) - 1, 0),
+                                                               std::make_pair (1, std::numeric_limits<int>::max()) })
+            {
+                ValueTree target ("tree");
+                const auto batch = createBatch (numIdentifiers, numChildren);
+                expect (! ValueTreeSynchroniser::applyChange (target, batch.getData(), batch.getSize(), nullptr));
+                expectEquals (target.getNumChildren(), 0);
+            }
+
+            ValueTree target ("tree");
+            const auto validBatch = createBatch (1, 0);
+            expect (ValueTreeSynchroniser::applyChange (target, validBatch.getData(), validBatch.getSize(), nullptr));
+        }
+    }
+};
+
+static ValueTreeSynchroniserTests valueTreeSynchroniserTests;
+
+#endif
+
 } // namespace juce
@@ -40,9 +40,24 @@ namespace juce
     via a network or other means) to a remote destination, where it can be
     applied to a target tree.
 
+    By default, each change to the tree is sent as soon as it happens. If the tree
+    changes frequently, you can call setBatchingInterval() to have the changes
+    collected and sent together in a compact batch, in which repeated changes to the
+    same property are merged, and identifiers are only written once.
+
+    If a target tree may have drifted out of sync, rather than sending the whole tree
+    with sendFullSyncCallback(), the receiving side can call createResyncRequest() to
+    make a compact summary of its tree's contents, and send it back to be passed to
+    sendResyncCallback(), which will only send the parts of the tree that differ.
+
+    Note that changes which are batched, or sent in response to a resync request, use
+    an encoding that older versions of applyChange() won't understand, so both ends of
+    the connection should be using the same version of this class.
+
     @tags{DataStructures}
 */
-class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener
+class JUCE_API  ValueTreeSynchroniser  : private ValueTree::Listener,
+                                         private Timer
 {
 public:
     /** Creates a ValueTreeSynchroniser that watches the given tree.
@@ -70,6 +85,49 @@ public:
     */
     void sendFullSyncCallback();
 
+    /** Sends only the parts of the tree which differ from a target tree.
+
+        The resyncRequest data must have been created by createResyncRequest() from
+        the target tree. The tree being watched is compared with the hashes in the
+        request, and stateChanged() is invoked with a single message containing just
+        the sub-trees and properties that need to change for the target to match.
+
+        The target tree shouldn't be modified between creating the request and applying
+        the resulting change, and any batched changes that haven't been sent yet are
+        discarded, as the resync supersedes them.
+    */
+    void sendResyncCallback (const void* resyncRequest, size_t resyncRequestSize);
+
+    /** Creates a compact summary of a tree's contents, which can be sent to the
+        ValueTreeSynchroniser that is the source of its changes, and passed to its
+        sendResyncCallback() method.
+
+        The summary contains a hash of each node in the tree, so it's typically much
+        smaller than the tree itself.
+    */
+    static MemoryBlock createResyncRequest (const ValueTree& target);
+
+    /** Enables or disables the batching of changes.
+
+        When the interval is greater than zero, changes to the tree are collected, and
+        sent in a single call to stateChanged() at most once per interval. Changes to the
+        same property within a batch are merged, so only the latest value is sent.
+
+        When the interval is zero (the default), each change is sent as soon as it happens.
+        Disabling batching will send any changes that are still pending.
+
+        Batches are sent by a Timer, so this should only be used on the message thread.
+    */
+    void setBatchingInterval (int milliseconds);
+
+    /** Immediately sends any changes that have been batched but not yet sent.
+
+        If you're using batching, you may want to call this from your subclass's
+        destructor, as any changes that are still pending will be lost when this
+        object is deleted.
+    */
+    void flushPendingChanges();
+
     /** Applies an encoded change to the given destination tree.
 
         When you implement a receiver for changes that were sent by the stateChanged()
@@ -84,10 +142,20 @@ public:
     const ValueTree& getRoot() noexcept       { return valueTree; }
 
 private:
+    class BatchWriter;
+
     ValueTree valueTree;
+    std::unique_ptr<BatchWriter> pendingChanges;
+    int batchingInterval = 0;
+
+    BatchWriter& getBatchWriter (std::unique_ptr<BatchWriter>& temporary);
+    void sendBatch (std::unique_ptr<BatchWriter>& temporary);
+    void timerCallback() override;
 
     void valueTreePropertyChanged (ValueTree&, const Identifier&) override;
+    void valueTreePropertiesChanged (ValueTree&, const Array<Identifier>&) override;
     void valueTreeChildAdded (ValueTree&, ValueTree&) override;
+    void valueTreeChildrenAdded (ValueTree&, const Array<ValueTree>&) override;
     void valueTreeChildRemoved (ValueTree&, ValueTree&, int) override;
     void valueTreeChildOrderChanged (ValueTree&, int, int) override;
 
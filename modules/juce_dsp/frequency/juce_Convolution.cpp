@@ -154,7 +154,7 @@ struct ConvolutionEngine
         : blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
           fftSize (blockSize > 128 ? 2 * blockSize : 4 * blockSize),
           fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
-          numSegments (numSamples / (fftSize - blockSize) + 1u),
+          numSegments (jmax ((size_t) 1, (numSamples + fftSize - blockSize - 1) / (fftSize - blockSize))),
           numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
           bufferInput      (1, static_cast<int> (fftSize)),
           bufferOutput     (1, static_cast<int> (fftSize * 2)),
@@ -439,6 +439,275 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+// Convolves the input with a section of the impulse response which starts at
+// least one partition after the beginning of the IR.
+//
+// A deferred stage starts at least two partitions into the IR, so the output for
+// each partition of input is only required once the following partition of input
+// has been collected. That leaves a whole partition's worth of time in which to
+// compute it, which is spent on a background thread. If the background thread
+// falls behind, the audio thread picks up the work itself, so the result never
+// depends on the scheduling of the background thread.
+class ConvolutionStage
+{
+public:
+    ConvolutionStage (const AudioBuffer<float>& buf,
+                      int offset,
+                      int length,
+                      int partitionSize,
+                      int requiredDelay,
+                      bool shouldBeDeferred)
+        : blockSize (static_cast<size_t> (partitionSize)),
+          isDeferred (shouldBeDeferred)
+    {
+        constexpr auto numChannels = 2;
+
+        // The engines have a latency of one partition, and deferring the work adds
+        // another. The rest of the delay is padded with zeros.
+        const auto padding = requiredDelay - (isDeferred ? 2 : 1) * partitionSize;
+        jassert (padding >= 0);
+
+        AudioBuffer<float> segment (1, padding + length);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            segment.clear();
+            segment.copyFrom (0, padding, buf, jmin (buf.getNumChannels() - 1, i), offset, length);
+
+            engines.emplace_back (std::make_unique<ConvolutionEngine> (segment.getReadPointer (0),
+                                                                       static_cast<size_t> (segment.getNumSamples()),
+                                                                       blockSize));
+        }
+
+        for (auto* buffers : { &inputs, &outputs })
+            for (auto& b : *buffers)
+                b.setSize (numChannels, partitionSize);
+
+        scratch.setSize (1, partitionSize);
+
+        reset();
+    }
+
+    void reset()
+    {
+        waitForPendingJob();
+
+        for (const auto& e : engines)
+            e->reset();
+
+        for (auto* buffers : { &inputs, &outputs })
+            for (auto& b : *buffers)
+                b.clear();
+
+        position = 0;
+    }
+
+    // Adds the output of this stage to the output block
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, size_t numChannels)
+    {
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+
+        if (! isDeferred)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                for (size_t done = 0; done < numSamples;)
+                {
+                    const auto todo = jmin (numSamples - done, blockSize);
+                    auto* tempData = scratch.getWritePointer (0);
+
+                    engines[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel) + done, tempData, todo);
+                    FloatVectorOperations::add (output.getChannelPointer (channel) + done, tempData, static_cast<int> (todo));
+
+                    done += todo;
+                }
+            }
+
+            return;
+        }
+
+        for (size_t done = 0; done < numSamples;)
+        {
+            const auto todo = jmin (numSamples - done, blockSize - position);
+            auto& gathered = inputs[(size_t) front];
+            const auto& ready = outputs[(size_t) front];
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                FloatVectorOperations::copy (gathered.getWritePointer ((int) channel, (int) position),
+                                             input.getChannelPointer (channel) + done,
+                                             static_cast<int> (todo));
+                FloatVectorOperations::add (output.getChannelPointer (channel) + done,
+                                            ready.getReadPointer ((int) channel, (int) position),
+                                            static_cast<int> (todo));
+            }
+
+            done += todo;
+            position += todo;
+
+            if (position == blockSize)
+            {
+                position = 0;
+                startJob (numChannels);
+            }
+        }
+    }
+
+    bool isDeferredStage() const noexcept { return isDeferred; }
+    size_t getPartitionSize() const noexcept { return blockSize; }
+
+    // The semaphore to signal when a new job is available. Signalling it never
+    // takes a lock, so it's safe to do on the audio thread.
+    void setWorkAvailableSignal (juce::detail::Semaphore* semaphore) noexcept { workAvailable = semaphore; }
+
+    // Called on the background thread. Returns true if some work was done.
+    bool tryRunPendingJob()
+    {
+        auto expected = JobState::pending;
+
+        if (! state.compare_exchange_strong (expected, JobState::running, std::memory_order_acquire))
+            return false;
+
+        runJob();
+
+        // If the audio thread started waiting for this job while it was running, wake it up
+        if (state.exchange (JobState::idle, std::memory_order_acq_rel) == JobState::awaited)
+            jobFinished.signal();
+
+        return true;
+    }
+
+private:
+    enum class JobState { idle, pending, running, awaited };
+
+    // Makes sure that the previous job has finished. If the background thread hasn't
+    // started it yet it's run on the calling thread, otherwise this blocks until the
+    // background thread has finished it.
+    void waitForPendingJob()
+    {
+        if (tryRunPendingJob())
+            return;
+
+        auto expected = JobState::running;
+
+        if (state.compare_exchange_strong (expected, JobState::awaited, std::memory_order_acquire))
+            jobFinished.wait();
+    }
+
+    void startJob (size_t numChannels)
+    {
+        waitForPendingJob();
+
+        jobNumChannels = numChannels;
+        front ^= 1;
+        state.store (JobState::pending, std::memory_order_release);
+
+        if (workAvailable != nullptr)
+            workAvailable->signal();
+    }
+
+    void runJob()
+    {
+        const auto back = (size_t) (front ^ 1);
+
+        for (size_t channel = 0; channel < jobNumChannels; ++channel)
+            engines[channel]->processSamples (inputs[back].getReadPointer ((int) channel),
+                                              outputs[back].getWritePointer ((int) channel),
+                                              blockSize);
+    }
+
+    std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+    std::array<AudioBuffer<float>, 2> inputs, outputs;
+    AudioBuffer<float> scratch;
+
+    const size_t blockSize;
+    const bool isDeferred;
+    size_t position = 0, jobNumChannels = 0;
+    int front = 0;
+    juce::detail::Semaphore* workAvailable = nullptr;
+    juce::detail::Semaphore jobFinished;
+    std::atomic<JobState> state { JobState::idle };
+};
+
+//==============================================================================
+// Runs the deferred jobs of the convolution stages of any number of engines.
+// A Convolution shares one of these between all the engines it creates, so
+// loading a new impulse response doesn't start a new thread.
+class ConvolutionStageThread  : public Thread
+{
+public:
+    ConvolutionStageThread()
+        : Thread ("Convolution stage processor")
+    {
+        startThread (Priority::high);
+    }
+
+    ~ConvolutionStageThread() override
+    {
+        signalThreadShouldExit();
+        workAvailable.signal();
+        stopThread (-1);
+    }
+
+    void addStages (const std::vector<ConvolutionStage*>& newStages)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        for (auto* stage : newStages)
+        {
+            stage->setWorkAvailableSignal (&workAvailable);
+            stages.insert (std::upper_bound (stages.begin(), stages.end(), stage, hasSmallerPartitions), stage);
+        }
+    }
+
+    // Once this returns, the background thread won't touch any of these stages again
+    void removeStages (const std::vector<ConvolutionStage*>& oldStages)
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        stages.erase (std::remove_if (stages.begin(), stages.end(), [&] (auto* stage)
+                      {
+                          return std::find (oldStages.begin(), oldStages.end(), stage) != oldStages.end();
+                      }),
+                      stages.end());
+    }
+
+private:
+    static bool hasSmallerPartitions (const ConvolutionStage* a, const ConvolutionStage* b)
+    {
+        return a->getPartitionSize() < b->getPartitionSize();
+    }
+
+    bool runNextPendingJob()
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+
+        // Smaller stages have earlier deadlines, so they are always checked first
+        return std::any_of (stages.begin(), stages.end(), [] (auto* stage)
+        {
+            return stage->tryRunPendingJob();
+        });
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            workAvailable.wait();
+
+            while (runNextPendingJob())
+            {}
+        }
+    }
+
+    juce::detail::Semaphore workAvailable;
+    std::mutex mutex;
+    std::vector<ConvolutionStage*> stages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionStageThread)
+};
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -447,7 +716,8 @@ public:
                         int maxBlockSize,
                         int maxBufferSize,
                         Convolution::NonUniform headSizeIn,
-                        bool isZeroDelayIn)
+                        bool isZeroDelayIn,
+                        const std::shared_ptr<ConvolutionStageThread>& sharedStageThread)
         : tailBuffer (1, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
@@ -475,14 +745,28 @@ public:
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
 
-            const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
+            if (headSizeIn.maxPartitionSizeInSamples > 0)
+            {
+                makeStages (buf, size, maxBlockSize, headSizeIn, sharedStageThread);
+            }
+            else
+            {
+                const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
 
-            if (size != buf.getNumSamples())
-                for (int i = 0; i < numChannels; ++i)
-                    tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+                if (size != buf.getNumSamples())
+                    for (int i = 0; i < numChannels; ++i)
+                        tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+            }
         }
     }
 
+    ~MultichannelEngine()
+    {
+        // The background thread must stop using the stages before they are destroyed
+        if (stageThread != nullptr)
+            stageThread->removeStages (deferredStages);
+    }
+
     void reset()
     {
         for (const auto& e : head)
@@ -490,6 +774,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        for (const auto& s : stages)
+            s->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -502,6 +789,20 @@ public:
 
         const auto isUniform = tail.empty();
 
+        AudioBlock<float> stageBlock;
+
+        if (! stages.empty())
+        {
+            stageBlock = AudioBlock<float> (stageBuffer).getSubsetChannelBlock (0, numChannels)
+                                                        .getSubBlock (0, numSamples);
+
+            // This must happen before the head is processed, which might overwrite the input
+            stageBlock.clear();
+
+            for (const auto& s : stages)
+                s->processSamples (input, stageBlock, numChannels);
+        }
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             if (! isUniform)
@@ -520,6 +821,9 @@ public:
 
             if (! isUniform)
                 output.getSingleChannelBlock (channel) += tailBlock;
+
+            if (! stages.empty())
+                output.getSingleChannelBlock (channel) += stageBlock.getSingleChannelBlock (channel);
         }
 
         const auto numOutputChannels = output.getNumChannels();
@@ -533,8 +837,61 @@ public:
     int getBlockSize() const noexcept  { return blockSize; }
 
 private:
+    // Splits the IR after the head into stages with doubling partition sizes.
+    // Each stage must start at an offset of at least one partition, or two
+    // partitions if it is deferred, so stages are made long enough for the
+    // next stage to satisfy this.
+    void makeStages (const AudioBuffer<float>& buf,
+                     int headSize,
+                     int maxBlockSize,
+                     Convolution::NonUniform options,
+                     const std::shared_ptr<ConvolutionStageThread>& sharedStageThread)
+    {
+        const auto numIRSamples = buf.getNumSamples();
+        const auto maxPartitionSize = jmax (options.headSizeInSamples, options.maxPartitionSizeInSamples);
+
+        // There's no point deferring partitions which are completed in every block anyway
+        const auto canDefer = [&] (int partitionSize) { return partitionSize > maxBlockSize; };
+        const auto getRequiredDelay = [&] (int partitionSize) { return (canDefer (partitionSize) ? 2 : 1) * partitionSize; };
+
+        for (auto offset = headSize, partitionSize = options.headSizeInSamples; offset < numIRSamples;)
+        {
+            const auto delay = offset + latency;
+            const auto isDeferred = canDefer (partitionSize) && delay >= getRequiredDelay (partitionSize);
+            const auto nextPartitionSize = jmin (partitionSize * 2, maxPartitionSize);
+
+            const auto length = partitionSize >= maxPartitionSize
+                              ? numIRSamples - offset
+                              : jmin (numIRSamples - offset, jmax (partitionSize, getRequiredDelay (nextPartitionSize) - delay));
+
+            stages.push_back (std::make_unique<ConvolutionStage> (buf,
+                                                                  offset,
+                                                                  length,
+                                                                  partitionSize,
+                                                                  delay,
+                                                                  isDeferred));
+
+            if (stages.back()->isDeferredStage())
+                deferredStages.push_back (stages.back().get());
+
+            offset += length;
+            partitionSize = nextPartitionSize;
+        }
+
+        stageBuffer.setSize (2, maxBlockSize);
+
+        if (! deferredStages.empty() && sharedStageThread != nullptr)
+        {
+            stageThread = sharedStageThread;
+            stageThread->addStages (deferredStages);
+        }
+    }
+
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
-    AudioBuffer<float> tailBuffer;
+    std::vector<std::unique_ptr<ConvolutionStage>> stages;
+    std::vector<ConvolutionStage*> deferredStages;
+    std::shared_ptr<ConvolutionStageThread> stageThread;
+    AudioBuffer<float> tailBuffer, stageBuffer;
 
     const int latency;
     const int irSize;
@@ -733,7 +1090,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     (requiredHeadSize.maxPartitionSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.maxPartitionSizeInSamples)) },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -788,11 +1146,15 @@ private:
         const auto maxBufferSize = shouldBeZeroLatency ? static_cast<int> (processSpec.maximumBlockSize)
                                                        : nextPowerOfTwo (static_cast<int> (currentLatency));
 
+        if (headSize.maxPartitionSizeInSamples > 0 && stageThread == nullptr)
+            stageThread = std::make_shared<ConvolutionStageThread>();
+
         return std::make_unique<MultichannelEngine> (resampled,
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
                                                      headSize,
-                                                     shouldBeZeroLatency);
+                                                     shouldBeZeroLatency,
+                                                     stageThread);
     }
 
     static AudioBuffer<float> makeImpulseBuffer()
@@ -810,6 +1172,8 @@ private:
     const Convolution::NonUniform headSize;
     const bool shouldBeZeroLatency;
 
+    // Engines keep a reference to this, so it stays alive until the last of them has been destroyed
+    std::shared_ptr<ConvolutionStageThread> stageThread;
     TryLockedPtr<MultichannelEngine> engine;
 
     mutable std::mutex mutex;
@@ -87,8 +87,8 @@ private:
     Note: The default operation of this class uses zero latency and a uniform
     partitioned algorithm. If the impulse response size is large, or if the
     algorithm is too CPU intensive, it is possible to use either a fixed
-    latency version of the algorithm, or a simple non-uniform partitioned
-    convolution algorithm.
+    latency version of the algorithm, or a non-uniform partitioned convolution
+    algorithm, optionally with multiple stages of increasing partition size.
 
     Threading: It is not safe to interleave calls to the methods of this
     class. If you need to load new impulse responses during processing the
@@ -130,18 +130,40 @@ public:
     */
     explicit Convolution (const Latency& requiredLatency);
 
-    /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    /** Contains configuration information for a non-uniform convolution.
+
+        If maxPartitionSizeInSamples is zero, a two stage algorithm is used: the
+        head of the IR is processed with zero latency, and the rest of the IR is
+        processed in a single uniform stage with partitions of headSizeInSamples.
+
+        If maxPartitionSizeInSamples is greater than zero, the IR after the head
+        is split into several stages with partition sizes that double from
+        headSizeInSamples up to maxPartitionSizeInSamples, and the final stage
+        uses partitions of maxPartitionSizeInSamples for the remainder of the IR.
+        Stages with partitions larger than the processing block size are computed
+        on a background thread, spreading their cost over the duration of a whole
+        partition instead of producing a spike on the audio thread. This is by far
+        the most efficient option for long reverberation IRs.
+
+        The output is identical regardless of how the background thread is
+        scheduled, so this mode is also suitable for offline rendering.
+    */
+    struct NonUniform
+    {
+        int headSizeInSamples;
+        int maxPartitionSizeInSamples = 0;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
 
         A requiredHeadSize of 256 samples or greater will improve the
         efficiency of the processing for IR sizes of 4096 samples or greater
-        (recommended for reverberation IRs).
+        (recommended for reverberation IRs). For IRs lasting several seconds,
+        a maxPartitionSizeInSamples of 8192 or 16384 samples is a good choice.
 
-        @param requiredHeadSize       the head IR size for two stage non-uniform
-                                      partitioned convolution
+        @param requiredHeadSize       the head IR size and partitioning scheme for
+                                      non-uniform partitioned convolution
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
 
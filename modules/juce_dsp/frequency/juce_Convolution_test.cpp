@@ -548,6 +548,28 @@ public:
             }
         }
 
+        beginTest ("Multi-stage non-uniform convolutions work");
+        {
+            const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 20);
+
+            for (const auto& nonUniform : { Convolution::NonUniform { 128, 1024 },
+                                            Convolution::NonUniform { 256, 4096 },
+                                            Convolution::NonUniform { 512, 256 } })
+            {
+                for (const auto& thisSpec : { spec, ProcessSpec { spec.sampleRate, 96, spec.numChannels } })
+                {
+                    testConvolution (thisSpec,
+                                     nonUniform,
+                                     ramp,
+                                     thisSpec.sampleRate,
+                                     Convolution::Stereo::yes,
+                                     Convolution::Trim::yes,
+                                     Convolution::Normalise::no,
+                                     ramp);
+                }
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -34,6 +34,18 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    virtual void performRealOnlyForwardTransforms (float* const* data, int num, bool ignoreNegativeFreqs) const noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            performRealOnlyForwardTransform (data[i], ignoreNegativeFreqs);
+    }
+
+    virtual void performRealOnlyInverseTransforms (float* const* data, int num) const noexcept
+    {
+        for (int i = 0; i < num; ++i)
+            performRealOnlyInverseTransform (data[i]);
+    }
 };
 
 struct FFT::Engine
@@ -431,6 +443,330 @@ struct FFTFallback  : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+/*  A radix-2 engine that keeps its working data as separate arrays of real and
+    imaginary parts, so that each stage of butterflies can be computed several at
+    a time using SIMD registers. Real-only transforms are done using a complex
+    transform of half the size, and all of the working memory is allocated when
+    the instance is created, so performing a transform never allocates.
+*/
+struct FFTVectorised  : public FFT::Instance
+{
+    // faster than the fallback, but any of the platform-specific libraries should be preferred
+    static constexpr int priority = 0;
+
+    static FFTVectorised* create (int order)
+    {
+        // Tiny transforms are left to the fallback engine
+        if (order < 2)
+            return nullptr;
+
+        return new FFTVectorised (order);
+    }
+
+    explicit FFTVectorised (int order)
+        : size (1 << order),
+          complexPlan (size),
+          realPlan (size / 2),
+          realTwiddles ((size_t) size / 2 + 1)
+    {
+        for (int i = 0; i <= size / 2; ++i)
+        {
+            auto phase = -MathConstants<double>::twoPi * i / (double) size;
+            realTwiddles[i] = { (float) std::cos (phase), (float) std::sin (phase) };
+        }
+    }
+
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        auto* re = complexPlan.real;
+        auto* im = complexPlan.imag;
+
+        // An inverse transform is a forward transform with the real and imaginary parts swapped
+        for (int i = 0; i < size; ++i)
+        {
+            const auto& c = input[complexPlan.bitReversed[i]];
+            re[i] = inverse ? c.imag() : c.real();
+            im[i] = inverse ? c.real() : c.imag();
+        }
+
+        complexPlan.transform();
+
+        if (inverse)
+        {
+            const auto scaleFactor = 1.0f / (float) size;
+
+            for (int i = 0; i < size; ++i)
+                output[i] = { im[i] * scaleFactor, re[i] * scaleFactor };
+        }
+        else
+        {
+            for (int i = 0; i < size; ++i)
+                output[i] = { re[i], im[i] };
+        }
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        forwardReal (d, ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+        inverseReal (d);
+    }
+
+    // The batched versions still transform one block at a time, but only take the lock once
+    void performRealOnlyForwardTransforms (float* const* data, int num, bool ignoreNegativeFreqs) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < num; ++i)
+            forwardReal (data[i], ignoreNegativeFreqs);
+    }
+
+    void performRealOnlyInverseTransforms (float* const* data, int num) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        for (int i = 0; i < num; ++i)
+            inverseReal (data[i]);
+    }
+
+private:
+    //==============================================================================
+    /*  The n real samples are treated as n/2 complex values, which are transformed,
+        and then the spectrum of the even and odd samples are separated and combined.
+    */
+    void forwardReal (float* d, bool ignoreNegativeFreqs) const noexcept
+    {
+        const auto half = size / 2;
+        auto* re = realPlan.real;
+        auto* im = realPlan.imag;
+
+        for (int i = 0; i < half; ++i)
+        {
+            const auto j = realPlan.bitReversed[i];
+            re[i] = d[2 * j];
+            im[i] = d[2 * j + 1];
+        }
+
+        realPlan.transform();
+
+        auto* out = reinterpret_cast<Complex<float>*> (d);
+        out[0]    = { re[0] + im[0], 0.0f };
+        out[half] = { re[0] - im[0], 0.0f };
+
+        for (int k = 1; k < half; ++k)
+        {
+            const auto sumRe  = 0.5f * (re[k] + re[half - k]);
+            const auto sumIm  = 0.5f * (im[k] - im[half - k]);
+            const auto diffRe = 0.5f * (re[k] - re[half - k]);
+            const auto diffIm = 0.5f * (im[k] + im[half - k]);
+
+            // even part = sum, odd part = -i * diff
+            const auto oddRe = diffIm, oddIm = -diffRe;
+            const auto w = realTwiddles[k];
+
+            out[k] = { sumRe + w.real() * oddRe - w.imag() * oddIm,
+                       sumIm + w.real() * oddIm + w.imag() * oddRe };
+        }
+
+        if (! ignoreNegativeFreqs)
+            for (int k = 1; k < half; ++k)
+                out[size - k] = std::conj (out[k]);
+    }
+
+    void inverseReal (float* d) const noexcept
+    {
+        const auto half = size / 2;
+        auto* re = realPlan.real;
+        auto* im = realPlan.imag;
+        const auto* in = reinterpret_cast<const Complex<float>*> (d);
+
+        for (int k = 0; k < half; ++k)
+        {
+            const auto x = in[k], y = std::conj (in[half - k]);
+            const auto even = 0.5f * (x + y);
+            const auto odd  = 0.5f * (x - y) * std::conj (realTwiddles[k]);
+            const auto z = even + Complex<float> (-odd.imag(), odd.real());
+
+            // stored with real and imaginary parts swapped, to do an inverse transform
+            const auto j = realPlan.bitReversed[k];
+            re[j] = z.imag();
+            im[j] = z.real();
+        }
+
+        realPlan.transform();
+
+        const auto scaleFactor = 1.0f / (float) half;
+
+        for (int i = 0; i < half; ++i)
+        {
+            d[2 * i]     = im[i] * scaleFactor;
+            d[2 * i + 1] = re[i] * scaleFactor;
+        }
+    }
+
+    //==============================================================================
+    struct Plan
+    {
+        explicit Plan (int sizeOfFFT)
+            : fftSize (sizeOfFFT), bitReversed ((size_t) sizeOfFFT)
+        {
+            // Enough space for the twiddles and working data, with room to align them
+            storage.calloc ((size_t) fftSize * 4 + alignment);
+            real   = snapPointerToAlignment (storage.getData(), (size_t) alignment * sizeof (float));
+            imag   = real + fftSize;
+            twRe   = imag + fftSize;
+            twIm   = twRe + fftSize;
+
+            // The twiddles for the stage that combines pairs of length h start at index h
+            for (int h = 1; h < fftSize; h *= 2)
+            {
+                for (int k = 0; k < h; ++k)
+                {
+                    auto phase = -MathConstants<double>::pi * k / (double) h;
+                    twRe[h + k] = (float) std::cos (phase);
+                    twIm[h + k] = (float) std::sin (phase);
+                }
+            }
+
+            int numBits = 0;
+
+            while ((1 << numBits) < fftSize)
+                ++numBits;
+
+            for (int i = 0; i < fftSize; ++i)
+            {
+                int reversed = 0;
+
+                for (int bit = 0; bit < numBits; ++bit)
+                    if ((i & (1 << bit)) != 0)
+                        reversed |= 1 << (numBits - 1 - bit);
+
+                bitReversed[i] = reversed;
+            }
+        }
+
+        // Transforms the working data, which must already be in bit-reversed order
+        void transform() const noexcept
+        {
+            if (fftSize >= 2)  firstStage();
+            if (fftSize >= 4)  secondStage();
+
+            for (int h = 4; h < fftSize; h *= 2)
+                stage (h);
+        }
+
+        const int fftSize;
+        HeapBlock<int> bitReversed;
+        float* real = nullptr;
+        float* imag = nullptr;
+
+    private:
+       #if JUCE_USE_SIMD
+        using Vec = SIMDRegister<float>;
+        static constexpr int alignment = (int) Vec::SIMDNumElements * 4;
+       #else
+        static constexpr int alignment = 16;
+       #endif
+
+        HeapBlock<float> storage;
+        float* twRe = nullptr;
+        float* twIm = nullptr;
+
+        // The twiddles for the first two stages are trivial
+        void firstStage() const noexcept
+        {
+            for (int i = 0; i < fftSize; i += 2)
+            {
+                const auto r = real[i + 1], m = imag[i + 1];
+                real[i + 1] = real[i] - r;
+                imag[i + 1] = imag[i] - m;
+                real[i] += r;
+                imag[i] += m;
+            }
+        }
+
+        void secondStage() const noexcept
+        {
+            for (int i = 0; i < fftSize; i += 4)
+            {
+                const auto r2 = real[i + 2], m2 = imag[i + 2];
+                real[i + 2] = real[i] - r2;
+                imag[i + 2] = imag[i] - m2;
+                real[i] += r2;
+                imag[i] += m2;
+
+                // multiplied by -i
+                const auto r3 = imag[i + 3], m3 = -real[i + 3];
+                real[i + 3] = real[i + 1] - r3;
+                imag[i + 3] = imag[i + 1] - m3;
+                real[i + 1] += r3;
+                imag[i + 1] += m3;
+            }
+        }
+
+        void stage (int h) const noexcept
+        {
+            const auto* wr = twRe + h;
+            const auto* wi = twIm + h;
+
+            for (int start = 0; start < fftSize; start += 2 * h)
+            {
+                auto* r0 = real + start;
+                auto* i0 = imag + start;
+                auto* r1 = r0 + h;
+                auto* i1 = i0 + h;
+                int k = 0;
+
+               #if JUCE_USE_SIMD
+                for (; k + (int) Vec::SIMDNumElements <= h; k += (int) Vec::SIMDNumElements)
+                {
+                    const auto xr = Vec::fromRawArray (r1 + k), xi = Vec::fromRawArray (i1 + k);
+                    const auto tr = Vec::fromRawArray (wr + k), ti = Vec::fromRawArray (wi + k);
+                    const auto pr = xr * tr - xi * ti;
+                    const auto pi = xr * ti + xi * tr;
+                    const auto ar = Vec::fromRawArray (r0 + k), ai = Vec::fromRawArray (i0 + k);
+
+                    (ar + pr).copyToRawArray (r0 + k);
+                    (ai + pi).copyToRawArray (i0 + k);
+                    (ar - pr).copyToRawArray (r1 + k);
+                    (ai - pi).copyToRawArray (i1 + k);
+                }
+               #endif
+
+                for (; k < h; ++k)
+                {
+                    const auto pr = r1[k] * wr[k] - i1[k] * wi[k];
+                    const auto pi = r1[k] * wi[k] + i1[k] * wr[k];
+
+                    r1[k] = r0[k] - pr;
+                    i1[k] = i0[k] - pi;
+                    r0[k] += pr;
+                    i0[k] += pi;
+                }
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Plan)
+    };
+
+    //==============================================================================
+    SpinLock processLock;
+    const int size;
+    Plan complexPlan, realPlan;
+    HeapBlock<Complex<float>> realTwiddles;
+};
+
+FFT::EngineImpl<FFTVectorised> fftVectorised;
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -981,6 +1317,18 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+void FFT::performRealOnlyForwardTransforms (float* const* inputOutputData, int numBlocks, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyForwardTransforms (inputOutputData, numBlocks, ignoreNegativeFreqs);
+}
+
+void FFT::performRealOnlyInverseTransforms (float* const* inputOutputData, int numBlocks) const noexcept
+{
+    if (engine != nullptr)
+        engine->performRealOnlyInverseTransforms (inputOutputData, numBlocks);
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
 {
     if (size == 1)
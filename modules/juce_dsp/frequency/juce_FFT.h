@@ -96,6 +96,25 @@ public:
     */
     void performRealOnlyInverseTransform (float* inputOutputData) const noexcept;
 
+    /** Performs in-place forward transforms on several blocks of real data.
+
+        This is a convenience that's equivalent to calling performRealOnlyForwardTransform()
+        on each of the blocks in turn - the engines still transform the blocks one at a time.
+        Each of the blocks must follow the same rules as for performRealOnlyForwardTransform().
+
+        @see performRealOnlyInverseTransforms
+    */
+    void performRealOnlyForwardTransforms (float* const* inputOutputData, int numBlocks,
+                                           bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs in-place inverse transforms on several blocks of data that were created by
+        performRealOnlyForwardTransform() or performRealOnlyForwardTransforms().
+
+        Like performRealOnlyForwardTransforms(), this is a convenience that's equivalent to
+        calling performRealOnlyInverseTransform() on each of the blocks in turn.
+    */
+    void performRealOnlyInverseTransforms (float* const* inputOutputData, int numBlocks) const noexcept;
+
     /** Takes an array and simply transforms it to the magnitude frequency response
         spectrum. This may be handy for things like frequency displays or analysis.
         The size of the array passed in must be 2 * getSize().
@@ -196,6 +196,86 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct InPlaceTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t order = 0; order <= 12; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                HeapBlock<Complex<float>> input (n), buffer (n);
+
+                fillRandom (random, input.getData(), n);
+                memcpy (buffer.getData(), input.getData(), sizeof (Complex<float>) * n);
+
+                fft.perform (buffer.getData(), buffer.getData(), false);
+                fft.perform (buffer.getData(), buffer.getData(), true);
+
+                u.expect (checkArrayIsSimilar (buffer.getData(), input.getData(), n));
+            }
+        }
+    };
+
+    struct BatchedRealTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+            constexpr int numBlocks = 3;
+
+            // The reference transform is done in single precision, so its error is
+            // already close to the tolerance by the time it gets to order 8
+            for (size_t order = 0; order <= 7; ++order)
+            {
+                auto n = (1u << order);
+
+                FFT fft ((int) order);
+
+                std::vector<std::vector<float>> inputs;
+                std::vector<std::vector<Complex<float>>> blocks, references;
+                std::vector<float*> pointers;
+
+                for (int i = 0; i < numBlocks; ++i)
+                {
+                    std::vector<float> input (n);
+                    fillRandom (random, input.data(), n);
+
+                    std::vector<Complex<float>> reference (n);
+                    performReferenceFourier (input.data(), reference.data(), n, false);
+
+                    // fill only first half with real numbers
+                    std::vector<Complex<float>> block (n);
+                    memcpy (reinterpret_cast<float*> (block.data()), input.data(), n * sizeof (float));
+
+                    inputs.push_back (input);
+                    references.push_back (reference);
+                    blocks.push_back (block);
+                }
+
+                for (auto& block : blocks)
+                    pointers.push_back (reinterpret_cast<float*> (block.data()));
+
+                fft.performRealOnlyForwardTransforms (pointers.data(), numBlocks);
+
+                for (int i = 0; i < numBlocks; ++i)
+                    u.expect (checkArrayIsSimilar (references[(size_t) i].data(), blocks[(size_t) i].data(), n));
+
+                for (int i = 0; i < numBlocks; ++i)
+                    std::copy (references[(size_t) i].begin(), references[(size_t) i].end(), blocks[(size_t) i].begin());
+
+                fft.performRealOnlyInverseTransforms (pointers.data(), numBlocks);
+
+                for (int i = 0; i < numBlocks; ++i)
+                    u.expect (checkArrayIsSimilar (reinterpret_cast<float*> (blocks[(size_t) i].data()), inputs[(size_t) i].data(), n));
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -209,6 +289,8 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<InPlaceTest> ("In-place complex round trip Test");
+        runTestForAllTypes<BatchedRealTest> ("Batched real input numbers Test");
     }
 };
 
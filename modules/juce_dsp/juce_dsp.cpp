@@ -59,6 +59,7 @@
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_SampleRateConverter.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
 #include "processors/juce_DelayLine.cpp"
@@ -80,7 +81,9 @@
 
 #if JUCE_USE_SIMD
  #if JUCE_INTEL
-  #ifdef __AVX2__
+  #if defined (__AVX512F__) && defined (__AVX512BW__) && defined (__AVX512DQ__)
+   #include "native/juce_SIMDNativeOps_avx512.cpp"
+  #elif defined (__AVX2__)
    #include "native/juce_SIMDNativeOps_avx.cpp"
   #else
    #include "native/juce_SIMDNativeOps_sse.cpp"
@@ -98,6 +101,8 @@
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
+  #include "processors/juce_SIMDSynthesiserVoiceRenderer_test.cpp"
+  #include "processors/juce_MultiChannelIIRFilter_test.cpp"
  #endif
 
  #include "containers/juce_AudioBlock_test.cpp"
@@ -106,4 +111,5 @@
  #include "frequency/juce_FFT_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_SampleRateConverter_test.cpp"
 #endif
@@ -224,7 +224,9 @@ namespace juce
 
  // include the correct native file for this build target CPU
  #if defined(__i386__) || defined(__amd64__) || defined(_M_X64) || defined(_X86_) || defined(_M_IX86)
-  #ifdef __AVX2__
+  #if defined (__AVX512F__) && defined (__AVX512BW__) && defined (__AVX512DQ__)
+   #include "native/juce_SIMDNativeOps_avx512.h"
+  #elif defined (__AVX2__)
    #include "native/juce_SIMDNativeOps_avx.h"
   #else
    #include "native/juce_SIMDNativeOps_sse.h"
@@ -251,6 +253,7 @@ namespace juce
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
 #include "processors/juce_ProcessorDuplicator.h"
+#include "frequency/juce_FFT.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
@@ -258,11 +261,16 @@ namespace juce
 #include "processors/juce_Panner.h"
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
+#include "processors/juce_SampleRateConverter.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
-#include "frequency/juce_FFT.h"
+
+#if JUCE_USE_SIMD
+ #include "processors/juce_SIMDSynthesiserVoiceRenderer.h"
+ #include "processors/juce_MultiChannelIIRFilter.h"
+#endif
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
 #include "filter_design/juce_FilterDesign.h"
@@ -0,0 +1,540 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+#ifndef DOXYGEN
+
+JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wignored-attributes")
+
+#ifdef _MSC_VER
+ #define DECLARE_AVX512_SIMD_CONST(type, name) \
+    static __declspec(align(64)) const type name[64 / sizeof (type)]
+
+ #define DEFINE_AVX512_SIMD_CONST(type, class_type, name) \
+    __declspec(align(64)) const type SIMDNativeOps<class_type>:: name[64 / sizeof (type)]
+
+#else
+ #define DECLARE_AVX512_SIMD_CONST(type, name) \
+    static const type name[64 / sizeof (type)] __attribute__((aligned(64)))
+
+ #define DEFINE_AVX512_SIMD_CONST(type, class_type, name) \
+    const type SIMDNativeOps<class_type>:: name[64 / sizeof (type)] __attribute__((aligned(64)))
+
+#endif
+
+template <typename type>
+struct SIMDNativeOps;
+
+/*  AVX-512 comparisons produce a bit mask rather than a vector, so these helpers
+    expand a mask into the all-bits-set lanes that SIMDRegister expects.
+*/
+namespace SIMDInternal
+{
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE maskToVector8  (__mmask64 m) noexcept   { return _mm512_movm_epi8  (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE maskToVector16 (__mmask32 m) noexcept   { return _mm512_movm_epi16 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE maskToVector32 (__mmask16 m) noexcept   { return _mm512_movm_epi32 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE maskToVector64 (__mmask8 m) noexcept    { return _mm512_movm_epi64 (m); }
+}
+
+//==============================================================================
+/** Single-precision floating point AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<float>
+{
+    using vSIMDType = __m512;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int32_t, kAllBitsSet);
+    DECLARE_AVX512_SIMD_CONST (int32_t, kEvenHighBit);
+    DECLARE_AVX512_SIMD_CONST (float, kOne);
+
+    //==============================================================================
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE fromMask (__mmask16 m) noexcept                      { return _mm512_castsi512_ps (SIMDInternal::maskToVector32 (m)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE vconst (const float* a) noexcept                     { return load (a); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE vconst (const int32_t* a) noexcept                   { return _mm512_castsi512_ps (_mm512_load_si512 (a)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE expand (float s) noexcept                            { return _mm512_set1_ps (s); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE load (const float* a) noexcept                       { return _mm512_load_ps (a); }
+    static forcedinline void   JUCE_VECTOR_CALLTYPE store (__m512 value, float* dest) noexcept           { _mm512_store_ps (dest, value); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE add (__m512 a, __m512 b) noexcept                    { return _mm512_add_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE sub (__m512 a, __m512 b) noexcept                    { return _mm512_sub_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE mul (__m512 a, __m512 b) noexcept                    { return _mm512_mul_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE bit_and (__m512 a, __m512 b) noexcept                { return _mm512_and_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE bit_or  (__m512 a, __m512 b) noexcept                { return _mm512_or_ps  (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE bit_xor (__m512 a, __m512 b) noexcept                { return _mm512_xor_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE bit_notand (__m512 a, __m512 b) noexcept             { return _mm512_andnot_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE bit_not (__m512 a) noexcept                          { return bit_notand (a, vconst (kAllBitsSet)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE min (__m512 a, __m512 b) noexcept                    { return _mm512_min_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE max (__m512 a, __m512 b) noexcept                    { return _mm512_max_ps (a, b); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE equal (__m512 a, __m512 b) noexcept                  { return fromMask (_mm512_cmp_ps_mask (a, b, _CMP_EQ_OQ)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE notEqual (__m512 a, __m512 b) noexcept               { return fromMask (_mm512_cmp_ps_mask (a, b, _CMP_NEQ_OQ)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE greaterThan (__m512 a, __m512 b) noexcept            { return fromMask (_mm512_cmp_ps_mask (a, b, _CMP_GT_OQ)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512 a, __m512 b) noexcept     { return fromMask (_mm512_cmp_ps_mask (a, b, _CMP_GE_OQ)); }
+    static forcedinline bool   JUCE_VECTOR_CALLTYPE allEqual (__m512 a, __m512 b) noexcept               { return _mm512_cmp_ps_mask (a, b, _CMP_EQ_OQ) == 0xffff; }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE multiplyAdd (__m512 a, __m512 b, __m512 c) noexcept  { return _mm512_fmadd_ps (b, c, a); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE dupeven (__m512 a) noexcept                          { return _mm512_shuffle_ps (a, a, _MM_SHUFFLE (2, 2, 0, 0)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE dupodd (__m512 a) noexcept                           { return _mm512_shuffle_ps (a, a, _MM_SHUFFLE (3, 3, 1, 1)); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE swapevenodd (__m512 a) noexcept                      { return _mm512_shuffle_ps (a, a, _MM_SHUFFLE (2, 3, 0, 1)); }
+    static forcedinline float  JUCE_VECTOR_CALLTYPE get (__m512 v, size_t i) noexcept                    { return SIMDFallbackOps<float, __m512>::get (v, i); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE set (__m512 v, size_t i, float s) noexcept           { return SIMDFallbackOps<float, __m512>::set (v, i, s); }
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE truncate (__m512 a) noexcept                         { return _mm512_cvtepi32_ps (_mm512_cvttps_epi32 (a)); }
+    static forcedinline float  JUCE_VECTOR_CALLTYPE sum (__m512 a) noexcept                              { return _mm512_reduce_add_ps (a); }
+
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE oddevensum (__m512 a) noexcept
+    {
+        a = _mm512_add_ps (_mm512_shuffle_ps (a, a, _MM_SHUFFLE (1, 0, 3, 2)), a);
+        a = _mm512_add_ps (_mm512_shuffle_f32x4 (a, a, _MM_SHUFFLE (1, 0, 3, 2)), a);
+        return _mm512_add_ps (_mm512_shuffle_f32x4 (a, a, _MM_SHUFFLE (2, 3, 0, 1)), a);
+    }
+
+    //==============================================================================
+    static forcedinline __m512 JUCE_VECTOR_CALLTYPE cmplxmul (__m512 a, __m512 b) noexcept
+    {
+        __m512 rr_ir = mul (a, dupeven (b));
+        __m512 ii_ri = mul (swapevenodd (a), dupodd (b));
+        return add (rr_ir, bit_xor (ii_ri, vconst (kEvenHighBit)));
+    }
+};
+
+//==============================================================================
+/** Double-precision floating point AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<double>
+{
+    using vSIMDType = __m512d;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int64_t, kAllBitsSet);
+    DECLARE_AVX512_SIMD_CONST (int64_t, kEvenHighBit);
+    DECLARE_AVX512_SIMD_CONST (double, kOne);
+
+    //==============================================================================
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE fromMask (__mmask8 m) noexcept                         { return _mm512_castsi512_pd (SIMDInternal::maskToVector64 (m)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE vconst (const double* a) noexcept                      { return load (a); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE vconst (const int64_t* a) noexcept                     { return _mm512_castsi512_pd (_mm512_load_si512 (a)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE expand (double s) noexcept                             { return _mm512_set1_pd (s); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE load (const double* a) noexcept                        { return _mm512_load_pd (a); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512d value, double* dest) noexcept           { _mm512_store_pd (dest, value); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE add (__m512d a, __m512d b) noexcept                    { return _mm512_add_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE sub (__m512d a, __m512d b) noexcept                    { return _mm512_sub_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE mul (__m512d a, __m512d b) noexcept                    { return _mm512_mul_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE bit_and (__m512d a, __m512d b) noexcept                { return _mm512_and_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE bit_or  (__m512d a, __m512d b) noexcept                { return _mm512_or_pd  (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE bit_xor (__m512d a, __m512d b) noexcept                { return _mm512_xor_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE bit_notand (__m512d a, __m512d b) noexcept             { return _mm512_andnot_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE bit_not (__m512d a) noexcept                           { return bit_notand (a, vconst (kAllBitsSet)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE min (__m512d a, __m512d b) noexcept                    { return _mm512_min_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE max (__m512d a, __m512d b) noexcept                    { return _mm512_max_pd (a, b); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE equal (__m512d a, __m512d b) noexcept                  { return fromMask (_mm512_cmp_pd_mask (a, b, _CMP_EQ_OQ)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE notEqual (__m512d a, __m512d b) noexcept               { return fromMask (_mm512_cmp_pd_mask (a, b, _CMP_NEQ_OQ)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE greaterThan (__m512d a, __m512d b) noexcept            { return fromMask (_mm512_cmp_pd_mask (a, b, _CMP_GT_OQ)); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512d a, __m512d b) noexcept     { return fromMask (_mm512_cmp_pd_mask (a, b, _CMP_GE_OQ)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512d a, __m512d b) noexcept               { return _mm512_cmp_pd_mask (a, b, _CMP_EQ_OQ) == 0xff; }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE multiplyAdd (__m512d a, __m512d b, __m512d c) noexcept { return _mm512_fmadd_pd (b, c, a); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE dupeven (__m512d a) noexcept                           { return _mm512_shuffle_pd (a, a, 0x00); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE dupodd (__m512d a) noexcept                            { return _mm512_shuffle_pd (a, a, 0xff); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE swapevenodd (__m512d a) noexcept                       { return _mm512_shuffle_pd (a, a, 0x55); }
+    static forcedinline double  JUCE_VECTOR_CALLTYPE get (__m512d v, size_t i) noexcept                     { return SIMDFallbackOps<double, __m512d>::get (v, i); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE set (__m512d v, size_t i, double s) noexcept           { return SIMDFallbackOps<double, __m512d>::set (v, i, s); }
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE truncate (__m512d a) noexcept                          { return _mm512_cvtepi32_pd (_mm512_cvttpd_epi32 (a)); }
+    static forcedinline double  JUCE_VECTOR_CALLTYPE sum (__m512d a) noexcept                               { return _mm512_reduce_add_pd (a); }
+
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE oddevensum (__m512d a) noexcept
+    {
+        a = _mm512_add_pd (_mm512_shuffle_f64x2 (a, a, _MM_SHUFFLE (1, 0, 3, 2)), a);
+        return _mm512_add_pd (_mm512_shuffle_f64x2 (a, a, _MM_SHUFFLE (2, 3, 0, 1)), a);
+    }
+
+    //==============================================================================
+    static forcedinline __m512d JUCE_VECTOR_CALLTYPE cmplxmul (__m512d a, __m512d b) noexcept
+    {
+        __m512d rr_ir = mul (a, dupeven (b));
+        __m512d ii_ri = mul (swapevenodd (a), dupodd (b));
+        return add (rr_ir, bit_xor (ii_ri, vconst (kEvenHighBit)));
+    }
+};
+
+//==============================================================================
+/** Signed 8-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<int8_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int8_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE fromMask (__mmask64 m) noexcept                           { return SIMDInternal::maskToVector8 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE expand (int8_t s) noexcept                                { return _mm512_set1_epi8 ((char) s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE load (const int8_t* p) noexcept                           { return _mm512_load_si512 (p); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512i value, int8_t* dest) noexcept              { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epi8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epi8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epi8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epi8_mask (a, b)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epi8_mask (a, b) == ~(__mmask64) 0; }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline int8_t  JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<int8_t, __m512i>::get (v, i); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, int8_t s) noexcept              { return SIMDFallbackOps<int8_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline int8_t  JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<int8_t> (_mm512_reduce_add_epi64 (_mm512_sad_epu8 (a, _mm512_setzero_si512()))); }
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept
+    {
+        // unpack and multiply
+        __m512i even = _mm512_mullo_epi16 (a, b);
+        __m512i odd  = _mm512_mullo_epi16 (_mm512_srli_epi16 (a, 8), _mm512_srli_epi16 (b, 8));
+
+        return _mm512_or_si512 (_mm512_slli_epi16 (odd, 8),
+                                _mm512_srli_epi16 (_mm512_slli_epi16 (even, 8), 8));
+    }
+};
+
+//==============================================================================
+/** Unsigned 8-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<uint8_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (uint8_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE fromMask (__mmask64 m) noexcept                           { return SIMDInternal::maskToVector8 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE expand (uint8_t s) noexcept                               { return _mm512_set1_epi8 ((char) s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE load (const uint8_t* p) noexcept                          { return _mm512_load_si512 (p); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512i value, uint8_t* dest) noexcept             { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epu8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epu8 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epu8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epu8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epu8_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epu8_mask (a, b)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epu8_mask (a, b) == ~(__mmask64) 0; }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline uint8_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<uint8_t, __m512i>::get (v, i); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, uint8_t s) noexcept             { return SIMDFallbackOps<uint8_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline uint8_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<uint8_t> (_mm512_reduce_add_epi64 (_mm512_sad_epu8 (a, _mm512_setzero_si512()))); }
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept
+    {
+        // unpack and multiply
+        __m512i even = _mm512_mullo_epi16 (a, b);
+        __m512i odd  = _mm512_mullo_epi16 (_mm512_srli_epi16 (a, 8), _mm512_srli_epi16 (b, 8));
+
+        return _mm512_or_si512 (_mm512_slli_epi16 (odd, 8),
+                                _mm512_srli_epi16 (_mm512_slli_epi16 (even, 8), 8));
+    }
+};
+
+//==============================================================================
+/** Signed 16-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<int16_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int16_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE fromMask (__mmask32 m) noexcept                           { return SIMDInternal::maskToVector16 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE expand (int16_t s) noexcept                               { return _mm512_set1_epi16 ((short) s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE load (const int16_t* p) noexcept                          { return _mm512_load_si512 (p); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512i value, int16_t* dest) noexcept             { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi16 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi16 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi16 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epi16 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epi16 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epi16_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epi16_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epi16_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epi16_mask (a, b)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epi16_mask (a, b) == ~(__mmask32) 0; }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline int16_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<int16_t, __m512i>::get (v, i); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, int16_t s) noexcept             { return SIMDFallbackOps<int16_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline int16_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<int16_t> (_mm512_reduce_add_epi32 (_mm512_madd_epi16 (a, _mm512_set1_epi16 (1)))); }
+};
+
+//==============================================================================
+/** Unsigned 16-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<uint16_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (uint16_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE fromMask (__mmask32 m) noexcept                           { return SIMDInternal::maskToVector16 (m); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE expand (uint16_t s) noexcept                              { return _mm512_set1_epi16 ((short) s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE load (const uint16_t* p) noexcept                         { return _mm512_load_si512 (p); }
+    static forcedinline void     JUCE_VECTOR_CALLTYPE store (__m512i value, uint16_t* dest) noexcept            { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi16 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi16 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi16 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epu16 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epu16 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epu16_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epu16_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epu16_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epu16_mask (a, b)); }
+    static forcedinline bool     JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epu16_mask (a, b) == ~(__mmask32) 0; }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline uint16_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<uint16_t, __m512i>::get (v, i); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, uint16_t s) noexcept            { return SIMDFallbackOps<uint16_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline uint16_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<uint16_t> (_mm512_reduce_add_epi32 (_mm512_madd_epi16 (a, _mm512_set1_epi16 (1)))); }
+};
+
+//==============================================================================
+/** Signed 32-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<int32_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int32_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE fromMask (__mmask16 m) noexcept                           { return SIMDInternal::maskToVector32 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE expand (int32_t s) noexcept                               { return _mm512_set1_epi32 ((int) s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE load (const int32_t* p) noexcept                          { return _mm512_load_si512 (p); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512i value, int32_t* dest) noexcept             { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi32 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi32 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi32 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epi32 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epi32 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epi32_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epi32_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epi32_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epi32_mask (a, b)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epi32_mask (a, b) == (__mmask16) 0xffff; }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline int32_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<int32_t, __m512i>::get (v, i); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, int32_t s) noexcept             { return SIMDFallbackOps<int32_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline int32_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<int32_t> (_mm512_reduce_add_epi32 (a)); }
+};
+
+//==============================================================================
+/** Unsigned 32-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<uint32_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (uint32_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE fromMask (__mmask16 m) noexcept                           { return SIMDInternal::maskToVector32 (m); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE expand (uint32_t s) noexcept                              { return _mm512_set1_epi32 ((int) s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE load (const uint32_t* p) noexcept                         { return _mm512_load_si512 (p); }
+    static forcedinline void     JUCE_VECTOR_CALLTYPE store (__m512i value, uint32_t* dest) noexcept            { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi32 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi32 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi32 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epu32 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epu32 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epu32_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epu32_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epu32_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epu32_mask (a, b)); }
+    static forcedinline bool     JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epu32_mask (a, b) == (__mmask16) 0xffff; }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline uint32_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<uint32_t, __m512i>::get (v, i); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, uint32_t s) noexcept            { return SIMDFallbackOps<uint32_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline uint32_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<uint32_t> (_mm512_reduce_add_epi32 (a)); }
+};
+
+//==============================================================================
+/** Signed 64-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<int64_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (int64_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE fromMask (__mmask8 m) noexcept                            { return SIMDInternal::maskToVector64 (m); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE expand (int64_t s) noexcept                               { return _mm512_set1_epi64 ((long long) s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE load (const int64_t* p) noexcept                          { return _mm512_load_si512 (p); }
+    static forcedinline void    JUCE_VECTOR_CALLTYPE store (__m512i value, int64_t* dest) noexcept             { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi64 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi64 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi64 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epi64 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epi64 (a, b); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epi64_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epi64_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epi64_mask (a, b)); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epi64_mask (a, b)); }
+    static forcedinline bool    JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epi64_mask (a, b) == (__mmask8) 0xff; }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline int64_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<int64_t, __m512i>::get (v, i); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, int64_t s) noexcept             { return SIMDFallbackOps<int64_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline int64_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<int64_t> (_mm512_reduce_add_epi64 (a)); }
+};
+
+//==============================================================================
+/** Unsigned 64-bit integer AVX-512 intrinsics.
+
+    @tags{DSP}
+*/
+template <>
+struct SIMDNativeOps<uint64_t>
+{
+    //==============================================================================
+    using vSIMDType = __m512i;
+
+    //==============================================================================
+    DECLARE_AVX512_SIMD_CONST (uint64_t, kAllBitsSet);
+
+    //==============================================================================
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE fromMask (__mmask8 m) noexcept                            { return SIMDInternal::maskToVector64 (m); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE expand (uint64_t s) noexcept                              { return _mm512_set1_epi64 ((long long) s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE load (const uint64_t* p) noexcept                         { return _mm512_load_si512 (p); }
+    static forcedinline void     JUCE_VECTOR_CALLTYPE store (__m512i value, uint64_t* dest) noexcept            { _mm512_store_si512 (dest, value); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE add (__m512i a, __m512i b) noexcept                       { return _mm512_add_epi64 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE sub (__m512i a, __m512i b) noexcept                       { return _mm512_sub_epi64 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE mul (__m512i a, __m512i b) noexcept                       { return _mm512_mullo_epi64 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_and (__m512i a, __m512i b) noexcept                   { return _mm512_and_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_or  (__m512i a, __m512i b) noexcept                   { return _mm512_or_si512  (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_xor (__m512i a, __m512i b) noexcept                   { return _mm512_xor_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_andnot (__m512i a, __m512i b) noexcept                { return _mm512_andnot_si512 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE bit_not (__m512i a) noexcept                              { return _mm512_andnot_si512 (a, load (kAllBitsSet)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE min (__m512i a, __m512i b) noexcept                       { return _mm512_min_epu64 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE max (__m512i a, __m512i b) noexcept                       { return _mm512_max_epu64 (a, b); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE equal (__m512i a, __m512i b) noexcept                     { return fromMask (_mm512_cmpeq_epu64_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE notEqual (__m512i a, __m512i b) noexcept                  { return fromMask (_mm512_cmpneq_epu64_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThan (__m512i a, __m512i b) noexcept               { return fromMask (_mm512_cmpgt_epu64_mask (a, b)); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE greaterThanOrEqual (__m512i a, __m512i b) noexcept        { return fromMask (_mm512_cmpge_epu64_mask (a, b)); }
+    static forcedinline bool     JUCE_VECTOR_CALLTYPE allEqual (__m512i a, __m512i b) noexcept                  { return _mm512_cmpeq_epu64_mask (a, b) == (__mmask8) 0xff; }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE multiplyAdd (__m512i a, __m512i b, __m512i c) noexcept    { return add (a, mul (b, c)); }
+    static forcedinline uint64_t JUCE_VECTOR_CALLTYPE get (__m512i v, size_t i) noexcept                        { return SIMDFallbackOps<uint64_t, __m512i>::get (v, i); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE set (__m512i v, size_t i, uint64_t s) noexcept            { return SIMDFallbackOps<uint64_t, __m512i>::set (v, i, s); }
+    static forcedinline __m512i  JUCE_VECTOR_CALLTYPE truncate (__m512i a) noexcept                             { return a; }
+    static forcedinline uint64_t JUCE_VECTOR_CALLTYPE sum (__m512i a) noexcept                                  { return static_cast<uint64_t> (_mm512_reduce_add_epi64 (a)); }
+};
+#endif
+
+JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+} // namespace dsp
+} // namespace juce
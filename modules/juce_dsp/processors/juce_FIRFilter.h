@@ -41,10 +41,15 @@ namespace FIR
         A processing class that can perform FIR filtering on an audio signal, in the
         time domain.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        Short filters are processed directly in the time domain. When a Filter<float>
+        has more than partitionedConvolutionThreshold coefficients, all but the first
+        few hundred of them are applied using a uniformly partitioned FFT convolution
+        instead, which is much faster for long filters. The directly-processed head
+        covers the time taken to fill each partition, so the output is the same (to
+        within rounding errors) and the filter still has no latency.
+
+        For impulse responses that are loaded from files, or which need to be changed
+        smoothly while processing, the Convolution class may be more appropriate.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -62,6 +67,11 @@ namespace FIR
         /** A typedef for a ref-counted pointer to the coefficients object */
         using CoefficientsPtr = typename Coefficients<NumericType>::Ptr;
 
+        /** Filters with more coefficients than this are processed using FFT convolution.
+            This only applies to Filter<float>, as the FFT class works in single precision.
+        */
+        static constexpr size_t partitionedConvolutionThreshold = 1024;
+
         //==============================================================================
         /** This will create a filter which will produce silence. */
         Filter() : coefficients (new Coefficients<NumericType>)                                     { reset(); }
@@ -105,6 +115,28 @@ namespace FIR
 
                 for (size_t i = 0; i < size; ++i)
                     fifo[i] = SampleType {0};
+
+                pos = 0;
+
+                if constexpr (std::is_same_v<SampleType, float>)
+                {
+                    if (size > partitionedConvolutionThreshold)
+                    {
+                        const auto* tail = coefficients->getRawCoefficients() + PartitionedConvolution::partitionSize;
+                        const auto tailSize = size - PartitionedConvolution::partitionSize;
+
+                        if (convolution == nullptr || convolution->getNumTaps() != tailSize)
+                            convolution = std::make_unique<PartitionedConvolution> (tail, tailSize);
+                        else
+                            convolution->setTaps (tail);
+
+                        convolution->reset();
+                    }
+                    else
+                    {
+                        convolution.reset();
+                    }
+                }
             }
         }
 
@@ -141,6 +173,25 @@ namespace FIR
             auto* fir = coefficients->getRawCoefficients();
             size_t p = pos;
 
+            if constexpr (std::is_same_v<SampleType, float>)
+            {
+                if (convolution != nullptr)
+                {
+                    const auto headSize = PartitionedConvolution::partitionSize;
+
+                    // The filter keeps running when it's bypassed, so that there's no glitch when it's re-enabled
+                    for (size_t i = 0; i < numSamples; ++i)
+                    {
+                        const auto input = src[i];
+                        const auto output = convolution->processSample (input, processSingleSample (input, fifo, fir, headSize, p), fir + headSize);
+                        dst[i] = context.isBypassed ? input : output;
+                    }
+
+                    pos = p;
+                    return;
+                }
+            }
+
             if (context.isBypassed)
             {
                 for (size_t i = 0; i < numSamples; ++i)
@@ -165,14 +216,142 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
+
+            if constexpr (std::is_same_v<SampleType, float>)
+                if (convolution != nullptr)
+                {
+                    const auto* fir = coefficients->getRawCoefficients();
+                    const auto headSize = PartitionedConvolution::partitionSize;
+                    return convolution->processSample (sample, processSingleSample (sample, fifo, fir, headSize, pos), fir + headSize);
+                }
+
             return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
         }
 
     private:
+        //==============================================================================
+        /*  Applies all of the coefficients after the first partitionSize, using a uniformly
+            partitioned overlap-save convolution. Each time a partition's worth of input has
+            been collected, its spectrum is combined with those of the previous blocks to
+            produce the tail's output for the next block, which is exactly when it's first
+            needed, as the first partitionSize coefficients are handled in the time domain.
+        */
+        class PartitionedConvolution
+        {
+        public:
+            static constexpr int partitionOrder = 8;
+            static constexpr size_t partitionSize = (size_t) 1 << partitionOrder;
+
+            PartitionedConvolution (const float* tapsToUse, size_t numTapsToUse)
+                : fft (partitionOrder + 1),
+                  numTaps (numTapsToUse),
+                  numPartitions ((numTapsToUse + partitionSize - 1) / partitionSize)
+            {
+                taps.calloc (numTaps);
+                filterSpectra.calloc (numPartitions * numBins);
+                inputSpectra.calloc (numPartitions * numBins);
+                accumulator.calloc (numBins);
+                fftBuffer.calloc (fftSize * 2);
+                inputBlocks.calloc (fftSize);
+                tailOutput.calloc (partitionSize);
+
+                setTaps (tapsToUse);
+            }
+
+            size_t getNumTaps() const noexcept      { return numTaps; }
+
+            void setTaps (const float* newTaps) noexcept
+            {
+                if (memcmp (newTaps, taps, numTaps * sizeof (float)) == 0)
+                    return;
+
+                FloatVectorOperations::copy (taps, newTaps, (int) numTaps);
+
+                for (size_t p = 0; p < numPartitions; ++p)
+                {
+                    const auto numThisTime = jmin (partitionSize, numTaps - p * partitionSize);
+
+                    zeromem (fftBuffer, fftSize * 2 * sizeof (float));
+                    FloatVectorOperations::copy (fftBuffer.getData(), taps + p * partitionSize, (int) numThisTime);
+                    fft.performRealOnlyForwardTransform (fftBuffer, true);
+
+                    std::copy_n (reinterpret_cast<const Complex<float>*> (fftBuffer.getData()), numBins, filterSpectra + p * numBins);
+                }
+            }
+
+            void reset() noexcept
+            {
+                zeromem (inputSpectra, numPartitions * numBins * sizeof (Complex<float>));
+                zeromem (inputBlocks, fftSize * sizeof (float));
+                zeromem (tailOutput, partitionSize * sizeof (float));
+                position = 0;
+            }
+
+            // Changes to the taps are picked up at the end of each partition
+            float processSample (float input, float headOutput, const float* currentTaps) noexcept
+            {
+                const auto output = headOutput + tailOutput[position];
+                inputBlocks[partitionSize + position] = input;
+
+                if (++position == partitionSize)
+                {
+                    setTaps (currentTaps);
+                    processBlock();
+                }
+
+                return output;
+            }
+
+        private:
+            static constexpr size_t fftSize = partitionSize * 2;
+            static constexpr size_t numBins = partitionSize + 1;
+
+            FFT fft;
+            const size_t numTaps, numPartitions;
+            HeapBlock<float> taps, fftBuffer, inputBlocks, tailOutput;
+            HeapBlock<Complex<float>> filterSpectra, inputSpectra, accumulator;
+            size_t position = 0, newestSpectrum = 0;
+
+            void processBlock() noexcept
+            {
+                // The previous block and the one that's just been filled are transformed together
+                FloatVectorOperations::copy (fftBuffer.getData(), inputBlocks.getData(), (int) fftSize);
+                fft.performRealOnlyForwardTransform (fftBuffer, true);
+
+                newestSpectrum = (newestSpectrum == 0 ? numPartitions : newestSpectrum) - 1;
+                std::copy_n (reinterpret_cast<const Complex<float>*> (fftBuffer.getData()), numBins, inputSpectra + newestSpectrum * numBins);
+
+                zeromem (accumulator, numBins * sizeof (Complex<float>));
+
+                for (size_t p = 0, index = newestSpectrum; p < numPartitions; ++p)
+                {
+                    const auto* x = inputSpectra  + index * numBins;
+                    const auto* h = filterSpectra + p * numBins;
+
+                    for (size_t bin = 0; bin < numBins; ++bin)
+                        accumulator[bin] += x[bin] * h[bin];
+
+                    if (++index == numPartitions)
+                        index = 0;
+                }
+
+                std::copy_n (accumulator.getData(), numBins, reinterpret_cast<Complex<float>*> (fftBuffer.getData()));
+                fft.performRealOnlyInverseTransform (fftBuffer);
+
+                // Only the second half of the result is free of circular wrap-around
+                FloatVectorOperations::copy (tailOutput.getData(), fftBuffer + partitionSize, (int) partitionSize);
+                FloatVectorOperations::copy (inputBlocks.getData(), inputBlocks + partitionSize, (int) partitionSize);
+                position = 0;
+            }
+
+            JUCE_DECLARE_NON_COPYABLE (PartitionedConvolution)
+        };
+
         //==============================================================================
         HeapBlock<SampleType> memory;
         SampleType* fifo = nullptr;
         size_t pos = 0, size = 0;
+        std::unique_ptr<PartitionedConvolution> convolution;
 
         //==============================================================================
         void check()
@@ -190,12 +369,22 @@ namespace FIR
 
             buf[p] = sample;
 
-            size_t k;
-            for (k = 0; k < m - p; ++k)
-                out += buf[(p + k)] * fir[k];
+            if constexpr (std::is_floating_point_v<SampleType>)
+            {
+                // The delay line is split into two contiguous parts, so the convolution can use
+                // the fastest instruction set available on the CPU at runtime
+                out = FloatVectorOperations::dotProduct (buf + p, fir, m - p)
+                    + FloatVectorOperations::dotProduct (buf, fir + (m - p), p);
+            }
+            else
+            {
+                size_t k;
+                for (k = 0; k < m - p; ++k)
+                    out += buf[(p + k)] * fir[k];
 
-            for (size_t j = 0; j < p; ++j)
-                out += buf[j] * fir[j + k];
+                for (size_t j = 0; j < p; ++j)
+                    out += buf[j] * fir[j + k];
+            }
 
             p = (p == 0 ? m - 1 : p - 1);
 
@@ -202,6 +202,37 @@ class FIRFilterTest : public UnitTest
        #endif
     }
 
+    //==============================================================================
+    template <typename TheTest>
+    void runLongFilterTest (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        Random random (8392829);
+
+        for (auto size : { 1025, 2048, 4097 })
+        {
+            const size_t n = 10000;
+
+            std::vector<float> input (n), output (n), ref (n), fir ((size_t) size);
+            fillRandom (random, input.data(), n);
+            fillRandom (random, fir.data(), (size_t) size);
+
+            FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir.data(), (size_t) size));
+            filter.prepare ({ 0.0, (uint32) n, 1 });
+
+            reference<float, float> (fir.data(), (size_t) size, input.data(), ref.data(), n);
+            TheTest::template run<float> (filter, input.data(), output.data(), n);
+
+            // The FFT introduces slightly larger rounding errors than direct convolution
+            auto maxError = 0.0f;
+
+            for (size_t i = 0; i < n; ++i)
+                maxError = jmax (maxError, std::abs (output[i] - ref[i]));
+
+            expect (maxError < 1.0e-3f);
+        }
+    }
 
 public:
     FIRFilterTest()
@@ -213,6 +244,10 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        runLongFilterTest<LargeBlockTest> ("Long filter, Large Blocks");
+        runLongFilterTest<SampleBySampleTest> ("Long filter, Sample by Sample");
+        runLongFilterTest<SplitBlockTest> ("Long filter, Split Block");
     }
 };
 
@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+/**
+    A processing class that applies the same IIR filter to every channel of a
+    multi-channel signal, processing several channels at once.
+
+    Rather than keeping a separate IIR::Filter for each channel (e.g. using a
+    ProcessorDuplicator), this class stores the state of all channels side-by-side, so
+    that each SIMDRegister lane handles a different channel. The filter is made from a
+    cascade of first or second order sections, which is the form that high-order
+    designs (such as those created by FilterDesign) are usually supplied in, and which
+    is more numerically robust than a single high-order section.
+
+    Each section uses the Transposed Direct Form II structure, so for a single section
+    the output is the same as IIR::Filter.
+
+    @see IIR::Filter, FilterDesign
+
+    @tags{DSP}
+*/
+template <typename NumericType>
+class MultiChannelFilter
+{
+public:
+    //==============================================================================
+    using Lanes = SIMDRegister<NumericType>;
+    using CoefficientsPtr = typename Coefficients<NumericType>::Ptr;
+
+    /** The number of channels that are processed side-by-side. */
+    static constexpr size_t numLanes = Lanes::SIMDNumElements;
+
+    //==============================================================================
+    /** Creates a filter with no sections, which will pass its input through unchanged. */
+    MultiChannelFilter() = default;
+
+    /** Creates a filter with a single section. */
+    explicit MultiChannelFilter (CoefficientsPtr coefficientsToUse)     { setCoefficients (std::move (coefficientsToUse)); }
+
+    /** Creates a filter from a cascade of sections. */
+    explicit MultiChannelFilter (const ReferenceCountedArray<Coefficients<NumericType>>& sectionsToUse)
+    {
+        setCoefficients (sectionsToUse);
+    }
+
+    //==============================================================================
+    /** Replaces the filter with a single section, which must be of order 1 or 2. */
+    void setCoefficients (CoefficientsPtr newCoefficients)
+    {
+        ReferenceCountedArray<Coefficients<NumericType>> newSections;
+        newSections.add (std::move (newCoefficients));
+        setCoefficients (newSections);
+    }
+
+    /** Replaces the filter with a cascade of sections, which are applied in order.
+
+        Each section must be of order 1 or 2. If the number of sections is the same as
+        before, the filter's state is kept, so this can be used to change the response
+        of a filter while it's running. Changing the number of sections will reset the
+        state, and may allocate memory.
+    */
+    void setCoefficients (const ReferenceCountedArray<Coefficients<NumericType>>& newSections)
+    {
+        const auto numSectionsChanged = (size_t) newSections.size() != sections.size();
+        sections.resize ((size_t) newSections.size());
+
+        for (int i = 0; i < newSections.size(); ++i)
+        {
+            auto* section = newSections.getObjectPointerUnchecked (i);
+            jassert (section != nullptr);
+
+            const auto order = section->getFilterOrder();
+            const auto* c = section->getRawCoefficients();
+
+            // Only first and second order sections can be used here
+            jassert (order == 1 || order == 2);
+
+            auto& s = sections[(size_t) i];
+
+            if (order == 2)
+            {
+                s.b0 = Lanes::expand (c[0]);  s.b1 = Lanes::expand (c[1]);  s.b2 = Lanes::expand (c[2]);
+                s.a1 = Lanes::expand (c[3]);  s.a2 = Lanes::expand (c[4]);
+            }
+            else
+            {
+                s.b0 = Lanes::expand (c[0]);  s.b1 = Lanes::expand (c[1]);  s.b2 = Lanes::expand (NumericType());
+                s.a1 = Lanes::expand (c[2]);  s.a2 = Lanes::expand (NumericType());
+            }
+        }
+
+        if (numSectionsChanged)
+            allocateState();
+    }
+
+    /** Returns the number of sections in the cascade. */
+    size_t getNumSections() const noexcept      { return sections.size(); }
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec)
+    {
+        numChannels = (size_t) spec.numChannels;
+        allocateState();
+    }
+
+    /** Resets the state of all of the channels. */
+    void reset() noexcept
+    {
+        std::fill (state.begin(), state.end(), Lanes::expand (NumericType()));
+    }
+
+    /** Processes a block of samples.
+
+        The block can have up to as many channels as the ProcessSpec passed to prepare().
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, NumericType>,
+                       "The sample-type of the filter must match the sample-type supplied to this process callback");
+
+        auto&& inputBlock  = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+        jassert (outputBlock.getNumChannels() <= numChannels); // did you call prepare()?
+
+        const auto numChannelsToProcess = jmin (outputBlock.getNumChannels(), numChannels);
+        const auto numSamples = outputBlock.getNumSamples();
+
+        if (sections.empty() || context.isBypassed)
+        {
+            // When bypassed, the filter keeps running so that there's no glitch when it's re-enabled
+            if (! sections.empty())
+                for (size_t first = 0; first < numChannelsToProcess; first += numLanes)
+                    processGroup<false> (inputBlock, outputBlock, first, jmin (numLanes, numChannelsToProcess - first), numSamples);
+
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        for (size_t first = 0; first < numChannelsToProcess; first += numLanes)
+            processGroup<true> (inputBlock, outputBlock, first, jmin (numLanes, numChannelsToProcess - first), numSamples);
+    }
+
+    /** Ensures that the state variables are rounded to zero if they're denormals.
+        This is done automatically at the end of each call to process().
+    */
+    void snapToZero() noexcept          { snapToZero (state.data(), state.size()); }
+
+private:
+    //==============================================================================
+    struct Section
+    {
+        Lanes b0, b1, b2, a1, a2;
+    };
+
+    // Samples are moved in and out of the lanes in chunks of this many samples
+    static constexpr size_t chunkSize = 64;
+
+    std::vector<Section> sections;
+    std::vector<Lanes> state;
+    size_t numChannels = 0;
+
+    void allocateState()
+    {
+        const auto numGroups = (numChannels + numLanes - 1) / numLanes;
+        state.assign (numGroups * sections.size() * 2, Lanes::expand (NumericType()));
+    }
+
+    template <bool writeOutput, typename InputBlock, typename OutputBlock>
+    void processGroup (const InputBlock& inputBlock, const OutputBlock& outputBlock,
+                       size_t firstChannel, size_t numChannelsInGroup, size_t numSamples) noexcept
+    {
+        alignas (sizeof (Lanes)) NumericType interleaved[chunkSize * numLanes] = {};
+        auto* groupState = state.data() + (firstChannel / numLanes) * sections.size() * 2;
+
+        for (size_t pos = 0; pos < numSamples; pos += chunkSize)
+        {
+            const auto numThisTime = jmin (chunkSize, numSamples - pos);
+
+            for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+            {
+                const auto* src = inputBlock.getChannelPointer (firstChannel + lane) + pos;
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                    interleaved[i * numLanes + lane] = src[i];
+            }
+
+            for (size_t s = 0; s < sections.size(); ++s)
+            {
+                const auto& section = sections[s];
+                auto s1 = groupState[2 * s];
+                auto s2 = groupState[2 * s + 1];
+
+                for (size_t i = 0; i < numThisTime; ++i)
+                {
+                    auto* sample = interleaved + i * numLanes;
+                    const auto input = Lanes::fromRawArray (sample);
+                    const auto output = (input * section.b0) + s1;
+
+                    s1 = (input * section.b1) - (output * section.a1) + s2;
+                    s2 = (input * section.b2) - (output * section.a2);
+
+                    output.copyToRawArray (sample);
+                }
+
+                groupState[2 * s]     = s1;
+                groupState[2 * s + 1] = s2;
+            }
+
+            if constexpr (writeOutput)
+            {
+                for (size_t lane = 0; lane < numChannelsInGroup; ++lane)
+                {
+                    auto* dst = outputBlock.getChannelPointer (firstChannel + lane) + pos;
+
+                    for (size_t i = 0; i < numThisTime; ++i)
+                        dst[i] = interleaved[i * numLanes + lane];
+                }
+            }
+        }
+
+        snapToZero (groupState, sections.size() * 2);
+    }
+
+    static void snapToZero (Lanes* registers, size_t num) noexcept
+    {
+        alignas (sizeof (Lanes)) NumericType values[numLanes];
+
+        for (size_t i = 0; i < num; ++i)
+        {
+            registers[i].copyToRawArray (values);
+
+            for (auto& v : values)
+                util::snapToZero (v);
+
+            registers[i] = Lanes::fromRawArray (values);
+        }
+    }
+
+    JUCE_LEAK_DETECTOR (MultiChannelFilter)
+};
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,155 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class MultiChannelIIRFilterTests  : public UnitTest
+{
+public:
+    MultiChannelIIRFilterTests()
+        : UnitTest ("MultiChannelIIRFilter", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("A single section matches IIR::Filter");
+        {
+            runComparison (makeArray (IIR::Coefficients<float>::makePeakFilter (44100.0, 1000.0f, 0.7f, 2.0f)), 1.0e-5);
+            runComparison (makeArray (IIR::Coefficients<double>::makeLowPass (44100.0, 500.0)), 1.0e-12);
+            runComparison (makeArray (IIR::Coefficients<float>::makeFirstOrderHighPass (44100.0, 200.0f)), 1.0e-5);
+        }
+
+        beginTest ("A cascade matches a chain of IIR::Filters");
+        {
+            runComparison (FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (2000.0f, 48000.0, 7), 1.0e-4);
+            runComparison (FilterDesign<double>::designIIRHighpassHighOrderButterworthMethod (300.0, 48000.0, 8), 1.0e-10);
+        }
+
+        beginTest ("Bypassing keeps the state running");
+        {
+            auto sections = FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (1000.0f, 48000.0, 4);
+
+            IIR::MultiChannelFilter<float> bypassed (sections), reference (sections);
+            const ProcessSpec spec { 48000.0, 256, 3 };
+            bypassed.prepare (spec);
+            reference.prepare (spec);
+
+            AudioBuffer<float> a (3, 256), b (3, 256);
+            fillWithNoise (a);
+            b.makeCopyOf (a);
+
+            AudioBlock<float> blockA (a), blockB (b);
+            ProcessContextReplacing<float> contextA (blockA);
+            contextA.isBypassed = true;
+            bypassed.process (contextA);
+            reference.process (ProcessContextReplacing<float> (blockB));
+
+            fillWithNoise (a);
+            b.makeCopyOf (a);
+            contextA.isBypassed = false;
+            bypassed.process (contextA);
+            reference.process (ProcessContextReplacing<float> (blockB));
+
+            expect (getMaxDifference (a, b) < 1.0e-6);
+        }
+    }
+
+private:
+    template <typename NumericType>
+    static ReferenceCountedArray<IIR::Coefficients<NumericType>> makeArray (ReferenceCountedObjectPtr<IIR::Coefficients<NumericType>> coefficients)
+    {
+        ReferenceCountedArray<IIR::Coefficients<NumericType>> result;
+        result.add (coefficients);
+        return result;
+    }
+
+    template <typename NumericType>
+    void runComparison (const ReferenceCountedArray<IIR::Coefficients<NumericType>>& sections, double tolerance)
+    {
+        // An odd number of channels, so that the last group of lanes isn't full
+        constexpr int numChannels = 5;
+        constexpr int numSamples = 1000;
+
+        AudioBuffer<NumericType> input (numChannels, numSamples), expected, actual;
+        fillWithNoise (input);
+        expected.makeCopyOf (input);
+        actual.makeCopyOf (input);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (auto* section : sections)
+            {
+                IIR::Filter<NumericType> filter (section);
+                auto* data = expected.getWritePointer (channel);
+
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] = filter.processSample (data[i]);
+            }
+        }
+
+        IIR::MultiChannelFilter<NumericType> filter (sections);
+        filter.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+
+        // Uneven block sizes, to check that the state is carried between blocks
+        AudioBlock<NumericType> block (actual);
+
+        for (size_t pos = 0, blockSize = 1; pos < (size_t) numSamples; pos += blockSize, blockSize = blockSize * 3 + 1)
+        {
+            auto subBlock = block.getSubBlock (pos, jmin (blockSize, (size_t) numSamples - pos));
+            filter.process (ProcessContextReplacing<NumericType> (subBlock));
+        }
+
+        expect (getMaxDifference (expected, actual) < tolerance);
+    }
+
+    template <typename NumericType>
+    static void fillWithNoise (AudioBuffer<NumericType>& buffer)
+    {
+        Random random (0x1234);
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (channel, i, (NumericType) (random.nextDouble() * 2.0 - 1.0));
+    }
+
+    template <typename NumericType>
+    static double getMaxDifference (const AudioBuffer<NumericType>& a, const AudioBuffer<NumericType>& b)
+    {
+        double result = 0.0;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, (double) std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return result;
+    }
+};
+
+static MultiChannelIIRFilterTests multiChannelIIRFilterTests;
+
+} // namespace dsp
+} // namespace juce
@@ -108,6 +108,11 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    Because of the zero coefficients, each output only depends on every other
+    input of the filter, so those are kept in a contiguous history buffer and
+    convolved with the non-zero coefficients using FloatVectorOperations, which
+    picks the widest instruction set available at runtime.
 */
 template <typename SampleType>
 struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
@@ -124,14 +129,13 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        kernelUp   = getPolyphaseKernel (coefficientsUp);
+        kernelDown = getPolyphaseKernel (coefficientsDown);
 
-        N = coefficientsDown.getFilterOrder() + 1;
+        auto N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
         auto Ndiv4 = Ndiv2 / 2;
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
         stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
 
         position.resize (static_cast<int> (this->numChannels));
@@ -143,6 +147,15 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        // Each history buffer holds the samples needed from the previous block, followed by the current block
+        stateUp.setSize   (static_cast<int> (this->numChannels), static_cast<int> (kernelUp.size()   - 1 + maximumNumberOfSamplesBeforeOversampling));
+        stateDown.setSize (static_cast<int> (this->numChannels), static_cast<int> (kernelDown.size() - 1 + maximumNumberOfSamplesBeforeOversampling));
+    }
+
     void reset() override
     {
         ParentType::reset();
@@ -158,39 +171,36 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
     {
         jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        jassert (kernelUp.size() - 1 + inputBlock.getNumSamples() <= static_cast<size_t> (stateUp.getNumSamples()));
 
         // Initialization
         auto fir = coefficientsUp.getRawCoefficients();
         auto N = coefficientsUp.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
+        auto kernel = kernelUp.data();
+        auto kernelSize = kernelUp.size();
+        auto middle = kernelSize / 2;
         auto numSamples = inputBlock.getNumSamples();
 
         // Processing
         for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
+            auto history = stateUp.getWritePointer (static_cast<int> (channel));
             auto samples = inputBlock.getChannelPointer (channel);
 
+            // Input
+            FloatVectorOperations::copyWithMultiply (history + kernelSize - 1, samples, static_cast<SampleType> (2), numSamples);
+
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
-
-                // Convolution
-                auto out = static_cast<SampleType> (0.0);
-
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
-
                 // Outputs
-                bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                bufferSamples[i << 1] = FloatVectorOperations::dotProduct (history + i, kernel, kernelSize);
+                bufferSamples[(i << 1) + 1] = history[i + middle] * fir[Ndiv2];
             }
+
+            // Keep the samples needed by the next block
+            std::copy (history + numSamples, history + numSamples + kernelSize - 1, history);
         }
     }
 
@@ -198,33 +208,34 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
     {
         jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
         jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+        jassert (kernelDown.size() - 1 + outputBlock.getNumSamples() <= static_cast<size_t> (stateDown.getNumSamples()));
 
         // Initialization
         auto fir = coefficientsDown.getRawCoefficients();
         auto N = coefficientsDown.getFilterOrder() + 1;
         auto Ndiv2 = N / 2;
         auto Ndiv4 = Ndiv2 / 2;
+        auto kernel = kernelDown.data();
+        auto kernelSize = kernelDown.size();
         auto numSamples = outputBlock.getNumSamples();
 
         // Processing
         for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
         {
             auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
+            auto history = stateDown.getWritePointer (static_cast<int> (channel));
             auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
             auto samples = outputBlock.getChannelPointer (channel);
             auto pos = position.getUnchecked (static_cast<int> (channel));
 
+            // Input
             for (size_t i = 0; i < numSamples; ++i)
-            {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                history[kernelSize - 1 + i] = bufferSamples[i << 1];
 
+            for (size_t i = 0; i < numSamples; ++i)
+            {
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
-
-                for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                auto out = FloatVectorOperations::dotProduct (history + i, kernel, kernelSize);
 
                 // Output
                 out += buf2[pos] * fir[Ndiv2];
@@ -232,22 +243,44 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
 
                 samples[i] = out;
 
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
-
                 // Circular buffer
                 pos = (pos == 0 ? Ndiv4 : pos - 1);
             }
 
+            // Keep the samples needed by the next block
+            std::copy (history + numSamples, history + numSamples + kernelSize - 1, history);
+
             position.setUnchecked (static_cast<int> (channel), pos);
         }
 
     }
 
 private:
+    //==============================================================================
+    /*  Returns the coefficients that apply to the even-indexed inputs, i.e. every other
+        coefficient of the filter. The two halves are mirrored, so the result is exactly
+        symmetric like the filter itself.
+    */
+    static std::vector<SampleType> getPolyphaseKernel (const FIR::Coefficients<SampleType>& coefficients)
+    {
+        auto fir = coefficients.getRawCoefficients();
+        auto N = coefficients.getFilterOrder() + 1;
+        auto Ndiv2 = N / 2;
+
+        // The half band design always has a filter length of 4n + 3
+        jassert (N % 4 == 3);
+
+        std::vector<SampleType> kernel ((N + 1) / 2);
+
+        for (size_t k = 0; k < Ndiv2; k += 2)
+            kernel[k / 2] = kernel[kernel.size() - 1 - k / 2] = fir[k];
+
+        return kernel;
+    }
+
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
+    std::vector<SampleType> kernelUp, kernelDown;
     AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
     Array<size_t> position;
 
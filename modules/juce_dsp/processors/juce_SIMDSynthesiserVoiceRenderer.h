@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A base class for SynthesiserVoiceBatchRenderer objects that render one voice per
+    SIMDRegister lane.
+
+    To use it, derive a class from this that implements renderLanes(), and make your
+    voice class return a shared instance of it from SynthesiserVoice::getBatchRenderer().
+    The Synthesiser will then hand over its active voices in groups, which this class
+    splits up into sets of up to SIMDRegister<float>::size() voices and passes to
+    renderLanes() along with a block of lane-wise output registers. Every set of voices
+    adds its output to the same registers, and once all of them have been rendered, each
+    register is summed horizontally and added to the output buffer.
+
+    Blocks are processed in chunks of at most maxBlockSize samples, and only voices that
+    are still active at the start of a chunk are passed to renderLanes(). The maxChannels
+    template parameter sets the number of channels there's room for in the lane-wise
+    outputs. Buffers with more channels than that, and double-precision buffers, are
+    rendered using each voice's renderNextBlock() method.
+
+    @see SynthesiserVoiceBatchRenderer, SynthesiserVoice::getBatchRenderer
+
+    @tags{DSP}
+*/
+template <typename VoiceType, int maxChannels = 2>
+class SIMDSynthesiserVoiceRenderer  : public SynthesiserVoiceBatchRenderer
+{
+public:
+    //==============================================================================
+    using Lanes = SIMDRegister<float>;
+
+    /** The number of voices that can be rendered side-by-side. */
+    static constexpr int numLanes = (int) Lanes::SIMDNumElements;
+
+    /** The largest number of channels that will be passed to renderLanes(). */
+    static constexpr int maxNumChannels = maxChannels;
+
+    /** The largest number of samples that will be passed to renderLanes(). */
+    static constexpr int maxBlockSize = 64;
+
+    //==============================================================================
+    /** Renders up to numLanes voices at once.
+
+        Lane i of each output register belongs to voices[i]. The outputs are arranged as
+        outputs[channel][sample], and may already contain the output of other voices, so
+        each voice's output must be added to its lane, and any unused lanes must be left
+        unchanged. If a voice finishes playing during the block, call clearCurrentNote()
+        for it.
+
+        This may be called on several threads at once if the Synthesiser is rendering
+        voices in parallel, so it shouldn't modify any state other than that of the voices.
+    */
+    virtual void renderLanes (VoiceType* const* voices, int numVoices,
+                              Lanes* const* outputs, int numChannels, int numSamples) = 0;
+
+    //==============================================================================
+    using SynthesiserVoiceBatchRenderer::renderVoices;
+
+    /** @internal */
+    void renderVoices (SynthesiserVoice* const* voices, int numVoices,
+                       AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override
+    {
+        const auto numChannels = outputBuffer.getNumChannels();
+
+        if (numChannels > maxNumChannels)
+        {
+            // There's only room for maxNumChannels channels in the lane-wise outputs, so these
+            // voices will be rendered one at a time. If you need to render this many channels,
+            // increase the maxChannels template parameter of your renderer.
+            jassertfalse;
+
+            for (int i = 0; i < numVoices; ++i)
+                voices[i]->renderNextBlock (outputBuffer, startSample, numSamples);
+
+            return;
+        }
+
+        Lanes laneOutputs[channelCapacity][blockCapacity];
+        Lanes* outputs[channelCapacity];
+        VoiceType* lanes[numLanes];
+
+        for (int channel = 0; channel < maxNumChannels; ++channel)
+            outputs[channel] = laneOutputs[channel];
+
+        for (int pos = 0; pos < numSamples; pos += maxBlockSize)
+        {
+            const auto numThisTime = jmin (maxBlockSize, numSamples - pos);
+            int voiceIndex = 0;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                std::fill (outputs[channel], outputs[channel] + numThisTime, Lanes::expand (0.0f));
+
+            for (;;)
+            {
+                int numInLanes = 0;
+
+                for (; voiceIndex < numVoices && numInLanes < numLanes; ++voiceIndex)
+                {
+                    if (voices[voiceIndex]->isVoiceActive())
+                    {
+                        jassert (dynamic_cast<VoiceType*> (voices[voiceIndex]) != nullptr);
+                        lanes[numInLanes++] = static_cast<VoiceType*> (voices[voiceIndex]);
+                    }
+                }
+
+                if (numInLanes == 0)
+                    break;
+
+                renderLanes (lanes, numInLanes, outputs, numChannels, numThisTime);
+            }
+
+            // The lanes are only summed once per chunk, however many sets of voices were rendered
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* dest = outputBuffer.getWritePointer (channel, startSample + pos);
+
+                for (int i = 0; i < numThisTime; ++i)
+                    dest[i] += outputs[channel][i].sum();
+            }
+        }
+    }
+
+private:
+    static constexpr size_t channelCapacity = (size_t) maxNumChannels;
+    static constexpr size_t blockCapacity = (size_t) maxBlockSize;
+};
+
+} // namespace dsp
+} // namespace juce
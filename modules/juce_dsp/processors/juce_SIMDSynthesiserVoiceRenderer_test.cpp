@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SIMDSynthesiserVoiceRendererTests  : public UnitTest
+{
+public:
+    SIMDSynthesiserVoiceRendererTests()
+        : UnitTest ("SIMDSynthesiserVoiceRenderer", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("Batched rendering matches voice-by-voice rendering");
+        {
+            const auto reference = render (false, 0);
+
+            LaneRenderer renderer;
+            expect (getMaxDifference (reference, render (true, 0, &renderer)) < 1.0e-5f);
+            expect (renderer.numCalls > 0);
+        }
+
+        beginTest ("Batched rendering works with parallel rendering");
+        {
+            LaneRenderer renderer;
+            expect (getMaxDifference (render (false, 0), render (true, 3, &renderer)) < 1.0e-5f);
+            expect (renderer.numCalls > 0);
+        }
+
+        beginTest ("Finished voices are released");
+        {
+            LaneRenderer renderer;
+            Synthesiser synth;
+            prepare (synth, true, 0, &renderer);
+
+            AudioBuffer<float> buffer (2, 256);
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 0);
+            synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+
+            int numActive = 0;
+
+            for (int i = 0; i < synth.getNumVoices(); ++i)
+                numActive += synth.getVoice (i)->isVoiceActive() ? 1 : 0;
+
+            expectEquals (numActive, 1);
+
+            midi.clear();
+
+            for (int i = 0; i < 100; ++i)
+                synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples());
+
+            expect (! synth.getVoice (0)->isVoiceActive());
+        }
+    }
+
+private:
+    //==============================================================================
+    static constexpr float decayPerSample = 0.9995f, silenceThreshold = 1.0e-3f;
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // A decaying sine, generated by rotating a phasor
+    struct TestVoice  : public SynthesiserVoice
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float velocity, SynthesiserSound*, int) override
+        {
+            const auto angle = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (note) / getSampleRate();
+            rotationCos = (float) std::cos (angle);
+            rotationSin = (float) std::sin (angle);
+            real = velocity * 0.1f;
+            imag = 0.0f;
+            level = 1.0f;
+        }
+
+        void stopNote (float, bool) override            { clearCurrentNote(); }
+        void pitchWheelMoved (int) override             {}
+        void controllerMoved (int, int) override        {}
+
+        SynthesiserVoiceBatchRenderer* getBatchRenderer() const override    { return batchRenderer; }
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int pos = 0; pos < numSamples; pos += LaneRenderer::maxBlockSize)
+            {
+                const auto numThisTime = jmin ((int) LaneRenderer::maxBlockSize, numSamples - pos);
+
+                for (int i = startSample + pos; i < startSample + pos + numThisTime; ++i)
+                {
+                    const auto value = imag * level;
+                    buffer.addSample (0, i, value);
+                    buffer.addSample (1, i, value * 0.5f);
+
+                    const auto newReal = real * rotationCos - imag * rotationSin;
+                    imag = real * rotationSin + imag * rotationCos;
+                    real = newReal;
+                    level *= decayPerSample;
+                }
+
+                if (level < silenceThreshold)
+                {
+                    clearCurrentNote();
+                    return;
+                }
+            }
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        SynthesiserVoiceBatchRenderer* batchRenderer = nullptr;
+        float rotationCos = 1.0f, rotationSin = 0.0f, real = 0.0f, imag = 0.0f, level = 0.0f;
+    };
+
+    // Renders the same decaying sine, keeping the state of each voice in its own lane
+    struct LaneRenderer  : public SIMDSynthesiserVoiceRenderer<TestVoice>
+    {
+        void renderLanes (TestVoice* const* voices, int numVoices,
+                          Lanes* const* outputs, int numChannels, int numSamples) override
+        {
+            ++numCalls;
+
+            alignas (Lanes) float values[5][numLanes] = {};
+
+            for (int i = 0; i < numVoices; ++i)
+            {
+                values[0][i] = voices[i]->rotationCos;
+                values[1][i] = voices[i]->rotationSin;
+                values[2][i] = voices[i]->real;
+                values[3][i] = voices[i]->imag;
+                values[4][i] = voices[i]->level;
+            }
+
+            const auto rotationCos = Lanes::fromRawArray (values[0]);
+            const auto rotationSin = Lanes::fromRawArray (values[1]);
+            auto real  = Lanes::fromRawArray (values[2]);
+            auto imag  = Lanes::fromRawArray (values[3]);
+            auto level = Lanes::fromRawArray (values[4]);
+            const auto decay = Lanes::expand (decayPerSample);
+            const auto half = Lanes::expand (0.5f);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto value = imag * level;
+                outputs[0][i] += value;
+
+                if (numChannels > 1)
+                    outputs[1][i] += value * half;
+
+                const auto newReal = real * rotationCos - imag * rotationSin;
+                imag = real * rotationSin + imag * rotationCos;
+                real = newReal;
+                level *= decay;
+            }
+
+            real.copyToRawArray (values[2]);
+            imag.copyToRawArray (values[3]);
+            level.copyToRawArray (values[4]);
+
+            for (int i = 0; i < numVoices; ++i)
+            {
+                voices[i]->real  = values[2][i];
+                voices[i]->imag  = values[3][i];
+                voices[i]->level = values[4][i];
+
+                if (values[4][i] < silenceThreshold)
+                    clearCurrentNote (*voices[i]);
+            }
+        }
+
+        std::atomic<int> numCalls { 0 };
+    };
+
+    //==============================================================================
+    static void prepare (Synthesiser& synth, bool useBatchRenderer, int numThreads, LaneRenderer* renderer)
+    {
+        synth.setNumParallelRenderThreads (numThreads);
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < 13; ++i)
+        {
+            auto* voice = new TestVoice();
+            voice->batchRenderer = useBatchRenderer ? renderer : nullptr;
+            synth.addVoice (voice);
+        }
+
+        synth.setCurrentPlaybackSampleRate (44100.0);
+    }
+
+    static AudioBuffer<float> render (bool useBatchRenderer, int numThreads, LaneRenderer* renderer = nullptr)
+    {
+        constexpr int blockSize = 300, numBlocks = 20;
+
+        Synthesiser synth;
+        prepare (synth, useBatchRenderer, numThreads, renderer);
+
+        AudioBuffer<float> result (2, blockSize * numBlocks);
+        result.clear();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            MidiBuffer midi;
+
+            for (int note = 0; note < 3; ++note)
+                midi.addEvent (MidiMessage::noteOn (1, 40 + (block * 3 + note) % 40, 0.8f), note * 90);
+
+            AudioBuffer<float> view (result.getArrayOfWritePointers(), 2, block * blockSize, blockSize);
+            synth.renderNextBlock (view, midi, 0, blockSize);
+        }
+
+        return result;
+    }
+
+    static float getMaxDifference (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        float result = 0;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                result = jmax (result, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return result;
+    }
+};
+
+static SIMDSynthesiserVoiceRendererTests simdSynthesiserVoiceRendererTests;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+SampleRateConverter::SampleRateConverter (double rate, Quality q)
+    : outputSampleRate (rate), quality (q)
+{
+    jassert (rate > 0);
+}
+
+void SampleRateConverter::setOutputSampleRate (double newOutputSampleRate)
+{
+    jassert (newOutputSampleRate > 0);
+    outputSampleRate = newOutputSampleRate;
+}
+
+void SampleRateConverter::setQuality (Quality newQuality)
+{
+    quality = newQuality;
+}
+
+void SampleRateConverter::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    numChannels = (int) spec.numChannels;
+    inputChannels.resize (spec.numChannels);
+    outputChannels.resize (spec.numChannels);
+
+    resampler.prepare (spec.sampleRate, outputSampleRate, numChannels, quality);
+}
+
+void SampleRateConverter::reset() noexcept
+{
+    resampler.reset();
+}
+
+size_t SampleRateConverter::getMaxNumOutputSamples (size_t numInputSamples) const noexcept
+{
+    return (size_t) resampler.getMaxNumOutputSamples ((int) numInputSamples);
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    Converts the sample rate of a stream of audio, using a PolyphaseResampler.
+
+    Because the output has a different sample rate from the input, this has to be used
+    with a ProcessContextNonReplacing, whose output block is big enough to hold all the
+    samples that the input block produces - use getMaxNumOutputSamples() to find out how
+    big that is. The process() method returns the number of samples it actually wrote,
+    which will vary a little from one block to the next unless the block sizes happen to
+    match the conversion ratio.
+
+    The sample rate in the ProcessSpec passed to prepare() is the input rate. The context's
+    isBypassed flag is ignored, as there's no meaningful way to bypass a rate change.
+
+    @see PolyphaseResampler
+
+    @tags{DSP}
+*/
+class JUCE_API  SampleRateConverter
+{
+public:
+    //==============================================================================
+    using Quality = PolyphaseResampler::Quality;
+
+    /** Creates a converter with the given output sample rate and quality. */
+    explicit SampleRateConverter (double outputSampleRate = 48000.0, Quality quality = Quality::high);
+
+    //==============================================================================
+    /** Changes the output sample rate. This takes effect on the next call to prepare(). */
+    void setOutputSampleRate (double newOutputSampleRate);
+
+    /** Changes the quality. This takes effect on the next call to prepare(). */
+    void setQuality (Quality newQuality);
+
+    /** Returns the output sample rate. */
+    double getOutputSampleRate() const noexcept             { return outputSampleRate; }
+
+    //==============================================================================
+    /** Designs the filters for converting from the spec's sample rate to the output rate. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state of the converter. */
+    void reset() noexcept;
+
+    /** Returns the largest number of samples that process() might write for an input
+        block of the given size.
+    */
+    size_t getMaxNumOutputSamples (size_t numInputSamples) const noexcept;
+
+    /** Returns the delay that the filters introduce, measured in input samples. */
+    double getLatencyInInputSamples() const noexcept        { return resampler.getLatencyInInputSamples(); }
+
+    //==============================================================================
+    /** Converts the whole of the context's input block, and returns the number of samples
+        that were written to the start of its output block.
+    */
+    template <typename ProcessContext>
+    size_t process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, float>,
+                       "The sample-rate converter only handles float samples");
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (context.usesSeparateInputAndOutputBlocks());
+        jassert (inputBlock.getNumChannels() == (size_t) numChannels);
+        jassert (outputBlock.getNumChannels() == (size_t) numChannels);
+        jassert (outputBlock.getNumSamples() >= getMaxNumOutputSamples (inputBlock.getNumSamples()));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            inputChannels[(size_t) ch]  = inputBlock.getChannelPointer ((size_t) ch);
+            outputChannels[(size_t) ch] = outputBlock.getChannelPointer ((size_t) ch);
+        }
+
+        const auto result = resampler.process (inputChannels.data(), (int) inputBlock.getNumSamples(),
+                                               outputChannels.data(), (int) outputBlock.getNumSamples());
+
+        jassert (result.numInputSamplesUsed == (int) inputBlock.getNumSamples());
+        return (size_t) result.numOutputSamplesProduced;
+    }
+
+private:
+    //==============================================================================
+    PolyphaseResampler resampler;
+    double outputSampleRate;
+    Quality quality;
+    int numChannels = 0;
+    std::vector<const float*> inputChannels;
+    std::vector<float*> outputChannels;
+};
+
+} // namespace dsp
+} // namespace juce
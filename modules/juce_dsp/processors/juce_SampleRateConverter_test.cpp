@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SampleRateConverterTest  : public UnitTest
+{
+public:
+    SampleRateConverterTest()
+        : UnitTest ("SampleRateConverter", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("Blocks of any size convert the whole stream");
+        {
+            constexpr int numChannels = 2, numSamples = 10000;
+
+            AudioBuffer<float> input (numChannels, numSamples);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    input.setSample (ch, i, (float) std::sin (0.03 * i + ch));
+
+            PolyphaseResampler reference;
+            reference.prepare (44100.0, 48000.0, numChannels, PolyphaseResampler::Quality::normal);
+            AudioBuffer<float> expected (numChannels, reference.getMaxNumOutputSamples (numSamples));
+            auto numExpected = reference.process (input.getArrayOfReadPointers(), numSamples,
+                                                  expected.getArrayOfWritePointers(), expected.getNumSamples()).numOutputSamplesProduced;
+
+            SampleRateConverter converter (48000.0, SampleRateConverter::Quality::normal);
+            converter.prepare ({ 44100.0, 512, (uint32) numChannels });
+
+            AudioBuffer<float> output (numChannels, numExpected + 1024);
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output);
+            size_t inputPos = 0, outputPos = 0;
+            auto random = getRandom();
+
+            while (inputPos < (size_t) numSamples)
+            {
+                auto numIn = jmin ((size_t) random.nextInt ({ 1, 512 }), (size_t) numSamples - inputPos);
+                auto in = inputBlock.getSubBlock (inputPos, numIn);
+                auto out = outputBlock.getSubBlock (outputPos, converter.getMaxNumOutputSamples (numIn));
+
+                outputPos += converter.process (ProcessContextNonReplacing<float> (in, out));
+                inputPos += numIn;
+            }
+
+            expectEquals ((int) outputPos, numExpected);
+
+            bool matches = true;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < numExpected; ++i)
+                    matches = matches && exactlyEqual (output.getSample (ch, i), expected.getSample (ch, i));
+
+            expect (matches);
+        }
+    }
+};
+
+static SampleRateConverterTest sampleRateConverterTest;
+
+} // namespace dsp
+} // namespace juce
@@ -81,6 +81,16 @@ namespace
                 return;
             }
 
+            const auto currentGeneration = Typeface::getCacheGeneration();
+
+            if (generation != currentGeneration)
+            {
+                // the typefaces may have changed, so anything that's been laid out is stale
+                cache.clear();
+                cacheOrder.clear();
+                generation = currentGeneration;
+            }
+
             const auto cached = [&]
             {
                 const auto iter = cache.find (args);
@@ -118,9 +128,10 @@ namespace
             typename std::list<CachePtr>::const_iterator cachePosition;
         };
 
-        static constexpr size_t cacheSize = 128;
+        static constexpr size_t cacheSize = 1024;
         std::map<ArrangementArgs, CachedGlyphArrangement> cache;
         std::list<typename CachedGlyphArrangement::CachePtr> cacheOrder;
+        uint32 generation = 0;
         CriticalSection lock;
     };
 
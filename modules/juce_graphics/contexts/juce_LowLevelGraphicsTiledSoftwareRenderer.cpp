@@ -0,0 +1,812 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+/*  Gives each band of a tiled render its own view of the target image's pixels.
+    These objects have no listeners, so several threads can write into different parts
+    of the same image at once, while the image itself is only told about the change
+    once, when the renderer locks its pixels for writing.
+*/
+class TiledRendererPixelData  : public ImagePixelData
+{
+public:
+    explicit TiledRendererPixelData (const Image::BitmapData& targetPixels)
+        : ImagePixelData (targetPixels.pixelFormat, targetPixels.width, targetPixels.height),
+          target (targetPixels)
+    {
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this));
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        bitmap.data = target.getPixelPointer (x, y);
+        bitmap.size = target.size - (size_t) (bitmap.data - target.data);
+        bitmap.pixelFormat = target.pixelFormat;
+        bitmap.lineStride = target.lineStride;
+        bitmap.pixelStride = target.pixelStride;
+    }
+
+    ImagePixelData::Ptr clone() override
+    {
+        Image copy (pixelFormat, width, height, false, SoftwareImageType());
+        const Image::BitmapData dest (copy, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+            memcpy (dest.getLinePointer (y), target.getLinePointer (y), (size_t) (width * target.pixelStride));
+
+        return copy.getPixelData();
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    const Image::BitmapData& target;
+
+    JUCE_LEAK_DETECTOR (TiledRendererPixelData)
+};
+
+/*  A transparency layer that only allocates the rows that a band can draw into.
+
+    Each band positions its layers exactly where a LowLevelGraphicsSoftwareRenderer would put
+    them, because moving the origin would change the way that coordinates inside the layer
+    get rounded. The rest of the layer lies outside the band, so it's never touched, and
+    doesn't need any memory.
+*/
+class TiledRendererLayerPixelData  : public ImagePixelData
+{
+public:
+    TiledRendererLayerPixelData (int w, int h, Rectangle<int> areaToAllocate)
+        : ImagePixelData (Image::ARGB, w, h),
+          area (areaToAllocate),
+          lineStride (area.getWidth() * pixelStride)
+    {
+        pixels.calloc ((size_t) lineStride * (size_t) area.getHeight());
+    }
+
+    std::unique_ptr<LowLevelGraphicsContext> createLowLevelContext() override
+    {
+        return std::make_unique<LowLevelGraphicsSoftwareRenderer> (Image (*this), Point<int>(), area);
+    }
+
+    void initialiseBitmapData (Image::BitmapData& bitmap, int x, int y, Image::BitmapData::ReadWriteMode) override
+    {
+        // The origin of the bitmap may be outside the allocated area, so this avoids doing any
+        // pointer arithmetic that could go outside the block
+        auto offset = (pointer_sized_int) (y - area.getY()) * lineStride
+                    + (pointer_sized_int) (x - area.getX()) * pixelStride;
+
+        bitmap.data = reinterpret_cast<uint8*> (reinterpret_cast<pointer_sized_int> (pixels.get()) + offset);
+        bitmap.size = (size_t) jmax ((pointer_sized_int) 0, (pointer_sized_int) lineStride * area.getHeight() - offset);
+        bitmap.pixelFormat = pixelFormat;
+        bitmap.lineStride = lineStride;
+        bitmap.pixelStride = pixelStride;
+    }
+
+    ImagePixelData::Ptr clone() override
+    {
+        Image copy (pixelFormat, width, height, true, SoftwareImageType());
+        Image::BitmapData dest (copy, Image::BitmapData::writeOnly);
+        const Image::BitmapData src (Image (*this), Image::BitmapData::readOnly);
+
+        for (int y = area.getY(); y < area.getBottom(); ++y)
+            memcpy (dest.getPixelPointer (area.getX(), y), src.getPixelPointer (area.getX(), y), (size_t) (area.getWidth() * pixelStride));
+
+        return copy.getPixelData();
+    }
+
+    std::unique_ptr<ImageType> createType() const override    { return std::make_unique<SoftwareImageType>(); }
+
+private:
+    static constexpr int pixelStride = 4;
+    const Rectangle<int> area;
+    const int lineStride;
+    HeapBlock<uint8> pixels;
+
+    JUCE_LEAK_DETECTOR (TiledRendererLayerPixelData)
+};
+
+//==============================================================================
+class LowLevelGraphicsTiledSoftwareRenderer::BandRenderer  : public RenderingHelpers::StackBasedLowLevelGraphicsContext<RenderingHelpers::SoftwareRendererSavedState>
+{
+public:
+    BandRenderer (const Image& im, Point<int> origin, const RectangleList<int>& clip)
+        : StackBasedLowLevelGraphicsContext (new RenderingHelpers::SoftwareRendererSavedState (im, clip, origin))
+    {
+    }
+
+    Rectangle<int> getDeviceSpaceClipBounds() const
+    {
+        return stack->clip != nullptr ? stack->clip->getClipBounds() : Rectangle<int>();
+    }
+
+    // Returns the pixels inside the clip region that something drawn within the given
+    // area could touch, allowing for the anti-aliasing around its edges
+    Rectangle<int> getDeviceSpaceDrawingBounds (Rectangle<float> areaInUserSpace) const
+    {
+        auto& transform = stack->transform;
+        auto clipBounds = getDeviceSpaceClipBounds();
+
+        auto area = transform.isOnlyTranslated ? transform.translated (areaInUserSpace)
+                                               : transform.transformed (areaInUserSpace);
+
+        return area.expanded (1.0f)
+                   .getIntersection (clipBounds.toFloat())
+                   .getSmallestIntegerContainer()
+                   .getIntersection (clipBounds);
+    }
+
+    // This does the same as SoftwareRendererSavedState::beginTransparencyLayer(), but puts
+    // the layer where it would be if the clip region hadn't been divided into bands
+    void beginLayer (float opacity, Rectangle<int> layerBounds)
+    {
+        stack.save();
+
+        auto& state = *stack;
+        Rectangle<int> areaUsed;
+
+        if (state.clip != nullptr)
+        {
+            // The layer is only needed in the rows covered by this band's clip region, but it
+            // must span the whole width, so that it gets composited in exactly the same runs
+            // of pixels as the complete layer would be
+            auto clipBounds = state.clip->getClipBounds();
+            areaUsed = { layerBounds.getX(), clipBounds.getY(), layerBounds.getWidth(), clipBounds.getHeight() };
+
+            state.image = Image (*new TiledRendererLayerPixelData (layerBounds.getWidth(), layerBounds.getHeight(),
+                                                                   areaUsed - layerBounds.getPosition()));
+            state.transparencyLayerAlpha = opacity;
+            state.transform.moveOriginInDeviceSpace (-layerBounds.getPosition());
+            state.cloneClipIfMultiplyReferenced();
+            state.clip->translate (-layerBounds.getPosition());
+        }
+
+        layers.add ({ layerBounds.getPosition(), areaUsed });
+    }
+
+    void endLayer()
+    {
+        auto layerImage = stack->image;
+        auto opacity = stack->transparencyLayerAlpha;
+        auto layer = layers.removeAndReturn (layers.size() - 1);
+
+        stack.restore();
+
+        if (stack->clip != nullptr)
+        {
+            LowLevelGraphicsSoftwareRenderer g (stack->image, {}, layer.areaUsed);
+            g.setOpacity (opacity);
+            g.drawImage (layerImage, AffineTransform::translation (layer.position));
+        }
+    }
+
+private:
+    struct Layer
+    {
+        Point<int> position;
+        Rectangle<int> areaUsed;
+    };
+
+    Array<Layer> layers;
+
+    JUCE_DECLARE_NON_COPYABLE (BandRenderer)
+};
+
+//==============================================================================
+struct TiledRendererThreadPool  : private DeletedAtShutdown
+{
+    TiledRendererThreadPool() = default;
+
+    ~TiledRendererThreadPool() override
+    {
+        clearSingletonInstance();
+    }
+
+    ThreadPool pool { ThreadPoolOptions{}.withThreadName ("Tiled renderer")
+                                         .withNumberOfThreads (jmax (1, SystemStats::getNumCpus() - 1)) };
+
+    JUCE_DECLARE_SINGLETON (TiledRendererThreadPool, false)
+};
+
+JUCE_IMPLEMENT_SINGLETON (TiledRendererThreadPool)
+
+struct TiledRendererBandJob  : public ThreadPoolJob
+{
+    explicit TiledRendererBandJob (std::function<void()> workToDo)
+        : ThreadPoolJob ("Tiled renderer band"), work (std::move (workToDo))
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        work();
+        return jobHasFinished;
+    }
+
+    std::function<void()> work;
+};
+
+//==============================================================================
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto)
+    : LowLevelGraphicsTiledSoftwareRenderer (imageToRenderOnto, {}, imageToRenderOnto.getBounds())
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                                                              const RectangleList<int>& clip,
+                                                                              ThreadPool* threadPoolToUse)
+    : image (imageToRenderOnto),
+      initialOrigin (origin),
+      initialClip (clip),
+      threadPool (threadPoolToUse),
+      clipTracker (std::make_unique<BandRenderer> (imageToRenderOnto, origin, clip))
+{
+}
+
+LowLevelGraphicsTiledSoftwareRenderer::~LowLevelGraphicsTiledSoftwareRenderer()
+{
+    // Any layers that were never ended get discarded, just as they would be by
+    // a LowLevelGraphicsSoftwareRenderer
+    layerPositions.clear();
+    flush();
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::flush()
+{
+    if (! layerPositions.isEmpty() || getNumPendingOperations() == 0)
+        return;
+
+    auto area = initialClip.getBounds().getIntersection (image.getBounds());
+
+    if (! area.isEmpty())
+    {
+        const Image::BitmapData targetPixels (image, Image::BitmapData::readWrite);
+
+        auto& pool = threadPool != nullptr ? *threadPool
+                                           : TiledRendererThreadPool::getInstance()->pool;
+
+        // Using a few bands per thread helps to even out the load when the
+        // drawing is concentrated in one part of the image
+        constexpr int minimumBandHeight = 16, bandsPerThread = 4;
+        const auto numThreads = pool.getNumThreads() + 1;
+        const auto bandHeight = jmax (minimumBandHeight, (area.getHeight() + numThreads * bandsPerThread - 1) / (numThreads * bandsPerThread));
+        const auto numBands = (area.getHeight() + bandHeight - 1) / bandHeight;
+
+        std::atomic<int> nextBand { 0 };
+
+        auto renderRemainingBands = [&]
+        {
+            for (int band; (band = nextBand++) < numBands;)
+            {
+                auto top = area.getY() + band * bandHeight;
+                renderBand (targetPixels, { area.getX(), top, area.getWidth(), jmin (bandHeight, area.getBottom() - top) });
+            }
+        };
+
+        OwnedArray<TiledRendererBandJob> jobs;
+
+        for (int i = jmin (numThreads, numBands); --i > 0;)
+            pool.addJob (jobs.add (new TiledRendererBandJob (renderRemainingBands)), false);
+
+        renderRemainingBands();
+
+        // This removes any jobs that haven't been started yet, and waits for the rest
+        for (auto* job : jobs)
+            pool.removeJob (job, false, -1);
+    }
+
+    operations.erase (std::remove_if (operations.begin(), operations.end(),
+                                      [] (const Operation& op) { return ! op.changesState; }),
+                      operations.end());
+}
+
+int LowLevelGraphicsTiledSoftwareRenderer::getNumPendingOperations() const noexcept
+{
+    return (int) std::count_if (operations.begin(), operations.end(),
+                                [] (const Operation& op) { return ! op.changesState; });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::renderBand (const Image::BitmapData& targetPixels, Rectangle<int> band) const
+{
+    auto bandClip = initialClip;
+    bandClip.clipTo (band);
+
+    if (bandClip.isEmpty())
+        return;
+
+    BandRenderer renderer (Image (*new TiledRendererPixelData (targetPixels)), initialOrigin, bandClip);
+
+    for (auto& op : operations)
+        if (op.changesState || op.area.intersects (band))
+            op.apply (renderer);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addStateChange (std::function<void (BandRenderer&)> fn)
+{
+    operations.push_back ({ std::move (fn), true, {} });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addDrawingOperation (Rectangle<float> areaInUserSpace,
+                                                                 std::function<void (BandRenderer&)> fn)
+{
+    auto area = clipTracker->getDeviceSpaceDrawingBounds (areaInUserSpace);
+
+    if (! area.isEmpty())
+        operations.push_back ({ std::move (fn), false, area });
+}
+
+//==============================================================================
+bool LowLevelGraphicsTiledSoftwareRenderer::isVectorDevice() const
+{
+    return false;
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOrigin (Point<int> o)
+{
+    clipTracker->setOrigin (o);
+    addStateChange ([o] (auto& g) { g.setOrigin (o); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::addTransform (const AffineTransform& t)
+{
+    clipTracker->addTransform (t);
+    addStateChange ([t] (auto& g) { g.addTransform (t); });
+}
+
+float LowLevelGraphicsTiledSoftwareRenderer::getPhysicalPixelScaleFactor()
+{
+    return clipTracker->getPhysicalPixelScaleFactor();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangle (const Rectangle<int>& r)
+{
+    addStateChange ([r] (auto& g) { g.clipToRectangle (r); });
+    return clipTracker->clipToRectangle (r);
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipToRectangleList (const RectangleList<int>& r)
+{
+    addStateChange ([r] (auto& g) { g.clipToRectangleList (r); });
+    return clipTracker->clipToRectangleList (r);
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::excludeClipRectangle (const Rectangle<int>& r)
+{
+    clipTracker->excludeClipRectangle (r);
+    addStateChange ([r] (auto& g) { g.excludeClipRectangle (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToPath (const Path& path, const AffineTransform& t)
+{
+    clipTracker->clipToPath (path, t);
+    addStateChange ([path, t] (auto& g) { g.clipToPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::clipToImageAlpha (const Image& im, const AffineTransform& t)
+{
+    clipTracker->clipToImageAlpha (im, t);
+    addStateChange ([im, t] (auto& g) { g.clipToImageAlpha (im, t); });
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::clipRegionIntersects (const Rectangle<int>& r)
+{
+    return clipTracker->clipRegionIntersects (r);
+}
+
+Rectangle<int> LowLevelGraphicsTiledSoftwareRenderer::getClipBounds() const
+{
+    return clipTracker->getClipBounds();
+}
+
+bool LowLevelGraphicsTiledSoftwareRenderer::isClipEmpty() const
+{
+    return clipTracker->isClipEmpty();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::saveState()
+{
+    clipTracker->saveState();
+    addStateChange ([] (auto& g) { g.saveState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::restoreState()
+{
+    clipTracker->restoreState();
+    currentTypeface = nullptr;
+    addStateChange ([] (auto& g) { g.restoreState(); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::beginTransparencyLayer (float opacity)
+{
+    // The layer covers the whole clip region, and the clip tracker keeps working in the
+    // coordinates of the target image, so the layer's bounds are made relative to any
+    // layer that encloses it
+    auto layerBounds = clipTracker->getDeviceSpaceClipBounds();
+    auto relativeBounds = layerBounds - (layerPositions.isEmpty() ? Point<int>() : layerPositions.getLast());
+    layerPositions.add (layerBounds.getPosition());
+
+    // The clip tracker doesn't need to allocate the layer itself, it only
+    // needs to be able to restore its previous state when the layer ends
+    clipTracker->saveState();
+    addStateChange ([opacity, relativeBounds] (auto& g) { g.beginLayer (opacity, relativeBounds); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::endTransparencyLayer()
+{
+    if (layerPositions.isEmpty())
+    {
+        jassertfalse; // trying to end a layer that was never started!
+        return;
+    }
+
+    layerPositions.removeLast();
+    clipTracker->restoreState();
+    currentTypeface = nullptr;
+    addStateChange ([] (auto& g) { g.endLayer(); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::setFill (const FillType& fill)
+{
+    addStateChange ([fill] (auto& g) { g.setFill (fill); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setOpacity (float opacity)
+{
+    addStateChange ([opacity] (auto& g) { g.setOpacity (opacity); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setInterpolationQuality (Graphics::ResamplingQuality quality)
+{
+    addStateChange ([quality] (auto& g) { g.setInterpolationQuality (quality); });
+}
+
+//==============================================================================
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<int>& r, bool replaceExistingContents)
+{
+    addDrawingOperation (r.toFloat(), [r, replaceExistingContents] (auto& g) { g.fillRect (r, replaceExistingContents); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRect (const Rectangle<float>& r)
+{
+    addDrawingOperation (r, [r] (auto& g) { g.fillRect (r); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillRectList (const RectangleList<float>& list)
+{
+    addDrawingOperation (list.getBounds(), [list] (auto& g) { g.fillRectList (list); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::fillPath (const Path& path, const AffineTransform& t)
+{
+    addDrawingOperation (path.getBoundsTransformed (t), [path, t] (auto& g) { g.fillPath (path, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawImage (const Image& im, const AffineTransform& t)
+{
+    addDrawingOperation (im.getBounds().toFloat().transformedBy (t), [im, t] (auto& g) { g.drawImage (im, t); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawLine (const Line<float>& line)
+{
+    // The line is drawn with a thickness of one pixel
+    const auto area = Rectangle<float> (line.getStart(), line.getEnd()).expanded (0.5f);
+    addDrawingOperation (area, [line] (auto& g) { g.drawLine (line); });
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::setFont (const Font& newFont)
+{
+    clipTracker->setFont (newFont);
+    currentTypeface = nullptr;
+    addStateChange ([newFont] (auto& g) { g.setFont (newFont); });
+}
+
+const Font& LowLevelGraphicsTiledSoftwareRenderer::getFont()
+{
+    return clipTracker->getFont();
+}
+
+void LowLevelGraphicsTiledSoftwareRenderer::drawGlyph (int glyphNumber, const AffineTransform& t)
+{
+    // Typefaces load their glyph outlines lazily, which isn't safe to do from several
+    // threads at once, so this makes sure that each glyph is loaded before the bands
+    // get rendered. The outline's bounds are kept, to find the area that the glyph covers.
+    if (currentTypeface == nullptr)
+    {
+        currentTypeface = getFont().getTypefacePtr();
+        typefacesUsed.addIfNotAlreadyThere (currentTypeface);
+    }
+
+    if (currentTypeface == nullptr)
+        return;
+
+    auto iter = glyphBounds.find ({ currentTypeface.get(), glyphNumber });
+
+    if (iter == glyphBounds.end())
+    {
+        Path outline;
+        currentTypeface->getOutlineForGlyph (glyphNumber, outline);
+
+        // Hinting can move the edges of a glyph slightly away from its outline
+        iter = glyphBounds.emplace (std::make_pair (currentTypeface.get(), glyphNumber),
+                                    outline.getBounds().expanded (0.1f)).first;
+    }
+
+    const auto& font = getFont();
+    const auto area = iter->second.transformedBy (AffineTransform::scale (font.getHeight() * font.getHorizontalScale(), font.getHeight())
+                                                                  .followedBy (t));
+
+    addDrawingOperation (area, [glyphNumber, t] (auto& g) { g.drawGlyph (glyphNumber, t); });
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class LowLevelGraphicsTiledSoftwareRendererTests  : public UnitTest
+{
+public:
+    LowLevelGraphicsTiledSoftwareRendererTests()
+        : UnitTest ("LowLevelGraphicsTiledSoftwareRenderer", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (3);
+
+        beginTest ("Output matches LowLevelGraphicsSoftwareRenderer");
+        {
+            for (auto format : { Image::ARGB, Image::RGB, Image::SingleChannel })
+            {
+                Image expected (format, 317, 251, true, SoftwareImageType());
+                Image actual   (format, 317, 251, true, SoftwareImageType());
+
+                {
+                    LowLevelGraphicsSoftwareRenderer context (expected);
+                    Graphics g (context);
+                    drawScene (g);
+                }
+
+                {
+                    LowLevelGraphicsTiledSoftwareRenderer context (actual, {}, actual.getBounds(), &pool);
+                    Graphics g (context);
+                    drawScene (g);
+                }
+
+                expect (imagesMatch (expected, actual));
+            }
+        }
+
+        beginTest ("Origin and initial clip region");
+        {
+            RectangleList<int> clip ({ 5, 3, 120, 200 });
+            clip.add ({ 150, 40, 160, 90 });
+            const Point<int> origin (13, -7);
+
+            Image expected (Image::ARGB, 317, 251, true, SoftwareImageType());
+            Image actual   (Image::ARGB, 317, 251, true, SoftwareImageType());
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected, origin, clip);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, origin, clip, &pool);
+                Graphics g (context);
+                drawScene (g);
+            }
+
+            expect (imagesMatch (expected, actual));
+        }
+
+        beginTest ("Clip queries are answered while recording");
+        {
+            Image image (Image::ARGB, 200, 100, true, SoftwareImageType());
+            LowLevelGraphicsTiledSoftwareRenderer context (image, { 10, 20 }, Rectangle<int> (10, 20, 50, 40), &pool);
+
+            expect (context.getClipBounds() == Rectangle<int> (0, 0, 50, 40));
+
+            context.saveState();
+            expect (context.clipToRectangle ({ 10, 10, 20, 20 }));
+            expect (context.getClipBounds() == Rectangle<int> (10, 10, 20, 20));
+            expect (! context.clipRegionIntersects ({ 40, 40, 5, 5 }));
+            expect (! context.clipToRectangle ({ 100, 100, 5, 5 }));
+            expect (context.isClipEmpty());
+            context.restoreState();
+
+            expect (context.getClipBounds() == Rectangle<int> (0, 0, 50, 40));
+        }
+
+        beginTest ("Drawing state is kept after flushing");
+        {
+            Image expected (Image::ARGB, 160, 300, true, SoftwareImageType());
+            Image actual   (Image::ARGB, 160, 300, true, SoftwareImageType());
+
+            const auto drawInTwoParts = [] (LowLevelGraphicsContext& context, std::function<void()> betweenParts)
+            {
+                Graphics g (context);
+                g.setOrigin ({ 7, 11 });
+                g.reduceClipRegion (0, 0, 120, 250);
+                g.setColour (Colours::red.withAlpha (0.6f));
+                g.fillEllipse (5.0f, 5.0f, 150.0f, 80.0f);
+
+                betweenParts();
+
+                g.fillRect (Rectangle<float> (10.5f, 100.25f, 130.0f, 180.0f));
+            };
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected);
+                drawInTwoParts (context, [] {});
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual, {}, actual.getBounds(), &pool);
+
+                drawInTwoParts (context, [&]
+                {
+                    expectEquals (context.getNumPendingOperations(), 1);
+                    context.flush();
+                    expectEquals (context.getNumPendingOperations(), 0);
+                    expect (imagesMatch (expected, actual, { 0, 0, 160, 90 }));
+                });
+            }
+
+            expect (imagesMatch (expected, actual));
+        }
+
+        beginTest ("Flushing inside a transparency layer is deferred");
+        {
+            Image expected (Image::ARGB, 100, 100, true, SoftwareImageType());
+            Image actual   (Image::ARGB, 100, 100, true, SoftwareImageType());
+
+            const auto drawLayer = [] (LowLevelGraphicsContext& context, std::function<void()> insideLayer)
+            {
+                Graphics g (context);
+                g.beginTransparencyLayer (0.5f);
+                g.fillAll (Colours::blue);
+                insideLayer();
+                g.endTransparencyLayer();
+            };
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected);
+                drawLayer (context, [] {});
+            }
+
+            LowLevelGraphicsTiledSoftwareRenderer context (actual, {}, actual.getBounds(), &pool);
+            drawLayer (context, [&] { context.flush(); });
+
+            expectEquals (context.getNumPendingOperations(), 1);
+            context.flush();
+            expect (imagesMatch (expected, actual));
+        }
+
+        beginTest ("Shared thread pool");
+        {
+            Image expected (Image::ARGB, 640, 480, true, SoftwareImageType());
+            Image actual   (Image::ARGB, 640, 480, true, SoftwareImageType());
+
+            {
+                LowLevelGraphicsSoftwareRenderer context (expected);
+                Graphics g (context);
+                g.addTransform (AffineTransform::scale (2.0f));
+                drawScene (g);
+            }
+
+            {
+                LowLevelGraphicsTiledSoftwareRenderer context (actual);
+                Graphics g (context);
+                g.addTransform (AffineTransform::scale (2.0f));
+                drawScene (g);
+            }
+
+            expect (imagesMatch (expected, actual));
+        }
+    }
+
+private:
+    static Image createCheckerboard()
+    {
+        Image image (Image::ARGB, 16, 16, true, SoftwareImageType());
+
+        for (int y = 0; y < image.getHeight(); ++y)
+            for (int x = 0; x < image.getWidth(); ++x)
+                image.setPixelAt (x, y, ((x / 4 + y / 4) % 2 == 0) ? Colours::purple : Colours::lightblue.withAlpha (0.4f));
+
+        return image;
+    }
+
+    static void drawScene (Graphics& g)
+    {
+        const auto checkerboard = createCheckerboard();
+
+        g.fillAll (Colours::white.withAlpha (0.8f));
+
+        ColourGradient gradient (Colours::red, 10.0f, 10.0f, Colours::blue.withAlpha (0.5f), 300.0f, 240.0f, true);
+        gradient.addColour (0.4, Colours::green);
+        g.setGradientFill (gradient);
+        g.fillEllipse (20.5f, 15.25f, 260.0f, 200.0f);
+
+        Path star;
+        star.addStar ({ 150.0f, 120.0f }, 7, 40.0f, 110.0f, 0.3f);
+        g.setColour (Colours::orange.withAlpha (0.7f));
+        g.strokePath (star, PathStrokeType (3.5f), AffineTransform::rotation (0.2f, 150.0f, 120.0f));
+
+        {
+            Graphics::ScopedSaveState state (g);
+            g.reduceClipRegion (star);
+            g.excludeClipRegion ({ 100, 100, 40, 30 });
+            g.setTiledImageFill (checkerboard, 3, 5, 0.6f);
+            g.fillRect (0, 0, 317, 251);
+        }
+
+        g.beginTransparencyLayer (0.5f);
+        g.setColour (Colours::darkgreen);
+        g.fillRoundedRectangle (40.0f, 160.0f, 230.0f, 70.0f, 12.0f);
+        g.setColour (Colours::yellow);
+        g.drawLine (0.0f, 0.0f, 317.0f, 251.0f, 2.5f);
+        g.endTransparencyLayer();
+
+        g.drawImageTransformed (checkerboard, AffineTransform::rotation (0.7f).scaled (2.3f).translated (120.0f, 30.0f));
+        g.setImageResamplingQuality (Graphics::lowResamplingQuality);
+        g.drawImage (checkerboard, { 230.0f, 150.0f, 70.0f, 90.0f }, RectanglePlacement::stretchToFit);
+
+        g.setColour (Colours::black);
+        g.setFont (17.0f);
+        g.drawText ("Tiled rendering", 10, 10, 200, 30, Justification::centredLeft);
+        g.addTransform (AffineTransform::rotation (0.3f, 150.0f, 120.0f));
+        g.drawText ("Rotated text", 60, 100, 200, 40, Justification::centred);
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b, Rectangle<int> area = { 0, 0, 1 << 16, 1 << 16 })
+    {
+        area = area.getIntersection (a.getBounds());
+
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = area.getY(); y < area.getBottom(); ++y)
+            for (int x = area.getX(); x < area.getRight(); ++x)
+                if (dataA.getPixelColour (x, y) != dataB.getPixelColour (x, y))
+                    return false;
+
+        return true;
+    }
+};
+
+static LowLevelGraphicsTiledSoftwareRendererTests lowLevelGraphicsTiledSoftwareRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A software renderer that records its drawing operations into a display list, and
+    then rasterises them onto an image using several threads at once.
+
+    Instead of drawing each operation as it arrives, this context stores it, and when
+    flush() is called (or the context is deleted), the area being drawn is divided into
+    horizontal bands that are rendered in parallel on a ThreadPool. Each band replays the
+    operations through its own LowLevelGraphicsSoftwareRenderer, clipped to that band, so
+    the finished image is identical, pixel-for-pixel, to one drawn directly with a
+    LowLevelGraphicsSoftwareRenderer.
+
+    The area that each drawing operation can touch is worked out when it's recorded, and
+    bands skip any operations that don't reach them. An operation that covers several bands
+    is still drawn separately by each of them, so, for example, a large path gets flattened
+    once for every band that it crosses, although each band only rasterises its own rows.
+
+    Clip and font queries are answered as the operations are recorded, so code that draws
+    via a Graphics object won't notice that the rendering has been deferred. But you mustn't
+    read from or draw onto the target image by any other means until flush() has returned,
+    and any images that get drawn must not be modified before then either.
+
+    User code is not supposed to create instances of this class directly - do all your
+    rendering via the Graphics class instead.
+
+    @see LowLevelGraphicsSoftwareRenderer
+    @tags{Graphics}
+*/
+class JUCE_API  LowLevelGraphicsTiledSoftwareRenderer    : public LowLevelGraphicsContext
+{
+public:
+    //==============================================================================
+    /** Creates a context to render into an image. */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto);
+
+    /** Creates a context to render into a clipped subsection of an image.
+
+        If threadPoolToUse is nullptr, a pool that's shared by all instances of this class
+        will be used, otherwise the pool that you supply must outlive this object.
+    */
+    LowLevelGraphicsTiledSoftwareRenderer (const Image& imageToRenderOnto, Point<int> origin,
+                                           const RectangleList<int>& initialClip,
+                                           ThreadPool* threadPoolToUse = nullptr);
+
+    /** Destructor. This will flush any operations that haven't yet been drawn. */
+    ~LowLevelGraphicsTiledSoftwareRenderer() override;
+
+    //==============================================================================
+    /** Draws all the operations that have been recorded so far onto the target image.
+
+        This blocks until the drawing is complete. Any state that has been set up, such
+        as the current clip region, transform and fill, remains in place for the operations
+        that follow.
+
+        A transparency layer can only be composited once it has ended, so if this is called
+        while a layer is active, nothing is drawn, and the operations are kept until the next
+        flush after the layer has ended.
+    */
+    void flush();
+
+    /** Returns the number of drawing operations that are waiting to be flushed. */
+    int getNumPendingOperations() const noexcept;
+
+    //==============================================================================
+    bool isVectorDevice() const override;
+    void setOrigin (Point<int>) override;
+    void addTransform (const AffineTransform&) override;
+    float getPhysicalPixelScaleFactor() override;
+    bool clipToRectangle (const Rectangle<int>&) override;
+    bool clipToRectangleList (const RectangleList<int>&) override;
+    void excludeClipRectangle (const Rectangle<int>&) override;
+    void clipToPath (const Path&, const AffineTransform&) override;
+    void clipToImageAlpha (const Image&, const AffineTransform&) override;
+    bool clipRegionIntersects (const Rectangle<int>&) override;
+    Rectangle<int> getClipBounds() const override;
+    bool isClipEmpty() const override;
+    void saveState() override;
+    void restoreState() override;
+    void beginTransparencyLayer (float opacity) override;
+    void endTransparencyLayer() override;
+    void setFill (const FillType&) override;
+    void setOpacity (float) override;
+    void setInterpolationQuality (Graphics::ResamplingQuality) override;
+    void fillRect (const Rectangle<int>&, bool replaceExistingContents) override;
+    void fillRect (const Rectangle<float>&) override;
+    void fillRectList (const RectangleList<float>&) override;
+    void fillPath (const Path&, const AffineTransform&) override;
+    void drawImage (const Image&, const AffineTransform&) override;
+    void drawLine (const Line<float>&) override;
+    void setFont (const Font&) override;
+    const Font& getFont() override;
+    void drawGlyph (int glyphNumber, const AffineTransform&) override;
+
+private:
+    //==============================================================================
+    class BandRenderer;
+
+    struct Operation
+    {
+        std::function<void (BandRenderer&)> apply;
+        bool changesState;
+        Rectangle<int> area;
+    };
+
+    Image image;
+    Point<int> initialOrigin;
+    RectangleList<int> initialClip;
+    ThreadPool* threadPool;
+    std::unique_ptr<BandRenderer> clipTracker;
+    std::vector<Operation> operations;
+    Array<Point<int>> layerPositions;
+    Typeface::Ptr currentTypeface;
+    ReferenceCountedArray<Typeface> typefacesUsed;
+    std::map<std::pair<Typeface*, int>, Rectangle<float>> glyphBounds;
+
+    void addStateChange (std::function<void (BandRenderer&)>);
+    void addDrawingOperation (Rectangle<float> areaInUserSpace, std::function<void (BandRenderer&)>);
+    void renderBand (const Image::BitmapData&, Rectangle<int>) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LowLevelGraphicsTiledSoftwareRenderer)
+};
+
+} // namespace juce
@@ -165,6 +165,107 @@ private:
 
 JUCE_IMPLEMENT_SINGLETON (TypefaceCache)
 
+//==============================================================================
+/*  Keeps hold of the unscaled glyph positions that typefaces have recently returned,
+    so that strings which are measured or laid out over and over again (e.g. the labels
+    in a list or table that's being repainted) don't have to be re-shaped every time.
+*/
+class GlyphPositionCache  : private DeletedAtShutdown
+{
+public:
+    GlyphPositionCache() = default;
+
+    ~GlyphPositionCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (GlyphPositionCache, false)
+
+    void getGlyphPositions (Typeface& typeface, const String& text, Array<int>& glyphs, Array<float>& xOffsets)
+    {
+        const ScopedTryLock stl (lock);
+
+        if (! stl.isLocked() || text.getNumBytesAsUTF8() > maxTextLength)
+        {
+            typeface.getGlyphPositions (text, glyphs, xOffsets);
+            return;
+        }
+
+        const Key key { &typeface, text };
+        auto iter = cache.find (key);
+
+        if (iter == cache.end())
+        {
+            CachedPositions positions;
+            positions.typeface = &typeface;
+            typeface.getGlyphPositions (text, positions.glyphs, positions.xOffsets);
+
+            cacheOrder.push_front (key);
+            positions.cachePosition = cacheOrder.begin();
+            iter = cache.emplace (key, std::move (positions)).first;
+
+            while (cache.size() > cacheSize)
+            {
+                cache.erase (cacheOrder.back());
+                cacheOrder.pop_back();
+            }
+        }
+        else if (iter->second.cachePosition != cacheOrder.begin())
+        {
+            cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second.cachePosition);
+        }
+
+        glyphs.addArray (iter->second.glyphs);
+        xOffsets.addArray (iter->second.xOffsets);
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+
+        cache.clear();
+        cacheOrder.clear();
+    }
+
+private:
+    struct Key
+    {
+        bool operator== (const Key& other) const noexcept    { return typeface == other.typeface && text == other.text; }
+
+        Typeface* typeface;
+        String text;
+    };
+
+    struct KeyHash
+    {
+        size_t operator() (const Key& key) const noexcept
+        {
+            return key.text.hash() ^ std::hash<Typeface*>() (key.typeface);
+        }
+    };
+
+    struct CachedPositions
+    {
+        Typeface::Ptr typeface; // keeps the typeface alive, so that its address can't be re-used
+        Array<int> glyphs;
+        Array<float> xOffsets;
+        std::list<Key>::const_iterator cachePosition;
+    };
+
+    static constexpr size_t cacheSize = 2048;
+    static constexpr size_t maxTextLength = 256;
+
+    std::unordered_map<Key, CachedPositions, KeyHash> cache;
+    std::list<Key> cacheOrder;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphPositionCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (GlyphPositionCache)
+
+//==============================================================================
 void Typeface::setTypefaceCacheSize (int numFontsToCache)
 {
     TypefaceCache::getInstance()->setSize (numFontsToCache);
@@ -172,9 +273,25 @@ void Typeface::setTypefaceCacheSize (int numFontsToCache)
 
 void (*clearOpenGLGlyphCache)() = nullptr;
 
+static std::atomic<uint32> typefaceCacheGeneration { 0 };
+
+uint32 Typeface::getCacheGeneration() noexcept
+{
+    return typefaceCacheGeneration.load();
+}
+
+static void clearCachedTextLayouts()
+{
+    if (auto* cache = GlyphPositionCache::getInstanceWithoutCreating())
+        cache->clear();
+
+    ++typefaceCacheGeneration;
+}
+
 void Typeface::clearTypefaceCache()
 {
     TypefaceCache::getInstance()->clear();
+    clearCachedTextLayouts();
 
     RenderingHelpers::SoftwareRendererSavedState::clearGlyphCache();
 
@@ -525,6 +642,7 @@ const String& Font::getFallbackFontName()
 void Font::setFallbackFontName (const String& name)
 {
     FontValues::fallbackFont = name;
+    clearCachedTextLayouts();
 
    #if JUCE_MAC || JUCE_IOS
     jassertfalse; // Note that use of a fallback font isn't currently implemented in OSX..
@@ -539,6 +657,7 @@ const String& Font::getFallbackFontStyle()
 void Font::setFallbackFontStyle (const String& style)
 {
     FontValues::fallbackFontStyle = style;
+    clearCachedTextLayouts();
 
    #if JUCE_MAC || JUCE_IOS
     jassertfalse; // Note that use of a fallback font isn't currently implemented in OSX..
@@ -756,7 +875,7 @@ float Font::getStringWidthFloat (const String& text) const
 
 void Font::getGlyphPositions (const String& text, Array<int>& glyphs, Array<float>& xOffsets) const
 {
-    getTypefacePtr()->getGlyphPositions (text, glyphs, xOffsets);
+    GlyphPositionCache::getInstance()->getGlyphPositions (*getTypefacePtr(), text, glyphs, xOffsets);
 
     if (auto num = xOffsets.size())
     {
@@ -240,6 +240,140 @@ void TextLayout::draw (Graphics& g, Rectangle<float> area) const
     context.restoreState();
 }
 
+//==============================================================================
+/*  Holds on to the most recently created layouts, so that laying out the same attributed
+    strings over and over again (e.g. when repainting lists of labels) doesn't have to
+    re-measure and re-wrap all the text each time.
+*/
+class TextLayoutCache  : private DeletedAtShutdown
+{
+public:
+    TextLayoutCache() = default;
+
+    ~TextLayoutCache() override
+    {
+        clearSingletonInstance();
+    }
+
+    JUCE_DECLARE_SINGLETON (TextLayoutCache, false)
+
+    template <typename CreateLayout>
+    void createLayout (TextLayout& layout, const AttributedString& text,
+                       float maxWidth, float maxHeight, CreateLayout&& create)
+    {
+        const ScopedTryLock stl (lock);
+
+        if (! stl.isLocked() || text.getText().getNumBytesAsUTF8() > maxTextLength)
+        {
+            create();
+            return;
+        }
+
+        const auto currentGeneration = Typeface::getCacheGeneration();
+
+        if (generation != currentGeneration)
+        {
+            // the typefaces may have changed, so anything that's been laid out is stale
+            index.clear();
+            cacheOrder.clear();
+            generation = currentGeneration;
+        }
+
+        const auto hash = getHash (text, maxWidth, maxHeight);
+        const auto range = index.equal_range (hash);
+
+        for (auto iter = range.first; iter != range.second; ++iter)
+        {
+            auto& cached = *iter->second;
+
+            if (exactlyEqual (cached.maxWidth, maxWidth)
+                 && exactlyEqual (cached.maxHeight, maxHeight)
+                 && areIdentical (cached.text, text))
+            {
+                if (iter->second != cacheOrder.begin())
+                    cacheOrder.splice (cacheOrder.begin(), cacheOrder, iter->second);
+
+                layout = cached.layout;
+                return;
+            }
+        }
+
+        create();
+
+        cacheOrder.push_front ({ hash, text, maxWidth, maxHeight, layout });
+        index.emplace (hash, cacheOrder.begin());
+
+        while (cacheOrder.size() > cacheSize)
+        {
+            const auto oldest = std::prev (cacheOrder.end());
+            const auto oldestRange = index.equal_range (oldest->hash);
+
+            for (auto iter = oldestRange.first; iter != oldestRange.second; ++iter)
+            {
+                if (iter->second == oldest)
+                {
+                    index.erase (iter);
+                    break;
+                }
+            }
+
+            cacheOrder.pop_back();
+        }
+    }
+
+private:
+    struct CachedLayout
+    {
+        size_t hash;
+        AttributedString text;
+        float maxWidth, maxHeight;
+        TextLayout layout;
+    };
+
+    static size_t getHash (const AttributedString& text, float maxWidth, float maxHeight)
+    {
+        return text.getText().hash()
+                ^ ((size_t) text.getNumAttributes() * 31u)
+                ^ (std::hash<float>() (maxWidth) * 7u)
+                ^ (std::hash<float>() (maxHeight) * 13u);
+    }
+
+    static bool areIdentical (const AttributedString& a, const AttributedString& b)
+    {
+        if (a.getText() != b.getText()
+             || a.getJustification() != b.getJustification()
+             || a.getWordWrap() != b.getWordWrap()
+             || a.getReadingDirection() != b.getReadingDirection()
+             || ! exactlyEqual (a.getLineSpacing(), b.getLineSpacing())
+             || a.getNumAttributes() != b.getNumAttributes())
+            return false;
+
+        for (int i = 0; i < a.getNumAttributes(); ++i)
+        {
+            auto& attA = a.getAttribute (i);
+            auto& attB = b.getAttribute (i);
+
+            if (attA.range != attB.range || attA.colour != attB.colour || attA.font != attB.font)
+                return false;
+        }
+
+        return true;
+    }
+
+    static constexpr size_t cacheSize = 512;
+    static constexpr size_t maxTextLength = 1024;
+
+    std::list<CachedLayout> cacheOrder; // most recently used first
+    std::unordered_multimap<size_t, std::list<CachedLayout>::iterator> index;
+    uint32 generation = 0;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TextLayoutCache)
+};
+
+JUCE_IMPLEMENT_SINGLETON (TextLayoutCache)
+
+//==============================================================================
 void TextLayout::createLayout (const AttributedString& text, float maxWidth)
 {
     createLayout (text, maxWidth, 1.0e7f);
@@ -247,15 +381,18 @@ void TextLayout::createLayout (const AttributedString& text, float maxWidth)
 
 void TextLayout::createLayout (const AttributedString& text, float maxWidth, float maxHeight)
 {
-    lines.clear();
-    width = maxWidth;
-    height = maxHeight;
-    justification = text.getJustification();
+    TextLayoutCache::getInstance()->createLayout (*this, text, maxWidth, maxHeight, [&]
+    {
+        lines.clear();
+        width = maxWidth;
+        height = maxHeight;
+        justification = text.getJustification();
 
-    if (! createNativeLayout (text))
-        createStandardLayout (text);
+        if (! createNativeLayout (text))
+            createStandardLayout (text);
 
-    recalculateSize();
+        recalculateSize();
+    });
 }
 
 void TextLayout::createLayoutWithBalancedLineLengths (const AttributedString& text, float maxWidth)
@@ -596,4 +733,117 @@ void TextLayout::recalculateSize()
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TextLayoutCacheTests  : public UnitTest
+{
+public:
+    TextLayoutCacheTests()
+        : UnitTest ("TextLayout caching", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        AttributedString text;
+        text.append ("The quick brown fox ", Font (15.0f), Colours::red);
+        text.append ("jumps over the lazy dog", Font (18.0f, Font::bold), Colours::blue);
+
+        beginTest ("Repeated layouts are identical");
+        {
+            TextLayout first, second;
+            first.createLayout (text, 120.0f);
+            second.createLayout (text, 120.0f);
+
+            expect (first.getNumLines() > 1);
+            expect (areEqual (first, second));
+        }
+
+        beginTest ("Different attributes or sizes aren't confused with each other");
+        {
+            TextLayout narrow, wide;
+            narrow.createLayout (text, 120.0f);
+            wide.createLayout (text, 1000.0f);
+            expect (wide.getNumLines() < narrow.getNumLines());
+
+            auto recoloured = text;
+            recoloured.setColour (Colours::green);
+
+            TextLayout layout;
+            layout.createLayout (recoloured, 120.0f);
+            expect (layout.getLine (0).runs.getFirst()->colour == Colours::green);
+        }
+
+        beginTest ("Layouts are unchanged after the typeface cache is cleared");
+        {
+            TextLayout before, after;
+            before.createLayout (text, 120.0f);
+            Typeface::clearTypefaceCache();
+            after.createLayout (text, 120.0f);
+
+            expect (areEqual (before, after));
+        }
+
+        beginTest ("Cached glyph positions match the typeface's");
+        {
+            const Font font (14.0f);
+            const String s ("Track 1 - some plugin name here");
+
+            Array<int> expectedGlyphs;
+            Array<float> expectedOffsets;
+            font.getTypefacePtr()->getGlyphPositions (s, expectedGlyphs, expectedOffsets);
+
+            for (int i = 0; i < 2; ++i)
+            {
+                Array<int> glyphs;
+                Array<float> offsets;
+                font.getGlyphPositions (s, glyphs, offsets);
+
+                expect (glyphs == expectedGlyphs);
+                expectEquals (offsets.size(), expectedOffsets.size());
+
+                for (int j = 0; j < offsets.size(); ++j)
+                    expectEquals (offsets[j], expectedOffsets[j] * font.getHeight());
+            }
+        }
+    }
+
+private:
+    static bool areEqual (const TextLayout& a, const TextLayout& b)
+    {
+        if (a.getNumLines() != b.getNumLines() || ! exactlyEqual (a.getHeight(), b.getHeight()) || ! exactlyEqual (a.getWidth(), b.getWidth()))
+            return false;
+
+        for (int i = 0; i < a.getNumLines(); ++i)
+        {
+            auto& lineA = a.getLine (i);
+            auto& lineB = b.getLine (i);
+
+            if (lineA.lineOrigin != lineB.lineOrigin || lineA.runs.size() != lineB.runs.size())
+                return false;
+
+            for (int r = 0; r < lineA.runs.size(); ++r)
+            {
+                auto& runA = *lineA.runs.getUnchecked (r);
+                auto& runB = *lineB.runs.getUnchecked (r);
+
+                if (runA.font != runB.font || runA.colour != runB.colour || runA.glyphs.size() != runB.glyphs.size())
+                    return false;
+
+                for (int g = 0; g < runA.glyphs.size(); ++g)
+                    if (runA.glyphs.getReference (g).glyphCode != runB.glyphs.getReference (g).glyphCode
+                         || runA.glyphs.getReference (g).anchor != runB.glyphs.getReference (g).anchor)
+                        return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+static TextLayoutCacheTests textLayoutCacheTests;
+
+#endif
+
 } // namespace juce
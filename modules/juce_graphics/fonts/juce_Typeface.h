@@ -131,6 +131,14 @@ public:
     /** Clears any fonts that are currently cached in memory. */
     static void clearTypefaceCache();
 
+    /** Returns a number that changes whenever the typefaces that fonts map onto may have
+        changed, e.g. when clearTypefaceCache() is called or the fallback font is changed.
+
+        If you cache text that has been laid out, you can compare this with the value it
+        had when you laid it out to find out whether the cached layout is stale.
+    */
+    static uint32 getCacheGeneration() noexcept;
+
     /** On some platforms, this allows a specific path to be scanned.
         On macOS you can load .ttf and .otf files, otherwise this is only available when using FreeType.
     */
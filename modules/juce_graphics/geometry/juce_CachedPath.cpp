@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace CachedPathHelpers
+{
+    /*  Splits a transform into the part that changes the size of the path, which the
+        outlines need to be created with, and the part that just moves the result into
+        place, which can be applied each time they're drawn.
+    */
+    static std::pair<AffineTransform, AffineTransform> splitTransform (const AffineTransform& t)
+    {
+        // a rotation with a uniform scale doesn't change the shape of a stroke, so only
+        // the scale needs to be baked into the outline
+        if (approximatelyEqual (t.mat00, t.mat11) && approximatelyEqual (t.mat01, -t.mat10))
+        {
+            const auto scale = std::sqrt (t.mat00 * t.mat00 + t.mat10 * t.mat10);
+
+            if (scale > 0.0f)
+                return { AffineTransform::scale (scale), AffineTransform::scale (1.0f / scale).followedBy (t) };
+        }
+
+        return { AffineTransform (t.mat00, t.mat01, 0.0f, t.mat10, t.mat11, 0.0f),
+                 AffineTransform::translation (t.getTranslationX(), t.getTranslationY()) };
+    }
+
+    static Path flatten (const Path& source, const AffineTransform& transform, float extraAccuracy)
+    {
+        Path result;
+        result.setUsingNonZeroWinding (source.isUsingNonZeroWinding());
+        bool needsNewSubPath = true;
+
+        for (PathFlatteningIterator i (source, transform, Path::defaultToleranceForMeasurement / extraAccuracy); i.next();)
+        {
+            if (needsNewSubPath || result.getCurrentPosition() != Point<float> (i.x1, i.y1))
+                result.startNewSubPath (i.x1, i.y1);
+
+            result.lineTo (i.x2, i.y2);
+            needsNewSubPath = i.closesSubPath;
+
+            if (needsNewSubPath)
+                result.closeSubPath();
+        }
+
+        return result;
+    }
+}
+
+//==============================================================================
+CachedPath::CachedPath (const Path& p)  : path (p) {}
+CachedPath::CachedPath (Path&& p)       : path (std::move (p)) {}
+
+void CachedPath::setPath (const Path& newPath)
+{
+    path = newPath;
+    clearCache();
+}
+
+void CachedPath::setPath (Path&& newPath)
+{
+    path = std::move (newPath);
+    clearCache();
+}
+
+void CachedPath::clearCache()
+{
+    flattened.reset();
+    strokes.clear();
+}
+
+//==============================================================================
+void CachedPath::fill (Graphics& g, const AffineTransform& transform) const
+{
+    if (path.isEmpty())
+        return;
+
+    const auto split = CachedPathHelpers::splitTransform (transform);
+    const auto extraAccuracy = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    if (! (flattened.has_value()
+            && flattened->transform == split.first
+            && exactlyEqual (flattened->extraAccuracy, extraAccuracy)))
+    {
+        auto outline = CachedPathHelpers::flatten (path, split.first, extraAccuracy);
+        auto bounds = outline.getBounds();
+        flattened = CachedOutline { split.first, extraAccuracy, std::move (outline), bounds };
+    }
+
+    draw (g, *flattened, split.second);
+}
+
+void CachedPath::stroke (Graphics& g, const PathStrokeType& strokeType, const AffineTransform& transform) const
+{
+    if (path.isEmpty())
+        return;
+
+    const auto split = CachedPathHelpers::splitTransform (transform);
+    const auto extraAccuracy = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    auto cached = std::find_if (strokes.begin(), strokes.end(), [&] (const CachedStroke& s)
+    {
+        return s.strokeType == strokeType
+                && s.transform == split.first
+                && exactlyEqual (s.extraAccuracy, extraAccuracy);
+    });
+
+    if (cached == strokes.end())
+    {
+        Path outline;
+        strokeType.createStrokedPath (outline, path, split.first, extraAccuracy);
+        auto bounds = outline.getBounds();
+
+        if (strokes.size() >= maxCachedStrokes)
+            strokes.pop_back();
+
+        strokes.insert (strokes.begin(), CachedStroke { { split.first, extraAccuracy, std::move (outline), bounds }, strokeType });
+    }
+    else if (cached != strokes.begin())
+    {
+        // keep the most recently used strokes at the front, so the stalest one gets dropped
+        std::rotate (strokes.begin(), cached, std::next (cached));
+    }
+
+    draw (g, strokes.front(), split.second);
+}
+
+void CachedPath::draw (Graphics& g, const CachedOutline& cached, const AffineTransform& transform) const
+{
+    // no need to go any further if the shape doesn't touch the area being painted
+    if (g.clipRegionIntersects (cached.bounds.transformedBy (transform).getSmallestIntegerContainer()))
+        g.fillPath (cached.outline, transform);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class CachedPathTests  : public UnitTest
+{
+public:
+    CachedPathTests()
+        : UnitTest ("CachedPath", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        Path knob;
+        knob.addCentredArc (0.0f, 0.0f, 40.0f, 30.0f, 0.3f, -2.4f, 2.4f, true);
+        knob.lineTo (0.0f, 0.0f);
+        knob.addStar ({ 10.0f, -5.0f }, 5, 8.0f, 20.0f);
+
+        const PathStrokeType strokeType (3.0f, PathStrokeType::curved, PathStrokeType::rounded);
+        const auto transforms = { AffineTransform(),
+                                  AffineTransform::translation (50.0f, 60.0f),
+                                  AffineTransform::rotation (0.7f).translated (50.0f, 50.0f),
+                                  AffineTransform::scale (1.5f).rotated (-1.2f).translated (60.0f, 40.0f),
+                                  AffineTransform::scale (1.5f, 0.8f).translated (50.0f, 50.0f) };
+
+        beginTest ("Strokes match Graphics::strokePath()");
+        {
+            CachedPath cached (knob);
+
+            for (auto& t : transforms)
+            {
+                // draw everything twice so that the second time round uses the cached outline
+                for (int i = 0; i < 2; ++i)
+                {
+                    const auto expected = render ([&] (Graphics& g) { g.strokePath (knob, strokeType, t); });
+                    const auto actual   = render ([&] (Graphics& g) { cached.stroke (g, strokeType, t); });
+
+                    expect (getMaxDifference (expected, actual) <= (t.isIdentity() ? 0 : 2));
+                }
+            }
+        }
+
+        beginTest ("Fills match Graphics::fillPath()");
+        {
+            CachedPath cached (knob);
+
+            for (auto& t : transforms)
+            {
+                for (int i = 0; i < 2; ++i)
+                {
+                    const auto expected = render ([&] (Graphics& g) { g.fillPath (knob, t); });
+                    const auto actual   = render ([&] (Graphics& g) { cached.fill (g, t); });
+
+                    expect (getMaxDifference (expected, actual) <= 2);
+                }
+            }
+        }
+
+        beginTest ("Changing the path discards the cached outlines");
+        {
+            CachedPath cached (knob);
+            render ([&] (Graphics& g) { cached.fill (g); cached.stroke (g, strokeType); });
+
+            Path other;
+            other.addEllipse (5.0f, 5.0f, 60.0f, 40.0f);
+            cached.setPath (other);
+
+            expectEquals (getMaxDifference (render ([&] (Graphics& g) { g.strokePath (other, strokeType); }),
+                                            render ([&] (Graphics& g) { cached.stroke (g, strokeType); })), 0);
+
+            expect (getMaxDifference (render ([&] (Graphics& g) { g.fillPath (other); }),
+                                      render ([&] (Graphics& g) { cached.fill (g); })) <= 2);
+        }
+
+        beginTest ("Nothing is drawn outside the clip region");
+        {
+            CachedPath cached (knob);
+
+            const auto image = render ([&] (Graphics& g)
+            {
+                g.reduceClipRegion (0, 0, 10, 10);
+                cached.stroke (g, strokeType, AffineTransform::translation (60.0f, 60.0f));
+                cached.fill (g, AffineTransform::translation (60.0f, 60.0f));
+            });
+
+            expectEquals (getMaxDifference (image, render ([] (Graphics&) {})), 0);
+        }
+    }
+
+private:
+    template <typename PaintFn>
+    static Image render (PaintFn&& paint)
+    {
+        Image image (Image::ARGB, 120, 120, true, SoftwareImageType());
+
+        {
+            Graphics g (image);
+            g.setColour (Colours::black);
+            paint (g);
+        }
+
+        return image;
+    }
+
+    static int getMaxDifference (const Image& a, const Image& b)
+    {
+        int maxDifference = 0;
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            for (int x = 0; x < a.getWidth(); ++x)
+                maxDifference = jmax (maxDifference, std::abs ((int) a.getPixelAt (x, y).getAlpha() - (int) b.getPixelAt (x, y).getAlpha()));
+
+        return maxDifference;
+    }
+};
+
+static CachedPathTests cachedPathTests;
+
+#endif
+
+} // namespace juce
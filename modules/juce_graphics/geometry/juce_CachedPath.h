@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a Path together with cached copies of its flattened and stroked outlines,
+    so that shapes which get drawn the same way on every paint don't need to be
+    re-flattened and re-stroked each time.
+
+    The outlines are created the first time the path is filled or stroked, and are
+    then re-used for as long as the path, the stroke type, and the scale of the
+    transform and graphics context stay the same. Moving or rotating the shape with
+    the transform doesn't invalidate them, so things like knob pointers, meter needles
+    and scrolling overlays only get stroked once.
+
+    Because the cached outlines know their bounds, drawing a CachedPath that lies
+    entirely outside the context's clip region (e.g. while repainting some other
+    dirty area of a component) is almost free.
+
+    Like Path, this class isn't thread-safe.
+
+    E.g. @code
+    void resized() override
+    {
+        Path p;
+        p.addCentredArc (0.0f, 0.0f, 40.0f, 40.0f, 0.0f, -2.5f, 2.5f, true);
+        arc.setPath (p);
+    }
+
+    void paint (Graphics& g) override
+    {
+        arc.stroke (g, PathStrokeType (3.0f), AffineTransform::translation (getLocalBounds().getCentre().toFloat()));
+    }
+
+    CachedPath arc;
+    @endcode
+
+    @see Path, PathStrokeType
+
+    @tags{Graphics}
+*/
+class JUCE_API  CachedPath
+{
+public:
+    //==============================================================================
+    /** Creates an empty CachedPath. */
+    CachedPath() = default;
+
+    /** Creates a CachedPath holding a copy of the given path. */
+    explicit CachedPath (const Path&);
+
+    /** Creates a CachedPath that takes over the given path. */
+    explicit CachedPath (Path&&);
+
+    //==============================================================================
+    /** Returns the path. */
+    const Path& getPath() const noexcept                { return path; }
+
+    /** Replaces the path, discarding any outlines that were cached for the old one. */
+    void setPath (const Path& newPath);
+
+    /** Replaces the path, discarding any outlines that were cached for the old one. */
+    void setPath (Path&& newPath);
+
+    /** Discards any cached outlines, so that they'll be re-created next time the
+        path is drawn.
+    */
+    void clearCache();
+
+    //==============================================================================
+    /** Fills the path, in the same way as Graphics::fillPath(). */
+    void fill (Graphics& g, const AffineTransform& transform = {}) const;
+
+    /** Strokes the path, in the same way as Graphics::strokePath(). */
+    void stroke (Graphics& g, const PathStrokeType& strokeType, const AffineTransform& transform = {}) const;
+
+private:
+    //==============================================================================
+    struct CachedOutline
+    {
+        AffineTransform transform;
+        float extraAccuracy;
+        Path outline;
+        Rectangle<float> bounds;
+    };
+
+    struct CachedStroke  : public CachedOutline
+    {
+        PathStrokeType strokeType;
+    };
+
+    Path path;
+    mutable std::optional<CachedOutline> flattened;
+    mutable std::vector<CachedStroke> strokes;
+
+    static constexpr size_t maxCachedStrokes = 4;
+
+    void draw (Graphics&, const CachedOutline&, const AffineTransform&) const;
+
+    JUCE_LEAK_DETECTOR (CachedPath)
+};
+
+} // namespace juce
@@ -93,7 +93,7 @@ EdgeTable::EdgeTable (Rectangle<int> area, const Path& path, const AffineTransfo
                 {
                     auto step = jmin (stepSize, y2 - y1, 256 - (y1 & 255));
                     auto x = static_cast<int64_t> (startX + multiplier * static_cast<double> ((y1 + (step >> 1)) - startY));
-                    auto clampedX = static_cast<int> (jlimit (leftLimit, rightLimit - 1, x));
+                    auto clampedX = static_cast<int> (jlimit (leftLimit, rightLimit, x));
 
                     addEdgePoint (clampedX, static_cast<int> (y1 / scale), static_cast<int> (direction * step));
                     y1 += step;
@@ -411,6 +411,11 @@ inline void EdgeTable::remapWithExtraSpace (int numPoints)
     jassert (numPoints < maxEdgesPerLine);
 }
 
+size_t EdgeTable::getAllocatedSize() const noexcept
+{
+    return getEdgeTableAllocationSize (lineStrideElements, bounds.getHeight()) * sizeof (int);
+}
+
 void EdgeTable::optimiseTable()
 {
     int maxLineElements = 0;
@@ -91,6 +91,9 @@ public:
     */
     void optimiseTable();
 
+    /** Returns the number of bytes that the table has allocated. */
+    size_t getAllocatedSize() const noexcept;
+
 
     //==============================================================================
     /** Iterates the lines in the table, for rendering.
@@ -122,7 +125,7 @@ public:
             if (--numPoints > 0)
             {
                 int x = *++line;
-                jassert ((x / scale) >= bounds.getX() && (x / scale) < bounds.getRight());
+                jassert ((x / scale) >= bounds.getX() && (x / scale) <= bounds.getRight());
                 int levelAccumulator = 0;
 
                 iterationCallback.setEdgeTableYPos (bounds.getY() + y);
@@ -131,7 +134,17 @@ public:
                 {
                     const int level = *++line;
                     jassert (isPositiveAndBelow (level, scale));
-                    const int endX = *++line;
+                    int endX = *++line;
+
+                    // merge any following segments that have the same level, so that the runs
+                    // don't depend on how the table happened to be split up when it was built
+                    while (numPoints > 0 && line[1] == level)
+                    {
+                        endX = line[2];
+                        line += 2;
+                        --numPoints;
+                    }
+
                     jassert (endX >= x);
                     const int endOfRun = (endX / scale);
 
@@ -127,6 +127,7 @@ namespace juce
 #include "geometry/juce_EdgeTable.h"
 #include "geometry/juce_PathIterator.h"
 #include "geometry/juce_PathStrokeType.h"
+#include "geometry/juce_CachedPath.h"
 #include "placement/juce_RectanglePlacement.h"
 #include "images/juce_ImageCache.h"
 #include "images/juce_ImageConvolutionKernel.h"
@@ -144,6 +145,7 @@ namespace juce
 #include "colour/juce_FillType.h"
 #include "native/juce_RenderingHelpers.h"
 #include "contexts/juce_LowLevelGraphicsSoftwareRenderer.h"
+#include "contexts/juce_LowLevelGraphicsTiledSoftwareRenderer.h"
 #include "contexts/juce_LowLevelGraphicsPostScriptRenderer.h"
 #include "effects/juce_ImageEffectFilter.h"
 #include "effects/juce_DropShadowEffect.h"
@@ -0,0 +1,596 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_USE_SSE_SPAN_BLENDING 1
+ #include <immintrin.h>
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON)
+ #define JUCE_USE_NEON_SPAN_BLENDING 1
+ #include <arm_neon.h>
+#endif
+
+namespace juce
+{
+namespace RenderingHelpers
+{
+namespace SpanBlending
+{
+
+struct Kernels
+{
+    void (JUCE_CALLTYPE* blendColour) (PixelARGB*, PixelARGB, int) noexcept;
+    void (JUCE_CALLTYPE* blendPixels) (PixelARGB*, const PixelARGB*, int) noexcept;
+    void (JUCE_CALLTYPE* blendPixelsWithAlpha) (PixelARGB*, const PixelARGB*, uint32, int) noexcept;
+};
+
+//==============================================================================
+namespace Scalar
+{
+    static void JUCE_CALLTYPE blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            dest[i].blend (colour);
+    }
+
+    static void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            dest[i].blend (src[i]);
+    }
+
+    static void JUCE_CALLTYPE blendPixelsWithAlpha (PixelARGB* dest, const PixelARGB* src, uint32 extraAlpha, int numPixels) noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+            dest[i].blend (src[i], extraAlpha);
+    }
+
+    static constexpr Kernels kernels { blendColour, blendPixels, blendPixelsWithAlpha };
+}
+
+#if JUCE_USE_SSE_SPAN_BLENDING
+//==============================================================================
+namespace SSE2
+{
+    struct Ops
+    {
+        using Packed = __m128i;
+        using Wide = __m128i;
+        enum { numPixels = 4 };
+
+        static forcedinline Packed load (const PixelARGB* p) noexcept       { return _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p)); }
+        static forcedinline void store (PixelARGB* p, Packed v) noexcept     { _mm_storeu_si128 (reinterpret_cast<__m128i*> (p), v); }
+        static forcedinline Packed broadcast (PixelARGB p) noexcept         { return _mm_set1_epi32 ((int) p.getNativeARGB()); }
+
+        static forcedinline Wide lo (Packed v) noexcept                     { return _mm_unpacklo_epi8 (v, _mm_setzero_si128()); }
+        static forcedinline Wide hi (Packed v) noexcept                     { return _mm_unpackhi_epi8 (v, _mm_setzero_si128()); }
+        static forcedinline Packed pack (Wide a, Wide b) noexcept           { return _mm_packus_epi16 (a, b); }
+
+        static forcedinline Wide set16 (int v) noexcept                     { return _mm_set1_epi16 ((short) v); }
+        static forcedinline Wide add (Wide a, Wide b) noexcept              { return _mm_add_epi16 (a, b); }
+        static forcedinline Wide sub (Wide a, Wide b) noexcept              { return _mm_sub_epi16 (a, b); }
+        static forcedinline Wide scale (Wide a, Wide b) noexcept            { return _mm_srli_epi16 (_mm_mullo_epi16 (a, b), 8); }
+
+        static forcedinline Wide alphas (Wide v) noexcept
+        {
+            return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, PixelARGB::indexA * 0x55), PixelARGB::indexA * 0x55);
+        }
+    };
+
+    #include "juce_RenderingHelpers_simd.h"
+}
+
+//==============================================================================
+// The AVX2 kernels are compiled with the relevant target options enabled, so they
+// can be used without the whole module needing to be built for those CPUs.
+#if JUCE_CLANG
+ #pragma clang attribute push (__attribute__ ((target ("avx2"))), apply_to = function)
+#elif JUCE_GCC
+ #pragma GCC push_options
+ #pragma GCC target ("avx2")
+#endif
+
+namespace AVX2
+{
+    // The unpacking and packing instructions work within each 128-bit lane, so the
+    // pixels get shuffled around while they're widened, and put back by pack()
+    struct Ops
+    {
+        using Packed = __m256i;
+        using Wide = __m256i;
+        enum { numPixels = 8 };
+
+        static forcedinline Packed load (const PixelARGB* p) noexcept       { return _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (p)); }
+        static forcedinline void store (PixelARGB* p, Packed v) noexcept     { _mm256_storeu_si256 (reinterpret_cast<__m256i*> (p), v); }
+        static forcedinline Packed broadcast (PixelARGB p) noexcept         { return _mm256_set1_epi32 ((int) p.getNativeARGB()); }
+
+        static forcedinline Wide lo (Packed v) noexcept                     { return _mm256_unpacklo_epi8 (v, _mm256_setzero_si256()); }
+        static forcedinline Wide hi (Packed v) noexcept                     { return _mm256_unpackhi_epi8 (v, _mm256_setzero_si256()); }
+        static forcedinline Packed pack (Wide a, Wide b) noexcept           { return _mm256_packus_epi16 (a, b); }
+
+        static forcedinline Wide set16 (int v) noexcept                     { return _mm256_set1_epi16 ((short) v); }
+        static forcedinline Wide add (Wide a, Wide b) noexcept              { return _mm256_add_epi16 (a, b); }
+        static forcedinline Wide sub (Wide a, Wide b) noexcept              { return _mm256_sub_epi16 (a, b); }
+        static forcedinline Wide scale (Wide a, Wide b) noexcept            { return _mm256_srli_epi16 (_mm256_mullo_epi16 (a, b), 8); }
+
+        static forcedinline Wide alphas (Wide v) noexcept
+        {
+            return _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (v, PixelARGB::indexA * 0x55), PixelARGB::indexA * 0x55);
+        }
+    };
+
+    #include "juce_RenderingHelpers_simd.h"
+}
+
+#if JUCE_CLANG
+ #pragma clang attribute pop
+#elif JUCE_GCC
+ #pragma GCC pop_options
+#endif
+
+#elif JUCE_USE_NEON_SPAN_BLENDING
+//==============================================================================
+namespace NEON
+{
+    struct Ops
+    {
+        using Packed = uint8x16_t;
+        using Wide = uint16x8_t;
+        enum { numPixels = 4 };
+
+        static forcedinline Packed load (const PixelARGB* p) noexcept       { return vld1q_u8 (reinterpret_cast<const uint8_t*> (p)); }
+        static forcedinline void store (PixelARGB* p, Packed v) noexcept     { vst1q_u8 (reinterpret_cast<uint8_t*> (p), v); }
+        static forcedinline Packed broadcast (PixelARGB p) noexcept         { return vreinterpretq_u8_u32 (vdupq_n_u32 (p.getNativeARGB())); }
+
+        static forcedinline Wide lo (Packed v) noexcept                     { return vmovl_u8 (vget_low_u8 (v)); }
+        static forcedinline Wide hi (Packed v) noexcept                     { return vmovl_u8 (vget_high_u8 (v)); }
+        static forcedinline Packed pack (Wide a, Wide b) noexcept           { return vcombine_u8 (vqmovn_u16 (a), vqmovn_u16 (b)); }
+
+        static forcedinline Wide set16 (int v) noexcept                     { return vdupq_n_u16 ((uint16_t) v); }
+        static forcedinline Wide add (Wide a, Wide b) noexcept              { return vaddq_u16 (a, b); }
+        static forcedinline Wide sub (Wide a, Wide b) noexcept              { return vsubq_u16 (a, b); }
+        static forcedinline Wide scale (Wide a, Wide b) noexcept            { return vshrq_n_u16 (vmulq_u16 (a, b), 8); }
+
+        // Each 64-bit lane holds one pixel, so its alpha can be isolated and copied into
+        // the other components with shifts
+        static forcedinline Wide alphas (Wide v) noexcept
+        {
+            auto a = vshrq_n_u64 (vshlq_n_u64 (vreinterpretq_u64_u16 (v), 48 - 16 * PixelARGB::indexA), 48);
+            a = vorrq_u64 (a, vshlq_n_u64 (a, 16));
+            a = vorrq_u64 (a, vshlq_n_u64 (a, 32));
+            return vreinterpretq_u16_u64 (a);
+        }
+    };
+
+    #include "juce_RenderingHelpers_simd.h"
+}
+#endif
+
+//==============================================================================
+static const Kernels& getKernels() noexcept
+{
+    static const Kernels& kernels = []() -> const Kernels&
+    {
+       #if JUCE_USE_SSE_SPAN_BLENDING
+        if (SystemStats::hasAVX2())
+            return AVX2::kernels;
+
+        return SSE2::kernels;
+       #elif JUCE_USE_NEON_SPAN_BLENDING
+        return NEON::kernels;
+       #else
+        return Scalar::kernels;
+       #endif
+    }();
+
+    return kernels;
+}
+
+void JUCE_CALLTYPE blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept
+{
+    getKernels().blendColour (dest, colour, numPixels);
+}
+
+void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept
+{
+    getKernels().blendPixels (dest, src, numPixels);
+}
+
+void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, uint32 extraAlpha, int numPixels) noexcept
+{
+    getKernels().blendPixelsWithAlpha (dest, src, extraAlpha, numPixels);
+}
+
+static std::atomic<bool> spanBlendingEnabled { true };
+
+void JUCE_CALLTYPE setEnabled (bool shouldBeEnabled) noexcept
+{
+    spanBlendingEnabled.store (shouldBeEnabled, std::memory_order_relaxed);
+}
+
+bool JUCE_CALLTYPE isEnabled() noexcept
+{
+    return spanBlendingEnabled.load (std::memory_order_relaxed);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SpanBlendingTests  : public UnitTest
+{
+public:
+    SpanBlendingTests()
+        : UnitTest ("SpanBlending", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        for (auto& kernelSet : getAvailableKernels())
+        {
+            beginTest (kernelSet.first + " kernels match PixelARGB::blend()");
+
+            auto& kernels = *kernelSet.second;
+
+            for (int numPixels = 0; numPixels <= 40; ++numPixels)
+            {
+                auto src = createRandomPixels (r, numPixels);
+                auto dest = createRandomPixels (r, numPixels);
+
+                auto colour = createRandomPixels (r, 1).front();
+                auto expected = dest;
+                auto result = dest;
+                Scalar::blendColour (expected.data(), colour, numPixels);
+                kernels.blendColour (result.data(), colour, numPixels);
+                expect (pixelsMatch (expected, result));
+
+                expected = dest;
+                result = dest;
+                Scalar::blendPixels (expected.data(), src.data(), numPixels);
+                kernels.blendPixels (result.data(), src.data(), numPixels);
+                expect (pixelsMatch (expected, result));
+
+                for (auto extraAlpha : { 0u, 1u, 127u, 255u, 256u, (uint32) r.nextInt (257) })
+                {
+                    expected = dest;
+                    result = dest;
+                    Scalar::blendPixelsWithAlpha (expected.data(), src.data(), extraAlpha, numPixels);
+                    kernels.blendPixelsWithAlpha (result.data(), src.data(), extraAlpha, numPixels);
+                    expect (pixelsMatch (expected, result));
+                }
+            }
+        }
+
+        beginTest ("Fills are the same with span blending enabled and disabled");
+        {
+            auto background = createRandomImage (r, 240, 160);
+            auto tile = createRandomImage (r, 37, 23);
+
+            // The image fillers treat an alpha level of 0xfe or more as opaque, so these
+            // include opacities that land either side of that cut-off
+            for (auto opacity : { 1.0f, 253.0f / 255.0f, 252.0f / 255.0f, 0.5f, 0.1f })
+            {
+                expectRenderingsMatch (background, [&] (Graphics& g)
+                {
+                    g.setTiledImageFill (tile, -13, 7, opacity);
+                    g.fillRect (3, 2, 230, 150);
+                    g.fillRect (Rectangle<float> (10.3f, 4.6f, 200.0f, 100.5f));
+                    g.fillEllipse (20.0f, 10.0f, 190.0f, 130.0f);
+                });
+
+                expectRenderingsMatch (background, [&] (Graphics& g)
+                {
+                    g.setOpacity (opacity);
+                    g.drawImageAt (tile, 5, 6);
+                    g.drawImageAt (tile, 50, 30, true);
+                });
+
+                expectRenderingsMatch (background, [&] (Graphics& g)
+                {
+                    ColourGradient gradient (Colours::red.withAlpha (0.8f), 0.0f, 0.0f,
+                                             Colours::blue, 180.0f, 0.0f, false);
+                    gradient.addColour (0.3, Colours::transparentBlack);
+                    gradient.addColour (0.6, Colours::yellow.withAlpha (0.5f));
+
+                    g.setOpacity (opacity);
+                    g.setFillType (FillType (gradient).transformed (AffineTransform::rotation (0.3f).translated (20.0f, -10.0f)));
+                    g.fillRect (0, 0, 240, 160);
+                    g.fillRect (Rectangle<float> (7.5f, 9.25f, 220.0f, 120.5f));
+                    g.fillEllipse (15.0f, 15.0f, 200.0f, 120.0f);
+
+                    ColourGradient radial (Colours::green, 120.0f, 80.0f,
+                                           Colours::white.withAlpha (0.2f), 10.0f, 80.0f, true);
+                    g.setFillType (FillType (radial).transformed (AffineTransform::scale (1.5f, 0.7f, 120.0f, 80.0f)));
+                    g.fillRoundedRectangle (4.5f, 3.5f, 225.0f, 150.0f, 20.0f);
+                });
+            }
+        }
+    }
+
+private:
+    static std::vector<std::pair<String, const Kernels*>> getAvailableKernels()
+    {
+        std::vector<std::pair<String, const Kernels*>> result { { "Scalar", &Scalar::kernels } };
+
+       #if JUCE_USE_SSE_SPAN_BLENDING
+        result.push_back ({ "SSE2", &SSE2::kernels });
+
+        if (SystemStats::hasAVX2())
+            result.push_back ({ "AVX2", &AVX2::kernels });
+       #elif JUCE_USE_NEON_SPAN_BLENDING
+        result.push_back ({ "NEON", &NEON::kernels });
+       #endif
+
+        return result;
+    }
+
+    // Fully transparent and opaque pixels take the extreme paths through the arithmetic,
+    // so plenty of those are mixed in with the random ones
+    static std::vector<PixelARGB> createRandomPixels (Random& r, int numPixels)
+    {
+        std::vector<PixelARGB> pixels;
+
+        for (int i = 0; i < numPixels; ++i)
+        {
+            auto alpha = (uint8) (r.nextInt (3) == 0 ? (r.nextBool() ? 0 : 255) : r.nextInt (256));
+            PixelARGB p (alpha, (uint8) r.nextInt (256), (uint8) r.nextInt (256), (uint8) r.nextInt (256));
+            p.premultiply();
+            pixels.push_back (p);
+        }
+
+        return pixels;
+    }
+
+    static Image createRandomImage (Random& r, int width, int height)
+    {
+        Image image (Image::ARGB, width, height, false, SoftwareImageType());
+        Image::BitmapData data (image, Image::BitmapData::writeOnly);
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto pixels = createRandomPixels (r, width);
+
+            for (int x = 0; x < width; ++x)
+                *reinterpret_cast<PixelARGB*> (data.getPixelPointer (x, y)) = pixels[(size_t) x];
+        }
+
+        return image;
+    }
+
+    template <typename DrawFn>
+    void expectRenderingsMatch (const Image& background, DrawFn&& draw)
+    {
+        auto render = [&] (bool useSpans)
+        {
+            auto image = background.createCopy();
+
+            setEnabled (useSpans);
+            const ScopeGuard restore { [] { setEnabled (true); } };
+
+            Graphics g (image);
+            draw (g);
+            return image;
+        };
+
+        auto withSpans = render (true);
+        auto withoutSpans = render (false);
+
+        Image::BitmapData a (withSpans, Image::BitmapData::readOnly);
+        Image::BitmapData b (withoutSpans, Image::BitmapData::readOnly);
+        int numDifferentPixels = 0;
+
+        for (int y = 0; y < a.height; ++y)
+            for (int x = 0; x < a.width; ++x)
+                if (reinterpret_cast<const PixelARGB*> (a.getPixelPointer (x, y))->getNativeARGB()
+                     != reinterpret_cast<const PixelARGB*> (b.getPixelPointer (x, y))->getNativeARGB())
+                    ++numDifferentPixels;
+
+        expectEquals (numDifferentPixels, 0);
+    }
+
+    static bool pixelsMatch (const std::vector<PixelARGB>& a, const std::vector<PixelARGB>& b)
+    {
+        return std::equal (a.begin(), a.end(), b.begin(), b.end(),
+                           [] (PixelARGB x, PixelARGB y) { return x.getNativeARGB() == y.getNativeARGB(); });
+    }
+};
+
+static SpanBlendingTests spanBlendingTests;
+
+#endif
+
+} // namespace SpanBlending
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class GlyphCacheTests  : public UnitTest
+{
+public:
+    GlyphCacheTests()
+        : UnitTest ("GlyphCache", UnitTestCategories::graphics)
+    {}
+
+    void runTest() override
+    {
+        const Font font (16.0f);
+        const auto glyphs = getGlyphs (font, "The quick brown fox jumps over the lazy dog");
+
+        beginTest ("Glyphs are re-used");
+        {
+            CacheType cache;
+
+            for (auto glyph : glyphs)
+                cache.findOrCreateGlyph (font, glyph);
+
+            auto stats = cache.getStatistics();
+            expectEquals (stats.misses, (int64) glyphs.size());
+            expectEquals (stats.hits, (int64) 0);
+            expectEquals (stats.numGlyphs, glyphs.size());
+            expect (stats.memoryUsed > 0);
+
+            for (auto glyph : glyphs)
+                expectEquals (cache.findOrCreateGlyph (font, glyph)->glyph, glyph);
+
+            stats = cache.getStatistics();
+            expectEquals (stats.misses, (int64) glyphs.size());
+            expectEquals (stats.hits, (int64) glyphs.size());
+
+            cache.reset();
+            stats = cache.getStatistics();
+            expectEquals (stats.numGlyphs, 0);
+            expectEquals (stats.hits + stats.misses, (int64) 0);
+            expectEquals (stats.memoryUsed, (size_t) 0);
+        }
+
+        beginTest ("Fonts, transforms and sub-pixel positions are cached separately");
+        {
+            CacheType cache;
+            const auto glyph = glyphs.getFirst();
+
+            auto plain   = cache.findOrCreateGlyph (font, glyph);
+            auto bigger  = cache.findOrCreateGlyph (font.withHeight (20.0f), glyph);
+            auto rotated = cache.findOrCreateGlyph (font, glyph, AffineTransform::rotation (0.5f));
+            auto shifted = cache.findOrCreateGlyph (font, glyph, AffineTransform::translation (0.0f, 0.25f));
+
+            expect (plain != bigger && plain != rotated && plain != shifted && rotated != shifted);
+            expect (rotated == cache.findOrCreateGlyph (font, glyph, AffineTransform::rotation (0.5f)));
+            expect (plain == cache.findOrCreateGlyph (Font (16.0f), glyph));
+            expectEquals (cache.getStatistics().numGlyphs, 4);
+        }
+
+        beginTest ("The least recently used glyphs are removed when over budget");
+        {
+            CacheType cache;
+
+            for (auto glyph : glyphs)
+                cache.findOrCreateGlyph (font, glyph);
+
+            const auto fullSize = cache.getStatistics().memoryUsed;
+            cache.setMemoryBudget (fullSize / 2);
+
+            auto stats = cache.getStatistics();
+            expect (stats.memoryUsed <= fullSize / 2);
+            expect (stats.evictions > 0);
+            expectEquals (stats.numGlyphs + (int) stats.evictions, glyphs.size());
+
+            cache.findOrCreateGlyph (font, glyphs.getLast());
+            expectEquals (cache.getStatistics().hits, stats.hits + 1);
+
+            cache.findOrCreateGlyph (font, glyphs.getFirst());
+            expectEquals (cache.getStatistics().misses, stats.misses + 1);
+        }
+
+        beginTest ("Glyphs that are in use survive being removed");
+        {
+            CacheType cache;
+            auto glyph = cache.findOrCreateGlyph (font, glyphs.getFirst());
+            cache.findOrCreateGlyph (font, glyphs.getLast());
+            cache.setMemoryBudget (0);
+
+            expectEquals (cache.getStatistics().numGlyphs, 1);
+            expectEquals (glyph->getReferenceCount(), 1);
+            expect (glyph->edgeTable != nullptr);
+        }
+
+        beginTest ("Transformed glyphs are drawn from the cache");
+        {
+            Image image (Image::ARGB, 200, 200, true);
+            Graphics g (image);
+            g.addTransform (AffineTransform::rotation (0.7f, 100.0f, 100.0f));
+            g.setFont (font);
+
+            auto& cache = SoftwareRendererSavedState::GlyphCacheType::getInstance();
+
+            g.drawSingleLineText ("Rotated text", 20, 100);
+            const auto before = cache.getStatistics();
+            g.drawSingleLineText ("Rotated text", 20, 100);
+            const auto after = cache.getStatistics();
+
+            expectEquals (after.misses, before.misses);
+            expect (after.hits > before.hits);
+        }
+
+        beginTest ("The cache can be used from several threads at once");
+        {
+            CacheType cache;
+            cache.setMemoryBudget (cache.getStatistics().memoryBudget / 256);
+
+            constexpr int numThreads = 4, numLookups = 2000;
+            std::atomic<int> numMismatches { 0 };
+            std::vector<std::thread> threads;
+
+            for (int t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back ([&, seed = getRandom().nextInt()]
+                {
+                    Random r (seed);
+
+                    for (int i = 0; i < numLookups; ++i)
+                    {
+                        auto glyph = glyphs[r.nextInt (glyphs.size())];
+                        auto transform = AffineTransform::rotation ((float) r.nextInt (4) * 0.1f);
+
+                        if (cache.findOrCreateGlyph (font, glyph, transform)->glyph != glyph)
+                            ++numMismatches;
+                    }
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            const auto stats = cache.getStatistics();
+            expectEquals (numMismatches.load(), 0);
+            expectEquals (stats.hits + stats.misses, (int64) (numThreads * numLookups));
+            expect (stats.memoryUsed <= stats.memoryBudget || stats.numGlyphs == 1);
+        }
+    }
+
+private:
+    using CacheType = GlyphCache<CachedGlyphEdgeTable<SoftwareRendererSavedState>, SoftwareRendererSavedState>;
+
+    static Array<int> getGlyphs (const Font& font, const String& text)
+    {
+        Array<int> glyphs, uniqueGlyphs;
+        Array<float> offsets;
+        font.getGlyphPositions (text, glyphs, offsets);
+
+        for (auto glyph : glyphs)
+            uniqueGlyphs.addIfNotAlreadyThere (glyph);
+
+        return uniqueGlyphs;
+    }
+};
+
+static GlyphCacheTests glyphCacheTests;
+
+#endif
+
+} // namespace RenderingHelpers
+} // namespace juce
@@ -139,130 +139,252 @@ public:
 //==============================================================================
 /** Holds a cache of recently-used glyph objects of some type.
 
+    Each glyph is rendered for a particular font, and for the scale, rotation and
+    vertical sub-pixel position at which it's drawn, so glyphs drawn with any transform
+    can be re-used. The cache is shared between all the renderers that use the same
+    type of glyph, and can be used from any number of threads at once: looking up a
+    glyph only needs a shared lock, and new glyphs are rasterised without holding it.
+
+    When the glyphs take up more memory than the cache's budget, the ones that were
+    used least recently are thrown away.
+
     @tags{Graphics}
 */
 template <class CachedGlyphType, class RenderTargetType>
 class GlyphCache  : private DeletedAtShutdown
 {
 public:
-    GlyphCache()
-    {
-        reset();
-    }
+    GlyphCache() = default;
 
     ~GlyphCache() override
     {
-        getSingletonPointer() = nullptr;
+        getSingletonHolder().clear (this);
     }
 
     static GlyphCache& getInstance()
     {
-        auto& g = getSingletonPointer();
-
-        if (g == nullptr)
-            g = new GlyphCache();
-
-        return *g;
+        return *getSingletonHolder().get();
     }
 
     //==============================================================================
+    /** Some statistics about how the cache is being used. */
+    struct Statistics
+    {
+        int64 hits = 0, misses = 0, evictions = 0;
+        size_t memoryUsed = 0, memoryBudget = 0;
+        int numGlyphs = 0;
+    };
+
+    /** Removes all the glyphs, and resets the statistics. */
     void reset()
     {
-        const ScopedLock sl (lock);
+        const ScopedWriteLock swl (lock);
         glyphs.clear();
-        addNewGlyphSlots (120);
+        memoryUsed = 0;
         hits = 0;
         misses = 0;
+        evictions = 0;
     }
 
-    void drawGlyph (RenderTargetType& target, const Font& font, const int glyphNumber, Point<float> pos)
+    /** Sets the number of bytes that the cached glyphs can use, removing any that don't fit.
+        The most recently-used glyph is always kept, even if it's bigger than this.
+    */
+    void setMemoryBudget (size_t newBudgetInBytes)
+    {
+        const ScopedWriteLock swl (lock);
+        memoryBudget = newBudgetInBytes;
+        removeExcessGlyphs();
+    }
+
+    /** Returns the current statistics. */
+    Statistics getStatistics() const
+    {
+        const ScopedReadLock srl (lock);
+        return { hits.load(), misses.load(), evictions, memoryUsed, memoryBudget, (int) glyphs.size() };
+    }
+
+    //==============================================================================
+    /** Draws an untransformed glyph at the given position. */
+    void drawGlyph (RenderTargetType& target, const Font& font, int glyphNumber, Point<float> pos)
     {
         if (auto glyph = findOrCreateGlyph (font, glyphNumber))
-        {
-            glyph->lastAccessCount = ++accessCounter;
             glyph->draw (target, pos);
-        }
     }
 
-    ReferenceCountedObjectPtr<CachedGlyphType> findOrCreateGlyph (const Font& font, int glyphNumber)
+    /** Draws a glyph with a transform, which may include scaling, shearing or rotation.
+
+        To let the glyph be re-used at other positions, its vertical position is rounded
+        to the nearest 1/numVerticalSubPixelPositions of a pixel, so it may be up to 1/8 of a
+        pixel away from where an uncached glyph would be drawn.
+    */
+    void drawGlyph (RenderTargetType& target, const Font& font, int glyphNumber, const AffineTransform& transform)
     {
-        const ScopedLock sl (lock);
+        // The glyphs are drawn at whole-pixel vertical positions, so any fractional part
+        // of the position is rounded to a fraction of a pixel and built into the glyph
+        auto y = std::floor (transform.getTranslationY());
+        auto subPixelY = roundToInt ((transform.getTranslationY() - y) * (float) numVerticalSubPixelPositions);
 
-        if (auto g = findExistingGlyph (font, glyphNumber))
+        if (subPixelY == numVerticalSubPixelPositions)
         {
-            ++hits;
-            return g;
+            y += 1.0f;
+            subPixelY = 0;
         }
 
-        ++misses;
-        auto g = getGlyphForReuse();
-        jassert (g != nullptr);
-        g->generate (font, glyphNumber);
-        return g;
-    }
+        const auto glyphTransform = transform.withAbsoluteTranslation (0.0f, (float) subPixelY / (float) numVerticalSubPixelPositions);
 
-private:
-    ReferenceCountedArray<CachedGlyphType> glyphs;
-    Atomic<int> accessCounter, hits, misses;
-    CriticalSection lock;
+        if (auto glyph = findOrCreateGlyph (font, glyphNumber, glyphTransform))
+            glyph->draw (target, { transform.getTranslationX(), y });
+    }
 
-    ReferenceCountedObjectPtr<CachedGlyphType> findExistingGlyph (const Font& font, int glyphNumber) const noexcept
+    ReferenceCountedObjectPtr<CachedGlyphType> findOrCreateGlyph (const Font& font, int glyphNumber,
+                                                                  const AffineTransform& transform = {})
     {
-        for (auto g : glyphs)
-            if (g->glyph == glyphNumber && g->font == font)
-                return *g;
+        GlyphKey key { font, glyphNumber, transform };
+
+        if (auto glyph = findGlyph (key))
+            return glyph;
+
+        ReferenceCountedObjectPtr<CachedGlyphType> glyph;
+
+        {
+            // Typefaces load their glyphs on demand and can't do that on several threads at once,
+            // so new glyphs are created one at a time, but without stopping other threads from
+            // finding the glyphs that are already in the cache
+            const ScopedLock sl (generationLock);
+
+            if (auto existing = findGlyph (key))
+                return existing;
+
+            ++misses;
+            glyph = new CachedGlyphType();
+            glyph->generate (font, glyphNumber, transform);
+        }
 
-        return {};
+        const ScopedWriteLock swl (lock);
+        auto size = glyph->getMemoryUsage();
+        auto result = glyphs.emplace (std::piecewise_construct,
+                                      std::forward_as_tuple (std::move (key)),
+                                      std::forward_as_tuple (glyph, size, ++useCount));
+
+        // If another thread added the same glyph in the meantime, that one is used instead
+        if (! result.second)
+            return result.first->second.glyph;
+
+        memoryUsed += size;
+        removeExcessGlyphs();
+        return glyph;
     }
 
-    ReferenceCountedObjectPtr<CachedGlyphType> getGlyphForReuse()
+    /** The number of bytes that the cache will use unless told otherwise. */
+    static constexpr size_t defaultMemoryBudget = 4 * 1024 * 1024;
+
+    /** The number of different vertical positions within a pixel that a transformed glyph can be drawn at. */
+    static constexpr int numVerticalSubPixelPositions = 4;
+
+private:
+    struct GlyphKey
     {
-        if (hits.get() + misses.get() > glyphs.size() * 16)
+        Font font;
+        int glyph;
+        AffineTransform transform;
+
+        bool operator< (const GlyphKey& other) const noexcept
         {
-            if (misses.get() * 2 > hits.get())
-                addNewGlyphSlots (32);
+            const auto transformTie = [] (const AffineTransform& t)
+            {
+                return std::make_tuple (t.mat00, t.mat01, t.mat02, t.mat10, t.mat11, t.mat12);
+            };
+
+            const auto fontTie = [] (const Font& f)
+            {
+                return std::make_tuple (f.getHeight(), f.isUnderlined(), f.getHorizontalScale(),
+                                        f.getExtraKerningFactor(), f.getTypefaceName(), f.getTypefaceStyle());
+            };
+
+            if (glyph != other.glyph)
+                return glyph < other.glyph;
 
-            hits = 0;
-            misses = 0;
+            if (transform != other.transform)
+                return transformTie (transform) < transformTie (other.transform);
+
+            // Fonts that were copied from one another can be compared very quickly
+            if (font == other.font)
+                return false;
+
+            return fontTie (font) < fontTie (other.font);
         }
+    };
+
+    struct CachedGlyph
+    {
+        CachedGlyph (ReferenceCountedObjectPtr<CachedGlyphType> g, size_t s, uint64 used) noexcept
+            : glyph (std::move (g)), size (s), lastUsed (used)
+        {}
 
-        if (auto g = findLeastRecentlyUsedGlyph())
-            return *g;
+        ReferenceCountedObjectPtr<CachedGlyphType> glyph;
+        size_t size;
 
-        addNewGlyphSlots (32);
-        return glyphs.getLast();
-    }
+        // This is updated while only holding the read lock
+        std::atomic<uint64> lastUsed;
+    };
+
+    using GlyphIterator = typename std::map<GlyphKey, CachedGlyph>::iterator;
 
-    void addNewGlyphSlots (int num)
+    std::map<GlyphKey, CachedGlyph> glyphs;
+    size_t memoryUsed = 0, memoryBudget = defaultMemoryBudget;
+    std::atomic<int64> hits { 0 }, misses { 0 };
+    int64 evictions = 0;
+    std::atomic<uint64> useCount { 0 };
+    ReadWriteLock lock;
+    CriticalSection generationLock;
+
+    ReferenceCountedObjectPtr<CachedGlyphType> findGlyph (const GlyphKey& key)
     {
-        glyphs.ensureStorageAllocated (glyphs.size() + num);
+        const ScopedReadLock srl (lock);
+        auto iter = glyphs.find (key);
+
+        if (iter == glyphs.end())
+            return {};
 
-        while (--num >= 0)
-            glyphs.add (new CachedGlyphType());
+        ++hits;
+        iter->second.lastUsed.store (++useCount, std::memory_order_relaxed);
+        return iter->second.glyph;
     }
 
-    CachedGlyphType* findLeastRecentlyUsedGlyph() const noexcept
+    // Finding the oldest glyphs means sorting them, so when the cache is full this
+    // goes a bit further than it needs to, rather than having to do it for every new
+    // glyph. Any glyphs that are being drawn when they're removed will stay alive
+    // until the renderers have finished with them.
+    void removeExcessGlyphs()
     {
-        CachedGlyphType* oldest = nullptr;
-        auto oldestCounter = std::numeric_limits<int>::max();
+        if (memoryUsed <= memoryBudget || glyphs.size() <= 1)
+            return;
+
+        std::vector<GlyphIterator> order;
+        order.reserve (glyphs.size());
+
+        for (auto iter = glyphs.begin(); iter != glyphs.end(); ++iter)
+            order.push_back (iter);
 
-        for (auto* g : glyphs)
+        std::sort (order.begin(), order.end(), [] (GlyphIterator a, GlyphIterator b)
         {
-            if (g->lastAccessCount <= oldestCounter
-                 && g->getReferenceCount() == 1)
-            {
-                oldestCounter = g->lastAccessCount;
-                oldest = g;
-            }
-        }
+            return a->second.lastUsed.load (std::memory_order_relaxed) < b->second.lastUsed.load (std::memory_order_relaxed);
+        });
+
+        const auto target = memoryBudget - memoryBudget / 8;
 
-        return oldest;
+        for (auto oldest = order.begin(); memoryUsed > target && glyphs.size() > 1; ++oldest)
+        {
+            memoryUsed -= (*oldest)->second.size;
+            glyphs.erase (*oldest);
+            ++evictions;
+        }
     }
 
-    static GlyphCache*& getSingletonPointer() noexcept
+    static SingletonHolder<GlyphCache, CriticalSection, false>& getSingletonHolder() noexcept
     {
-        static GlyphCache* g = nullptr;
-        return g;
+        static SingletonHolder<GlyphCache, CriticalSection, false> holder;
+        return holder;
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GlyphCache)
@@ -285,27 +407,40 @@ public:
             pos.x = std::floor (pos.x + 0.5f);
 
         if (edgeTable != nullptr)
-            state.fillEdgeTable (*edgeTable, pos.x, roundToInt (pos.y));
+            state.fillEdgeTable (*edgeTable, pos.x, roundToInt (pos.y), ! isTransformed);
     }
 
-    void generate (const Font& newFont, int glyphNumber)
+    void generate (const Font& newFont, int glyphNumber, const AffineTransform& transform = {})
     {
         font = newFont;
         auto typeface = newFont.getTypefacePtr();
-        snapToIntegerCoordinate = typeface->isHinted();
+        snapToIntegerCoordinate = typeface->isHinted() && transform.isIdentity();
+        isTransformed = ! transform.isIdentity();
         glyph = glyphNumber;
 
         auto fontHeight = font.getHeight();
         edgeTable.reset (typeface->getEdgeTableForGlyph (glyphNumber,
                                                          AffineTransform::scale (fontHeight * font.getHorizontalScale(),
-                                                                                 fontHeight), fontHeight));
+                                                                                 fontHeight).followedBy (transform), fontHeight));
+
+        if (edgeTable != nullptr)
+            edgeTable->optimiseTable();
+    }
+
+    size_t getMemoryUsage() const noexcept
+    {
+        return sizeof (*this) + (edgeTable != nullptr ? edgeTable->getAllocatedSize() : 0);
     }
 
     Font font;
     std::unique_ptr<EdgeTable> edgeTable;
-    int glyph = 0, lastAccessCount = 0;
+    int glyph = 0;
     bool snapToIntegerCoordinate = false;
 
+    // Transformed glyphs have never had their levels boosted for light colours,
+    // so they're drawn without it to keep them looking the same
+    bool isTransformed = false;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachedGlyphEdgeTable)
 };
 
@@ -563,6 +698,49 @@ namespace GradientPixelIterators
     do { dest->op; dest = addBytesToPointer (dest, destStride); } while (--width > 0); \
 }
 
+//==============================================================================
+/** Blends runs of tightly-packed PixelARGB values, using the widest vector instructions
+    that the CPU supports.
+
+    The results are identical to calling PixelARGB::blend() on each pixel in turn.
+*/
+namespace SpanBlending
+{
+    /** Blends a colour onto each pixel in a run. */
+    JUCE_API void JUCE_CALLTYPE blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept;
+
+    /** Blends each of a run of source pixels onto the corresponding destination pixel. */
+    JUCE_API void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept;
+
+    /** Blends each of a run of source pixels onto the corresponding destination pixel,
+        scaling the source by an extra alpha level between 0 and 256.
+    */
+    JUCE_API void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, uint32 extraAlpha, int numPixels) noexcept;
+
+    /** Turns the span-blending paths in the edge-table fillers on or off.
+
+        When disabled, the fillers go back to blending one pixel at a time. They're
+        enabled by default - this is mainly useful for checking that both paths agree.
+    */
+    JUCE_API void JUCE_CALLTYPE setEnabled (bool shouldBeEnabled) noexcept;
+
+    /** Returns true if the edge-table fillers are allowed to use span blending. */
+    JUCE_API bool JUCE_CALLTYPE isEnabled() noexcept;
+
+    /** Returns true if a run of pixels in this image is worth handing to the functions above.
+        For very short runs, which are common when drawing text, the cost of calling the
+        vector kernels outweighs what they save.
+    */
+    template <class PixelType>
+    forcedinline bool canUseSpans (const Image::BitmapData& data, int numPixels) noexcept
+    {
+        return std::is_same_v<PixelType, PixelARGB>
+                && data.pixelStride == (int) sizeof (PixelARGB)
+                && numPixels >= 8
+                && isEnabled();
+    }
+}
+
 //==============================================================================
 /** Contains classes for filling edge tables with various fill types. */
 namespace EdgeTableFillers
@@ -669,6 +847,15 @@ namespace EdgeTableFillers
 
         inline void blendLine (PixelType* dest, PixelARGB colour, int width) const noexcept
         {
+            if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            {
+                if (SpanBlending::canUseSpans<PixelType> (destData, width))
+                {
+                    SpanBlending::blendColour (dest, colour, width);
+                    return;
+                }
+            }
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (colour))
         }
 
@@ -728,6 +915,15 @@ namespace EdgeTableFillers
         {
             auto* dest = getPixel (x);
 
+            if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            {
+                if (SpanBlending::canUseSpans<PixelType> (destData, width))
+                {
+                    blendSpan (dest, x, width, (uint32) alphaLevel);
+                    return;
+                }
+            }
+
             if (alphaLevel < 0xff)
                 JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++), (uint32) alphaLevel))
             else
@@ -737,6 +933,16 @@ namespace EdgeTableFillers
         void handleEdgeTableLineFull (int x, int width) const noexcept
         {
             auto* dest = getPixel (x);
+
+            if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            {
+                if (SpanBlending::canUseSpans<PixelType> (destData, width))
+                {
+                    blendSpan (dest, x, width, 0xff);
+                    return;
+                }
+            }
+
             JUCE_PERFORM_PIXEL_OP_LOOP (blend (GradientType::getPixel (x++)))
         }
 
@@ -767,6 +973,29 @@ namespace EdgeTableFillers
             return addBytesToPointer (linePixels, x * destData.pixelStride);
         }
 
+        // The gradient colours are looked up a chunk at a time, and then blended in one go
+        void blendSpan (PixelARGB* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            PixelARGB colours[64];
+
+            while (width > 0)
+            {
+                auto num = jmin (width, (int) numElementsInArray (colours));
+
+                for (int i = 0; i < num; ++i)
+                    colours[i] = GradientType::getPixel (x + i);
+
+                if (alphaLevel < 0xff)
+                    SpanBlending::blendPixels (dest, colours, alphaLevel, num);
+                else
+                    SpanBlending::blendPixels (dest, colours, num);
+
+                dest += num;
+                x += num;
+                width -= num;
+            }
+        }
+
         JUCE_DECLARE_NON_COPYABLE (Gradient)
     };
 
@@ -816,6 +1045,15 @@ namespace EdgeTableFillers
             alphaLevel = (alphaLevel * extraAlpha) >> 8;
             x -= xOffset;
 
+            if constexpr (bothAreARGB)
+            {
+                if (SpanBlending::canUseSpans<DestPixelType> (destData, width) && SpanBlending::canUseSpans<SrcPixelType> (srcData, width))
+                {
+                    blendSpan (dest, x, width, (uint32) alphaLevel);
+                    return;
+                }
+            }
+
             if (repeatPattern)
             {
                 if (alphaLevel < 0xfe)
@@ -839,6 +1077,15 @@ namespace EdgeTableFillers
             auto* dest = getDestPixel (x);
             x -= xOffset;
 
+            if constexpr (bothAreARGB)
+            {
+                if (SpanBlending::canUseSpans<DestPixelType> (destData, width) && SpanBlending::canUseSpans<SrcPixelType> (srcData, width))
+                {
+                    blendSpan (dest, x, width, (uint32) extraAlpha);
+                    return;
+                }
+            }
+
             if (repeatPattern)
             {
                 if (extraAlpha < 0xfe)
@@ -894,6 +1141,31 @@ namespace EdgeTableFillers
         DestPixelType* linePixels;
         SrcPixelType* sourceLineStart;
 
+        static constexpr bool bothAreARGB = std::is_same_v<DestPixelType, PixelARGB> && std::is_same_v<SrcPixelType, PixelARGB>;
+
+        // Blends the source row a contiguous section at a time, splitting it wherever a
+        // repeating pattern wraps around
+        void blendSpan (PixelARGB* dest, int x, int width, uint32 alphaLevel) const noexcept
+        {
+            jassert (repeatPattern || (x >= 0 && x + width <= srcData.width));
+
+            while (width > 0)
+            {
+                auto srcX = repeatPattern ? x % srcData.width : x;
+                auto num = repeatPattern ? jmin (width, srcData.width - srcX) : width;
+                auto* src = reinterpret_cast<const PixelARGB*> (getSrcPixel (srcX));
+
+                if (alphaLevel < 0xfe)
+                    SpanBlending::blendPixels (dest, src, alphaLevel, num);
+                else
+                    SpanBlending::blendPixels (dest, src, num);
+
+                dest += num;
+                x += num;
+                width -= num;
+            }
+        }
+
         forcedinline DestPixelType* getDestPixel (int x) const noexcept
         {
             return addBytesToPointer (linePixels, x * destData.pixelStride);
@@ -2334,14 +2606,14 @@ public:
         }
     }
 
-    void fillEdgeTable (const EdgeTable& edgeTable, float x, int y)
+    void fillEdgeTable (const EdgeTable& edgeTable, float x, int y, bool brightenLightColours = true)
     {
         if (clip != nullptr)
         {
             auto* edgeTableClip = new EdgeTableRegionType (edgeTable);
             edgeTableClip->edgeTable.translate (x, y);
 
-            if (fillType.isColour())
+            if (brightenLightColours && fillType.isColour())
             {
                 auto brightness = fillType.colour.getBrightness() - 0.5f;
 
@@ -2564,15 +2836,7 @@ public:
             }
             else
             {
-                auto fontHeight = font.getHeight();
-
-                auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
-                                                                     .followedBy (trans));
-
-                std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
-
-                if (et != nullptr)
-                    fillShape (*new EdgeTableRegionType (*et), false);
+                GlyphCacheType::getInstance().drawGlyph (*this, font, glyphNumber, transform.getTransformWith (trans));
             }
         }
     }
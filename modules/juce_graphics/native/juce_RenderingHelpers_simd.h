@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+/*  This file contains the vectorised span-blending kernels used by RenderingHelpers::SpanBlending.
+    It has no include guard, because juce_RenderingHelpers.cpp includes it once for each
+    instruction set, from inside a namespace that provides an Ops struct for that instruction
+    set, and with the matching compiler target options enabled.
+
+    Each Ops struct works on a Packed register holding numPixels pixels, and can widen half of
+    those pixels into a Wide register with 16 bits per component. All the arithmetic is done on
+    the wide components in exactly the same way as PixelARGB::blend(), so the results are
+    bit-identical to the scalar code.
+*/
+
+// Returns src + ((dest * (256 - srcAlpha)) >> 8), for each of the components
+static forcedinline Ops::Wide blendWide (Ops::Wide dest, Ops::Wide src) noexcept
+{
+    return Ops::add (src, Ops::scale (dest, Ops::sub (Ops::set16 (256), Ops::alphas (src))));
+}
+
+static void JUCE_CALLTYPE blendColour (PixelARGB* dest, PixelARGB colour, int numPixels) noexcept
+{
+    const auto src = Ops::lo (Ops::broadcast (colour));
+    const auto destScale = Ops::sub (Ops::set16 (256), Ops::alphas (src));
+    int i = 0;
+
+    for (; i + Ops::numPixels <= numPixels; i += Ops::numPixels)
+    {
+        const auto d = Ops::load (dest + i);
+        Ops::store (dest + i, Ops::pack (Ops::add (src, Ops::scale (Ops::lo (d), destScale)),
+                                         Ops::add (src, Ops::scale (Ops::hi (d), destScale))));
+    }
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (colour);
+}
+
+static void JUCE_CALLTYPE blendPixels (PixelARGB* dest, const PixelARGB* src, int numPixels) noexcept
+{
+    int i = 0;
+
+    for (; i + Ops::numPixels <= numPixels; i += Ops::numPixels)
+    {
+        const auto d = Ops::load (dest + i);
+        const auto s = Ops::load (src + i);
+        Ops::store (dest + i, Ops::pack (blendWide (Ops::lo (d), Ops::lo (s)),
+                                         blendWide (Ops::hi (d), Ops::hi (s))));
+    }
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i]);
+}
+
+static void JUCE_CALLTYPE blendPixelsWithAlpha (PixelARGB* dest, const PixelARGB* src, uint32 extraAlpha, int numPixels) noexcept
+{
+    jassert (extraAlpha <= 256);
+    const auto srcScale = Ops::set16 ((int) extraAlpha);
+    int i = 0;
+
+    for (; i + Ops::numPixels <= numPixels; i += Ops::numPixels)
+    {
+        const auto d = Ops::load (dest + i);
+        const auto s = Ops::load (src + i);
+        Ops::store (dest + i, Ops::pack (blendWide (Ops::lo (d), Ops::scale (Ops::lo (s), srcScale)),
+                                         blendWide (Ops::hi (d), Ops::scale (Ops::hi (s), srcScale))));
+    }
+
+    for (; i < numPixels; ++i)
+        dest[i].blend (src[i], extraAlpha);
+}
+
+static constexpr Kernels kernels { blendColour, blendPixels, blendPixelsWithAlpha };
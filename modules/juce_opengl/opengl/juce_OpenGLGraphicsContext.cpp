@@ -1774,15 +1774,7 @@ struct SavedState  : public RenderingHelpers::SavedStateBase<SavedState>
             }
             else
             {
-                auto fontHeight = font.getHeight();
-
-                auto t = transform.getTransformWith (AffineTransform::scale (fontHeight * font.getHorizontalScale(), fontHeight)
-                                                                     .followedBy (trans));
-
-                const std::unique_ptr<EdgeTable> et (font.getTypefacePtr()->getEdgeTableForGlyph (glyphNumber, t, fontHeight));
-
-                if (et != nullptr)
-                    fillShape (*new EdgeTableRegionType (*et), false);
+                GlyphCacheType::getInstance().drawGlyph (*this, font, glyphNumber, transform.getTransformWith (trans));
             }
         }
     }